@@ -69,6 +69,38 @@ int AshmemSetProt(int fd, int prot);
  */
 int AshmemGetSize(int fd);
 
+/**
+ * @brief View of a sub-range of a mapped <b>Ashmem</b> region, whose bounds
+ * and protection were checked when it was obtained.
+ *
+ * It is accessed in place, without copies nor further checks, and becomes
+ * invalid once the region is unmapped.
+ */
+template <typename T>
+struct AshmemSpan {
+    T *data = nullptr;
+    int32_t size = 0;
+    int32_t offset = 0; // offset of the view in the region
+
+    bool IsValid() const
+    {
+        return data != nullptr;
+    }
+
+    T *begin() const
+    {
+        return data;
+    }
+
+    T *end() const
+    {
+        return data + size;
+    }
+};
+
+using AshmemWriteView = AshmemSpan<char>;
+using AshmemReadView = AshmemSpan<const char>;
+
 /**
  * @brief Provides the <b>Ashmem</b> class implemented in c_utils to
  * operate the Anonymous Shared Memory (Ashmem).
@@ -81,6 +113,21 @@ int AshmemGetSize(int fd);
  */
 class Ashmem : public virtual RefBase {
 public:
+    /**
+     * @brief Options of `MapAshmem(int mapType, int options)`, which can be combined.
+     *
+     * They are granted as far as the system allows, the granted ones are
+     * obtained by `GetGrantedMapOptions()`.
+     */
+    enum MapOption : int {
+        MAP_OPTION_NONE = 0,
+        MAP_OPTION_POPULATE = 1,  // Fault in all pages when mapping.
+        // Ask for transparent huge pages, granted only if the pages faulted in
+        // when mapping (see MAP_OPTION_POPULATE) turn out to be huge ones.
+        MAP_OPTION_HUGE_PAGE = 2,
+        MAP_OPTION_LOCKED = 4,    // Lock the pages in memory, limited by RLIMIT_MEMLOCK.
+    };
+
     /**
      * @brief Creates an <b>Ashmem</b> region in the kernel.
      *
@@ -139,9 +186,52 @@ public:
      */
     int32_t GetAshmemSize() const;
 
+    /**
+     * @brief Get the options granted to the current mapping.
+     *
+     * @return Options in `MapOption` which were asked and granted, 0 if unmapped.
+     */
+    int GetGrantedMapOptions() const
+    {
+        return grantedOptions_;
+    }
+
+    /**
+     * @brief Obtains a writable view of `size` bytes at `offset`, so that
+     * data can be serialized in place rather than copied by `WriteToAshmem()`.
+     *
+     * Bounds and the protection flags are checked as by `WriteToAshmem()`,
+     * once for all the writes through the view.
+     *
+     * @return Returns the view, invalid if the checks fail.
+     */
+    AshmemWriteView GetWriteView(int32_t size, int32_t offset) const;
+
+    /**
+     * @brief Commits the data written through a view, before handing it to a
+     * reader, e.g. by a flag or a message.
+     *
+     * It orders the writes before those made afterwards, so that a reader
+     * acquiring what is handed sees the data.
+     *
+     * @param written Number of bytes written from the start of the view.
+     * @return Returns <b>false</b> if `written` exceeds the view, or the view
+     * is not one of the current mapping.
+     */
+    bool CommitWrite(const AshmemWriteView &view, int32_t written) const;
+
+    /**
+     * @brief Obtains a read-only view of `size` bytes at `offset`, checked
+     * as by `ReadFromAshmem()`.
+     *
+     * @return Returns the view, invalid if the checks fail.
+     */
+    AshmemReadView GetReadView(int32_t size, int32_t offset) const;
+
     #ifdef UTILS_CXX_RUST
     void CloseAshmem() const;
     bool MapAshmem(int mapType) const;
+    bool MapAshmem(int mapType, int options) const;
     bool MapReadAndWriteAshmem() const;
     bool MapReadOnlyAshmem() const;
     void UnmapAshmem() const;
@@ -167,6 +257,19 @@ public:
      */
     bool MapAshmem(int mapType);
 
+    /**
+     * @brief Maps this <b>Ashmem</b> region with options in `MapOption`.
+     *
+     * Options that can not be granted do not fail the mapping, check them
+     * with `GetGrantedMapOptions()`.
+     *
+     * @param mapType Indicates the protection flag of the mapped region in
+     * user space.
+     * @param options Indicates the options in `MapOption` to ask for.
+     * @return Returns <b>true</b> if mapping is successful.
+     */
+    bool MapAshmem(int mapType, int options);
+
     /**
      * @brief Maps this <b>Ashmem</b> region in read/write mode.
      *
@@ -230,11 +333,13 @@ private:
     mutable int32_t memorySize_; // Size of the Ashmem region.
     mutable int flag_; // Protection flag of the Ashmem region in user space.
     mutable void *startAddr_; // Start address of the Ashmem region.
+    mutable int grantedOptions_; // Options granted to the mapping.
     #else
     int memoryFd_; // File descriptor of the Ashmem region.
     int32_t memorySize_; // Size of the Ashmem region.
     int flag_; // Protection flag of the Ashmem region in user space.
     void *startAddr_; // Start address of the Ashmem region.
+    int grantedOptions_; // Options granted to the mapping.
     #endif
 
     bool CheckValid(int32_t size, int32_t offset, int cmd) const;
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ashmem_pool.h
+ *
+ * @brief Provides a pool allocating blocks out of a few large <b>Ashmem</b>
+ * regions.
+ */
+
+#ifndef UTILS_BASE_ASHMEM_POOL_H
+#define UTILS_BASE_ASHMEM_POOL_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ashmem.h"
+#include "lock_profiler.h"
+#include "parcel.h"
+
+namespace OHOS {
+
+/**
+ * @brief Block of a region of an `AshmemPool`, located by the id of the
+ * pool, the id of the region in the pool, its offset and its length.
+ *
+ * It is a plain value, which can be copied and marshalled through a
+ * `Parcel`. `data` is only meaningful in the process where it was set, by
+ * `AshmemPool::Allocate()` or `AshmemPool::Resolve()`.
+ */
+struct AshmemBlock {
+    uint64_t poolId = 0;
+    int32_t regionId = -1;
+    int32_t offset = 0;
+    int32_t length = 0;
+    void *data = nullptr;
+
+    bool IsValid() const
+    {
+        return poolId != 0 && regionId >= 0 && offset >= 0 && length > 0;
+    }
+
+    /**
+     * @brief Writes the pool id, region id, offset and length to a parcel.
+     *
+     * @note A process receiving blocks attaches each region once, with
+     * `AshmemPool::AttachRegion()`, after receiving it with the ids of its
+     * pool and of itself by a transport carrying file descriptors. It then
+     * resolves the blocks with `AshmemPool::Resolve()`.
+     */
+    bool Marshalling(Parcel &parcel) const;
+
+    /**
+     * @brief Reads a block written by `Marshalling()`. `data` is cleared.
+     */
+    static bool Unmarshalling(Parcel &parcel, AshmemBlock &block);
+};
+
+/**
+ * @brief Pool allocating blocks out of a few large <b>Ashmem</b> regions.
+ *
+ * Regions are created and mapped on demand, up to a maximum number, and kept
+ * once their blocks are freed, so that allocating a block only makes system
+ * calls when a region is added. With a block size, regions are split into
+ * blocks of that size, allocated from a free list in constant time. Otherwise
+ * blocks of any size are allocated first-fit, aligned to `BLOCK_ALIGN`, and
+ * merged with their free neighbours when freed.
+ *
+ * Each pool has an id, unique among the live processes, and each region an
+ * id, never reused by the pool. The regions of pools in other processes can
+ * be attached with both ids, to resolve the blocks they pass. Attached
+ * regions have their own ids, apart from those of the pool, and blocks are
+ * never allocated from them.
+ *
+ * All methods are thread-safe. Blocks are invalid once the pool is destroyed.
+ */
+class AshmemPool {
+public:
+    static constexpr int32_t DEFAULT_REGION_SIZE = 4 * 1024 * 1024;
+    static constexpr int32_t DEFAULT_MAX_REGIONS = 8;
+    static constexpr int32_t BLOCK_ALIGN = 64;
+
+    /**
+     * @brief Construct a new AshmemPool object. No region is created yet.
+     *
+     * @param name Name of the regions in kernel.
+     * @param regionSize Size of each region, rounded up to `BLOCK_ALIGN`.
+     * @param blockSize Size of all blocks, rounded up to `BLOCK_ALIGN`, or 0
+     * for blocks of any size.
+     * @param maxRegions Maximum number of regions.
+     */
+    explicit AshmemPool(const char *name, int32_t regionSize = DEFAULT_REGION_SIZE, int32_t blockSize = 0,
+                        int32_t maxRegions = DEFAULT_MAX_REGIONS);
+    AshmemPool(const AshmemPool&) = delete;
+    AshmemPool& operator=(const AshmemPool&) = delete;
+    ~AshmemPool();
+
+    /**
+     * @brief Allocates a block of `size` bytes, adding a region if none has
+     * room for it.
+     *
+     * @return Returns <b>true</b> if allocated; returns <b>false</b> if the
+     * size is invalid or exceeds that of blocks, or no region can be added.
+     */
+    bool Allocate(int32_t size, AshmemBlock &block);
+
+    /**
+     * @brief Gives a block back to its region.
+     *
+     * @return Returns <b>false</b> if it is not a block allocated by this pool.
+     */
+    bool Free(const AshmemBlock &block);
+
+    /**
+     * @brief Closes the regions none of whose blocks is allocated. Attached
+     * regions are kept.
+     *
+     * @return Number of regions closed.
+     */
+    int32_t Trim();
+
+    /**
+     * @brief Obtains the region of an id in this pool, e.g. to pass it with
+     * its id and that of the pool to another process.
+     */
+    sptr<Ashmem> GetRegion(int32_t id);
+
+    /**
+     * @brief Attaches a region of the pool of another process, so that its
+     * blocks can be resolved.
+     *
+     * @param poolId Id of the other pool.
+     * @param id Id of the region in the other pool.
+     * @param ashmem The region, mapped for reading and writing, or not mapped
+     * yet, in which case it is mapped so.
+     * @return Returns <b>false</b> if the ids are invalid or already
+     * attached, or the region is mapped read-only or cannot be mapped.
+     */
+    bool AttachRegion(uint64_t poolId, int32_t id, const sptr<Ashmem> &ashmem);
+
+    /**
+     * @brief Detaches a region attached by `AttachRegion()`, e.g. once the
+     * other pool has closed it or its process has died.
+     */
+    bool DetachRegion(uint64_t poolId, int32_t id);
+
+    /**
+     * @brief Sets the `data` of a block, e.g. unmarshalled, of a region of
+     * this pool or attached.
+     *
+     * @return Returns <b>false</b> if the region is unknown, or the block
+     * exceeds it.
+     */
+    bool Resolve(AshmemBlock &block);
+
+    // Obtains the number of regions, including those attached.
+    int32_t GetRegionNum();
+
+    // Obtains the bytes allocated, counted in whole blocks.
+    int32_t GetUsedSize();
+
+    inline uint64_t GetPoolId() const
+    {
+        return poolId_;
+    }
+
+    inline int32_t GetRegionSize() const
+    {
+        return regionSize_;
+    }
+
+    inline int32_t GetBlockSize() const
+    {
+        return blockSize_;
+    }
+
+private:
+    struct Region {
+        sptr<Ashmem> ashmem;
+        char *base = nullptr;
+        int32_t id = -1;
+        int32_t size = 0;
+        int32_t used = 0;
+        std::vector<int32_t> freeBlocks; // offsets of free blocks, with a block size
+        std::vector<bool> allocated; // whether each block is allocated, with a block size
+        std::map<int32_t, int32_t> freeRanges; // offset to length of free ranges, neither overlapping nor adjacent
+        std::map<int32_t, int32_t> usedRanges; // offset to length of blocks allocated, without a block size
+    };
+
+    Region *AddRegion();
+    Region *FindRegion(int32_t id);
+    bool AllocateFrom(Region &region, int32_t size, int32_t &offset);
+    bool FreeTo(Region &region, int32_t offset);
+
+    std::string name_;
+    uint64_t poolId_;
+    int32_t regionSize_;
+    int32_t blockSize_;
+    int32_t maxRegions_;
+    int32_t used_ = 0;
+    int32_t nextId_ = 0;
+    Utils::InnerMutex mutex_ INNER_MUTEX_NAME("AshmemPool");
+    std::vector<std::unique_ptr<Region>> regions_;
+    std::map<std::pair<uint64_t, int32_t>, std::unique_ptr<Region>> attached_; // by pool id and region id
+};
+} // namespace OHOS
+#endif
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ashmem_ring_buffer.h
+ *
+ * @brief Provides a ring buffer of records laid out in an <b>Ashmem</b>
+ * region, shared by producer and consumer processes.
+ */
+
+#ifndef UTILS_BASE_ASHMEM_RING_BUFFER_H
+#define UTILS_BASE_ASHMEM_RING_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include "ashmem.h"
+#include "refbase.h"
+
+namespace OHOS {
+
+/**
+ * @brief Ring buffer of records laid out in an <b>Ashmem</b> region.
+ *
+ * The region starts with a header holding the positions where records are
+ * written (tail) and read (head), each on its own cache line, followed by the
+ * records. One process creates the buffer and passes the region to the others,
+ * which attach to it. Records are written and read in place without system
+ * calls; a futex in the header is only waited on, and woken, when a consumer
+ * finds the buffer empty or a producer finds it full.
+ *
+ * There is a single consumer. There is a single producer too, unless the
+ * buffer is created for multiple producers, which may then write from any
+ * thread or process. Records are read in the order their room was reserved.
+ *
+ * @note The peers share the header and trust each other: a peer corrupting it
+ * can block the others, but cannot make them access memory out of the region.
+ */
+class AshmemRingBuffer : public virtual RefBase {
+public:
+    static constexpr uint32_t MIN_CAPACITY = 4096;
+    static constexpr uint32_t RECORD_HEADER_SIZE = 8;
+
+    /**
+     * @brief Creates an <b>Ashmem</b> region holding an empty ring buffer.
+     *
+     * @param name Name of the region in kernel.
+     * @param capacity Size of the records area, a power of 2 no less than
+     * `MIN_CAPACITY`.
+     * @param multiProducer Whether records may be written by multiple
+     * producers at a time.
+     * @return Returns the buffer, or <b>nullptr</b> if the capacity is invalid
+     * or the region cannot be created.
+     */
+    static sptr<AshmemRingBuffer> Create(const char *name, int32_t capacity, bool multiProducer = false);
+
+    /**
+     * @brief Attaches to the ring buffer of a region, e.g. received from
+     * the process having created it.
+     *
+     * @param ashmem The region, mapped for reading and writing, or not mapped
+     * yet, in which case it is mapped so.
+     * @return Returns the buffer, or <b>nullptr</b> if the region is mapped
+     * read-only or does not hold a valid ring buffer.
+     */
+    static sptr<AshmemRingBuffer> Attach(const sptr<Ashmem> &ashmem);
+
+    ~AshmemRingBuffer() override;
+
+    /**
+     * @brief Writes a record, waiting for room if the buffer is full.
+     *
+     * @param timeoutMs Time to wait for room in milliseconds, 0 not to wait
+     * and negative to wait with no limit.
+     * @return Returns <b>false</b> if the size exceeds `GetMaxRecordSize()`,
+     * or no room is freed in time.
+     */
+    bool Write(const void *data, uint32_t size, int64_t timeoutMs = 0);
+
+    /**
+     * @brief Obtains the next record in place, waiting for one if the buffer
+     * is empty. It stays there until `Pop()`.
+     *
+     * @param timeoutMs Time to wait for a record, as for `Write()`.
+     * @return Returns <b>false</b> if no record is written in time.
+     */
+    bool Peek(const void *&data, uint32_t &size, int64_t timeoutMs = 0);
+
+    /**
+     * @brief Frees the record obtained by `Peek()`, waking producers waiting
+     * for room.
+     */
+    void Pop();
+
+    /**
+     * @brief Copies the next record to `buffer` and frees it.
+     *
+     * @param size Set to the size of the record, which is kept if it exceeds
+     * `bufferSize`.
+     * @return Returns <b>false</b> if no record is written in time, or it
+     * exceeds `bufferSize`.
+     */
+    bool Read(void *buffer, uint32_t bufferSize, uint32_t &size, int64_t timeoutMs = 0);
+
+    // Obtains the number of bytes of the records not read yet, including their headers.
+    uint32_t GetUsedSize() const;
+
+    inline uint32_t GetCapacity() const
+    {
+        return capacity_;
+    }
+
+    inline uint32_t GetMaxRecordSize() const
+    {
+        return capacity_ / 2 - RECORD_HEADER_SIZE;
+    }
+
+    inline bool IsMultiProducer() const
+    {
+        return multiProducer_;
+    }
+
+    inline sptr<Ashmem> GetAshmem() const
+    {
+        return ashmem_;
+    }
+
+private:
+    struct Header;
+
+    AshmemRingBuffer(const sptr<Ashmem> &ashmem, char *base, uint32_t capacity, bool multiProducer);
+    bool Reserve(uint32_t length, uint64_t &start, int64_t timeoutMs);
+    bool HasRecord(uint64_t head) const;
+    bool HasRoom(uint64_t tail, uint32_t length);
+    void Release(uint64_t end, uint32_t length);
+
+    sptr<Ashmem> ashmem_;
+    Header *header_;
+    char *records_;
+    uint32_t capacity_;
+    bool multiProducer_;
+    std::atomic<uint64_t> cachedHead_ {0}; // head last read by producers of this process
+    uint64_t peeked_ = 0; // end of the record obtained by Peek(), 0 if none
+};
+} // namespace OHOS
+#endif
@@ -32,11 +32,16 @@
 
 #include <string>
 #include <vector>
+#include "refbase.h"
 #ifdef UTILS_CXX_RUST
 #include "cxx.h"
 #endif
 
 namespace OHOS {
+namespace Utils {
+class MappedRegion; // defined in mapped_file.h
+} // namespace Utils
+
 #ifdef UTILS_CXX_RUST
 bool RustLoadStringFromFile(const rust::String& filePath, rust::String& content);
 bool RustLoadStringFromFd(int fd, rust::String& content);
@@ -119,6 +124,36 @@ bool LoadBufferFromFile(const std::string& filePath, std::vector<char>& content)
  */
 bool SaveBufferToFile(const std::string& filePath, const std::vector<char>& content, bool truncated = true);
 
+/**
+ * @ingroup FileReadWrite
+ * @brief Maps a file read-only and obtains a view of its data, without
+ * copying it.
+ *
+ * @param filePath Indicates the path of the target file.
+ * @param region Indicates the handle of the mapping, which stays valid as
+ * long as it is held. It is null if the file is empty.
+ * @return Returns <b>true</b> if the file is mapped successfully;
+ * returns <b>false</b> otherwise.
+ * @note Unlike LoadStringFromFile(), the file size is not limited. Accessing
+ * the view after the file is truncated raises SIGBUS.
+ */
+bool LoadRegionFromFile(const std::string& filePath, sptr<Utils::MappedRegion>& region);
+
+/**
+ * @ingroup FileReadWrite
+ * @brief Maps the file of a file descriptor read-only and obtains a view of
+ * its data, without copying it.
+ *
+ * @param fd Indicates the file descriptor of the target file.
+ * @param region Indicates the handle of the mapping, which stays valid as
+ * long as it is held. It is null if the file is empty.
+ * @return Returns <b>true</b> if the file is mapped successfully;
+ * returns <b>false</b> otherwise.
+ * @note The file is mapped from its start, whatever the offset of
+ * <b>fd</b>.
+ */
+bool LoadRegionFromFd(int fd, sptr<Utils::MappedRegion>& region);
+
 /**
  * @ingroup FileReadWrite
  * @brief Checks whether a file exists.
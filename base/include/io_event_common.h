@@ -31,6 +31,22 @@ using EventCallback = std::function<void()>;
 
 static constexpr int IO_EVENT_INVALID_FD = -1;
 
+// Demultiplexer used by IOEventReactor.
+enum class IOEventBackendType {
+    EPOLL,
+    // Multishot polls submitted in batches through io_uring, with the fds registered to the ring. Readiness is
+    // reported when it changes, as with EPOLLET, so callbacks have to drain their fds.
+    IO_URING,
+};
+
+// Syscalls issued by the event backend. Syscalls per loop iteration are (waitCalls + ctlCalls) / waitCalls.
+struct IOEventSyscallStats {
+    uint64_t waitCalls = 0;
+    uint64_t ctlCalls = 0;
+    uint64_t mergedChanges = 0;  // Queued interest changes applied without a syscall of their own.
+    uint32_t eventCapacity = 0;  // Current size of the array receiving ready events.
+};
+
 
 namespace Events {
     static constexpr EventId EVENT_NONE  = 0u;
@@ -38,6 +54,15 @@ namespace Events {
     static constexpr EventId EVENT_WRITE = 1u << 1;
     static constexpr EventId EVENT_CLOSE = 1u << 2;
     static constexpr EventId EVENT_ERROR = 1u << 3;
+    // Modes of watching, they apply to the fd once any handler of it sets them.
+    // Report readiness when it changes only, instead of on every poll while it lasts.
+    static constexpr EventId EVENT_ET = 1u << 4;
+    // Stop watching the fd after an event of it is reported, until a handler of it is updated.
+    static constexpr EventId EVENT_ONESHOT = 1u << 5;
+    // Wake one of the reactors sharing the fd only, e.g. for a listening socket. Not combinable with ONESHOT, and
+    // refused by the io_uring backend.
+    static constexpr EventId EVENT_EXCLUSIVE = 1u << 6;
+    static constexpr EventId EVENT_MODES = EVENT_ET | EVENT_ONESHOT | EVENT_EXCLUSIVE;
     static constexpr EventId EVENT_INVALID = static_cast<uint32_t>(-1);
 }
 
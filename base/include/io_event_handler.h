@@ -31,9 +31,12 @@ public:
     IOEventHandler(const IOEventHandler&) = delete;
     IOEventHandler& operator=(const IOEventHandler&&) = delete;
     IOEventHandler(const IOEventHandler&&) = delete;
+    // Removes the handler from its reactor if still added, see Stop().
     virtual ~IOEventHandler();
 
     bool Start(IOEventReactor* reactor);
+    // Waits for a running callback of the handler on another thread to return, see
+    // IOEventReactor::RemoveHandler(): it must not be called holding a lock the callback takes.
     bool Stop(IOEventReactor* reactor);
     bool Update(IOEventReactor* reactor);
 
@@ -94,6 +97,7 @@ private:
     EventId events_;
     EventCallback cb_;
     bool enabled_;
+    IOEventReactor* reactor_;  // Reactor the handler is added to.
 
     friend class IOEventReactor;
 };
@@ -23,20 +23,23 @@
 #include <vector>
 #include <set>
 #include <queue>
+#include <thread>
 #include "io_event_common.h"
 #include "errors.h"
 #include "io_event_handler.h"
+#include "lock_profiler.h"
 
 namespace OHOS {
 namespace Utils {
 
-class IOEventEpoll;
+class IOEventBackend;
 
 class IOEventReactor {
 public:
     static constexpr uint8_t FLAG_CHANGED = 0x01;
-    static constexpr size_t INIT_FD_NUMS = 8;
-    static constexpr int EXPANSION_COEFF = 2;
+    static constexpr uint8_t FLAG_DISARMED = 0x02;  // A one-shot event of the fd is reported, not re-armed yet.
+    // The fd table is allocated in chunks of this many fds, existing entries never move as it grows.
+    static constexpr size_t FD_CHUNK_SIZE = 1024;
 
     IOEventReactor();
     IOEventReactor(const IOEventReactor&) = delete;
@@ -45,25 +48,52 @@ public:
     IOEventReactor& operator=(const IOEventReactor&&) = delete;
     virtual ~IOEventReactor();
 
-    ErrCode SetUp();
+    // Sets up the backend of the given type, epoll is used instead if io_uring is not available. The type can
+    // only be changed while no handler is added.
+    ErrCode SetUp(IOEventBackendType type = IOEventBackendType::EPOLL);
     ErrCode CleanUp();
     ErrCode Clean(int fd);
 
     ErrCode AddHandler(IOEventHandler* target);
+    // Removes the handler. Called from another thread than the one running the loop, it waits for a running
+    // callback of the handler to return so that the handler may be released afterwards: it must not be called
+    // holding a lock the callback takes. Called on the loop thread, e.g. from a callback, it does not wait.
     ErrCode RemoveHandler(IOEventHandler* target);
     ErrCode UpdateHandler(IOEventHandler* target);
     ErrCode FindHandler(IOEventHandler* target);
 
     void Run(int timeout);
 
+    // Handlers of fds from 0 to limit - 1 can be added. The limit defaults to the soft RLIMIT_NOFILE, and can be
+    // raised up to the hard one.
+    ErrCode SetFdLimit(int limit);
+
+    inline int GetFdLimit() const
+    {
+        return fdLimit_;
+    }
+
+    // Obtains the syscalls issued by the backend so far.
+    IOEventSyscallStats GetSyscallStats();
+
+    IOEventBackendType GetBackendType();
+
+    // Wakes the loop thread up from waiting for events, or from being parked while handling is disabled.
+    void Wakeup();
+
+    // Runs the task on the loop thread, also while handling is disabled. Tasks run in the order they are posted.
+    ErrCode Post(const EventCallback& task);
+
     inline void Terminate()
     {
         loopReady_ = false;
+        Wakeup();
     }
 
     inline void EnableHandling()
     {
         enabled_ = true;
+        Wakeup();
     }
 
     inline void DisableHandling()
@@ -71,37 +101,49 @@ public:
         enabled_ = false;
     }
 private:
+    // The first handler of an fd has anchor_ as its prev_, which tells it is started.
     struct FdEvents {
-        std::shared_ptr<IOEventHandler> head;
-        EventId events;
-        uint8_t flags;
-
-        FdEvents()
-        {
-            head = std::make_shared<IOEventHandler>();
-            events = Events::EVENT_NONE;
-            flags = 0u;
-        }
+        IOEventHandler* head = nullptr;
+        EventId events = Events::EVENT_NONE;
+        uint8_t flags = 0u;
     };
 
+    bool IsValidFd(int fd) const;
+    FdEvents* FindEntry(int fd);
+    FdEvents& GetEntry(int fd);
+
     bool HasHandler(IOEventHandler* target);
     void InsertNodeFront(int fd, IOEventHandler* target);
     void RemoveNode(IOEventHandler* target);
 
     void HandleAll(const std::vector<std::pair<int, EventId>>&);
-    void Execute(const std::vector<EventCallback>& tasks);
 
     ErrCode HandleEvents(int fd, EventId events);
+    void ApplyQueuedChanges();
+    bool IsLinked(int fd, IOEventHandler* target);
     bool UpdateToDemultiplexer(int fd);
 
     bool DoClean(int fd);
+    bool SetUpWakeup();
+    void Park();
+    void RunTasks();
 
-    std::mutex mutex_;
+    InnerMutex mutex_ INNER_MUTEX_NAME("IOEventReactor");
     std::atomic<bool> loopReady_;
     std::atomic<bool> enabled_;
     std::atomic<uint32_t> count_;
-    std::vector<struct FdEvents> ioHandlers_;
-    std::unique_ptr<IOEventEpoll> backend_;
+    std::atomic<int> fdLimit_;
+    std::vector<std::unique_ptr<FdEvents[]>> fdChunks_;
+    IOEventHandler anchor_;
+    std::unique_ptr<IOEventBackend> backend_;
+    // Handlers matching the event being handled, reused by HandleEvents() so that dispatch does not allocate.
+    std::vector<IOEventHandler*> pending_;
+    IOEventHandler* dispatching_;  // Handler whose callback runs on the loop thread without holding mutex_.
+    InnerConditionVariable dispatchDone_;
+    std::thread::id loopThread_;
+    int wakeupFd_;  // eventfd watched along with the handlers, it wakes the loop thread up.
+    InnerMutex tasksMutex_ INNER_MUTEX_NAME("IOEventReactor.tasks");
+    std::vector<EventCallback> tasks_;
 };
 
 } // namespace Utils
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTILS_EVENT_REACTOR_GROUP_H
+#define UTILS_EVENT_REACTOR_GROUP_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "io_event_common.h"
+#include "errors.h"
+#include "io_event_handler.h"
+#include "io_event_reactor.h"
+#include "lock_profiler.h"
+
+namespace OHOS {
+namespace Utils {
+
+/*
+ * Runs several IOEventReactor event loops, each one on its own thread with its
+ * own epoll fd and lock, and shards the fds across them.
+ *
+ * All handlers of one fd are kept in the same loop, which is picked when the
+ * first handler of the fd is added: by fd hash, or the loop watching the
+ * fewest fds. Tasks can be posted to any loop, for example from a callback
+ * running in another one.
+ */
+class IOEventReactorGroup {
+public:
+    enum class AssignPolicy {
+        FD_HASH,
+        LEAST_LOADED,
+    };
+
+    explicit IOEventReactorGroup(size_t loopNum, AssignPolicy policy = AssignPolicy::FD_HASH);
+    IOEventReactorGroup(const IOEventReactorGroup&) = delete;
+    IOEventReactorGroup& operator=(const IOEventReactorGroup&) = delete;
+    IOEventReactorGroup(const IOEventReactorGroup&&) = delete;
+    IOEventReactorGroup& operator=(const IOEventReactorGroup&&) = delete;
+    virtual ~IOEventReactorGroup();
+
+    // Sets up the reactors of all loops with the given backend and enables their handling.
+    ErrCode SetUp(IOEventBackendType backend = IOEventBackendType::EPOLL);
+
+    // Starts one thread running IOEventReactor::Run(timeout) for each loop.
+    ErrCode Start(int timeout = -1);
+
+    // Terminates all loops and waits for their threads.
+    void Stop();
+
+    ErrCode AddHandler(IOEventHandler* target);
+    // Waits for a running callback of the handler like IOEventReactor::RemoveHandler().
+    ErrCode RemoveHandler(IOEventHandler* target);
+    ErrCode UpdateHandler(IOEventHandler* target);
+
+    // Runs the task on the thread of the loop. Tasks of one loop run in the order they are posted.
+    ErrCode Post(size_t loop, const EventCallback& task);
+
+    // Obtains the loop the fd is assigned to, -1 if no handler of it is added.
+    int GetLoopIndex(int fd);
+
+    // Obtains the number of fds watched by the loop.
+    size_t GetLoopLoad(size_t loop);
+
+    IOEventReactor* GetReactor(size_t loop);
+
+    inline size_t GetLoopNum() const
+    {
+        return loops_.size();
+    }
+
+private:
+    struct Loop {
+        std::unique_ptr<IOEventReactor> reactor;
+        std::thread thread;
+        size_t fdNum = 0;
+    };
+
+    struct FdAssignment {
+        size_t loop;
+        size_t handlerNum;
+    };
+
+    size_t PickLoop(int fd);
+
+    AssignPolicy policy_;
+    std::vector<std::unique_ptr<Loop>> loops_;
+    InnerMutex mutex_ INNER_MUTEX_NAME("IOEventReactorGroup");
+    std::unordered_map<int, FdAssignment> assignments_;  // fd to the loop watching it
+    bool started_;
+};
+
+} // namespace Utils
+} // namespace OHOS
+#endif
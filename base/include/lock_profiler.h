@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file lock_profiler.h
+ *
+ * @brief Provides an instrumented mutex and a contention report of the
+ * mutexes used inside c_utils.
+ *
+ * <b>ProfiledMutex</b> can be used anywhere in place of std::mutex. The
+ * mutexes hidden inside SafeMap, SafeQueue, SafeBlockQueue, ThreadPool,
+ * Timer, IOEventReactor and Observable are switched to
+ * <b>ProfiledMutex</b> only when LOCK_PROFILING is defined, which is done by
+ * the GN argument <b>c_utils_lock_profiling</b>.
+ */
+
+#ifndef UTILS_BASE_LOCK_PROFILER_H
+#define UTILS_BASE_LOCK_PROFILER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "nocopyable.h"
+#include "thread_safety_analysis_macros.h"
+
+namespace OHOS {
+namespace Utils {
+
+// Bucket i counts waits shorter than 2^i microseconds. The last bucket counts all longer waits.
+constexpr size_t LOCK_WAIT_HISTOGRAM_BUCKETS = 20;
+
+struct LockStats;
+
+/**
+ * @brief Contention statistics of all mutexes sharing one name.
+ */
+struct LockContentionInfo {
+    std::string name;
+    uint64_t acquisitions = 0;  // Number of successful lock operations.
+    uint64_t contentions = 0;  // Number of lock operations that had to wait.
+    uint64_t totalWaitNs = 0;
+    uint64_t maxWaitNs = 0;
+    std::vector<uint64_t> waitHistogram;  // See LOCK_WAIT_HISTOGRAM_BUCKETS.
+    // Call sites that held the lock while another thread waited, and how often, most frequent first.
+    std::vector<std::pair<const void*, uint64_t>> holderSites;
+};
+
+/**
+ * @brief Implements a mutex which records acquisition counts, wait times and
+ * the call sites holding it when contended.
+ *
+ * Statistics are aggregated by name, so all instances created with the same
+ * name (for example, every SafeMap) are reported together. The uncontended
+ * path costs one extra relaxed atomic increment compared with std::mutex.
+ * Use std::condition_variable_any to wait on it.
+ */
+class CAPABILITY("mutex") ProfiledMutex : NoCopyable {
+public:
+/**
+ * @brief Creates a <b>ProfiledMutex</b> object.
+ *
+ * @param name Indicates the name the statistics are reported under.
+ */
+    explicit ProfiledMutex(const char* name);
+
+    ~ProfiledMutex() override {}
+
+    void lock() ACQUIRE();
+
+    bool try_lock() TRY_ACQUIRE(true);
+
+    void unlock() RELEASE();
+
+private:
+    void OnAcquired(const void* site);
+
+    std::mutex mutex_;
+    LockStats* stats_;
+    std::atomic<const void*> holderSite_;
+};
+
+/**
+ * @brief Provides the contention report of all <b>ProfiledMutex</b> objects.
+ */
+class LockProfiler {
+public:
+/**
+ * @brief Obtains the statistics of every lock name, ranked by total wait time
+ * in descending order.
+ */
+    static std::vector<LockContentionInfo> GetReport();
+
+/**
+ * @brief Obtains the ranked report in a human-readable form.
+ *
+ * Holder call sites are resolved to symbol names when possible.
+ */
+    static std::string DumpReport();
+
+/**
+ * @brief Clears all the collected statistics. Lock names are kept.
+ */
+    static void Reset();
+};
+
+#ifdef LOCK_PROFILING
+using InnerMutex = ProfiledMutex;
+using InnerConditionVariable = std::condition_variable_any;
+#define INNER_MUTEX_NAME(name) {name}
+#else
+using InnerMutex = std::mutex;
+using InnerConditionVariable = std::condition_variable;
+#define INNER_MUTEX_NAME(name) {}
+#endif
+
+} // namespace Utils
+} // namespace OHOS
+#endif // UTILS_BASE_LOCK_PROFILER_H
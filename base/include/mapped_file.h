@@ -28,6 +28,7 @@
 #include <string>
 #include <unistd.h>
 #include "errors.h"
+#include "refbase.h"
 
 namespace OHOS {
 namespace Utils {
@@ -38,7 +39,79 @@ enum class MapMode : uint8_t {
     SHARED = DEFAULT,
     READ_ONLY = 4,
     READ_WRITE = DEFAULT,
-    CREATE_IF_ABSENT = 8
+    CREATE_IF_ABSENT = 8,
+    // Options below are granted as far as the system allows, see MappedFile::GetGrantedMode().
+    POPULATE = 16,  // Fault in all pages when mapping.
+    // Use huge pages: hugetlbfs files always have them, other files ask for transparent ones, granted only if the
+    // pages faulted in when mapping (see POPULATE) turn out to be huge ones.
+    HUGE_PAGE = 32,
+    LOCKED = 64,    // Lock the pages in memory, limited by RLIMIT_MEMLOCK.
+};
+
+/*
+ * Hints on how the mapped pages will be accessed, passed to madvise().
+ *
+ * NORMAL, SEQUENTIAL, RANDOM and HUGEPAGE are kept by the MappedFile and
+ * applied again whenever it maps, so they follow TurnNext() and Resize().
+ * WILLNEED and DONTNEED only act on the pages mapped when they are given.
+ */
+enum class MapAdvice : uint8_t {
+    NORMAL = 0,
+    SEQUENTIAL,
+    RANDOM,
+    WILLNEED,
+    DONTNEED,
+    HUGEPAGE
+};
+
+/*
+ * Immutable handle of a mapping shared by a MappedFile, see MappedFile::Share().
+ *
+ * The view it covers never changes, and the mapping stays valid as long as a
+ * handle holds it, even after the MappedFile unmaps or remaps. The last handle
+ * released unmaps it. Handles can be held and released on any thread.
+ */
+class MappedRegion : public virtual RefBase {
+public:
+    MappedRegion(const MappedRegion&) = delete;
+    MappedRegion& operator=(const MappedRegion&) = delete;
+    ~MappedRegion() override;
+
+    inline const char* Begin() const
+    {
+        return data_;
+    }
+
+    inline const char* End() const
+    {
+        return data_ + size_ - 1;
+    }
+
+    inline off_t Size() const
+    {
+        return size_;
+    }
+
+    inline off_t StartOffset() const
+    {
+        return offset_;
+    }
+
+    inline off_t EndOffset() const
+    {
+        return offset_ + size_ - 1LL;
+    }
+
+private:
+    friend class MappedFile;
+    MappedRegion(char* rStart, off_t rSize, char* data, off_t size, off_t offset, const sptr<MappedRegion>& mapping);
+
+    char* rStart_;
+    off_t rSize_;
+    char* data_;
+    off_t size_;
+    off_t offset_;
+    sptr<MappedRegion> mapping_; // handle owning the mapping, null if this one does
 };
 
 class MappedFile {
@@ -67,6 +140,23 @@ public:
     ErrCode Resize(off_t newSize, bool sync = false);
     ErrCode Clear(bool force = false);
 
+    // access hints
+    ErrCode Advise(MapAdvice advice);
+    // Applies the hint on [offset, offset + size) of the view, offset is relative to Begin().
+    ErrCode Advise(MapAdvice advice, off_t offset, off_t size);
+    // Starts reading the window following the current one into page cache without waiting.
+    ErrCode PrefetchNext();
+
+    // sync
+    // Writes back dirty pages in [offset, offset + size) of the view, offset is relative to Begin().
+    // If async, the write-back is only scheduled.
+    ErrCode Flush(off_t offset = 0, off_t size = DEFAULT_LENGTH, bool async = false);
+
+    // sharing
+    // Obtains a handle of the current view for readers, who keep it while this object unmaps or remaps.
+    // Once shared, the mapping is left to the handles rather than unmapped or moved. Returns nullptr if unmapped.
+    sptr<MappedRegion> Share();
+
     // info
     inline off_t Size() const
     {
@@ -113,6 +203,11 @@ public:
         return isMapped_;
     }
 
+    inline bool IsShared() const
+    {
+        return shared_ != nullptr;
+    }
+
     inline bool IsNormed() const
     {
         return isNormed_;
@@ -133,11 +228,33 @@ public:
         return mode_;
     }
 
+    // Obtains the mode of the current mapping, where options that were asked but not granted are cleared.
+    inline MapMode GetGrantedMode() const
+    {
+        return granted_;
+    }
+
     inline int GetFd() const
     {
         return fd_;
     }
 
+    inline MapAdvice GetAdvice() const
+    {
+        return advice_;
+    }
+
+    // If enabled, TurnNext() prefetches the window after the one it turns to.
+    inline void SetPrefetch(bool enable)
+    {
+        prefetch_ = enable;
+    }
+
+    inline bool IsPrefetchEnabled() const
+    {
+        return prefetch_;
+    }
+
     bool ChangeOffset(off_t offset);
     bool ChangeSize(off_t size);
     bool ChangePath(const std::string& path);
@@ -154,9 +271,12 @@ private:
     bool NormalizePath();
     bool NormalizeSize();
     void NormalizeMode();
+    void GrantOptions();
     bool OpenFile();
     bool SyncFileSize(off_t newSize);
     void Reset();
+    ErrCode AdviseRegion(char* start, size_t len, MapAdvice advice);
+    bool ToRegionRange(off_t offset, off_t size, off_t& from, off_t& to) const;
 
     char* data_ = nullptr;
     char* rStart_ = nullptr;
@@ -170,11 +290,15 @@ private:
     static off_t pageSize_;
     off_t offset_;
     MapMode mode_;
+    MapMode granted_ = MapMode::DEFAULT;
     int fd_ = -1;
     int mapProt_ = 0;
     int mapFlag_ = 0;
     int openFlag_ = 0;
     const char *hint_;
+    MapAdvice advice_ = MapAdvice::NORMAL;
+    bool prefetch_ = false;
+    sptr<MappedRegion> shared_; // owner of the current mapping once shared
 };
 
 inline MapMode operator&(MapMode a, MapMode b)
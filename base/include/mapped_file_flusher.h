@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mapped_file_flusher.h
+ *
+ * @brief Provides write-back of the ranges written to a MappedFile.
+ */
+
+#ifndef UTILS_BASE_MAPPED_FILE_FLUSHER_H
+#define UTILS_BASE_MAPPED_FILE_FLUSHER_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <thread>
+#include "errors.h"
+#include "lock_profiler.h"
+#include "mapped_file.h"
+
+namespace OHOS {
+namespace Utils {
+
+/*
+ * Writes back the ranges of a MappedFile reported dirty by its writers.
+ *
+ * Ranges are widened to pages and merged with the overlapping or adjacent
+ * ones, so each flush issues one msync() per run of dirty pages rather than
+ * one per write, and never syncs the whole file. Flushing is either called
+ * explicitly or done by a background thread, every interval or as soon as the
+ * dirty size reaches a limit.
+ *
+ * Offsets are relative to MappedFile::Begin(). The file must stay mapped and
+ * must not be remapped while ranges are pending or the thread is running.
+ * MarkDirty() and Flush() can be called from any thread.
+ */
+class MappedFileFlusher {
+public:
+    static constexpr int DEFAULT_INTERVAL_MS = 1000;
+
+    explicit MappedFileFlusher(MappedFile& file);
+    MappedFileFlusher(const MappedFileFlusher&) = delete;
+    MappedFileFlusher& operator=(const MappedFileFlusher&) = delete;
+    // Stops the thread, then flushes the pending ranges.
+    virtual ~MappedFileFlusher();
+
+    void MarkDirty(off_t offset, off_t size);
+
+    /*
+     * Writes back all pending ranges. Ranges failing to be written stay pending.
+     * It returns once the ranges another Flush() was writing at the call are written back too.
+     */
+    ErrCode Flush(bool async = false);
+
+    // Starts a thread flushing every `intervalMs`, or once `dirtyLimit` bytes are pending if it is positive.
+    ErrCode Start(int intervalMs = DEFAULT_INTERVAL_MS, off_t dirtyLimit = 0);
+
+    // Stops the thread after its last flush.
+    void Stop();
+
+    // Obtains the bytes pending, counted in whole pages.
+    off_t GetDirtySize();
+
+    // Obtains the number of runs of dirty pages pending.
+    size_t GetRangeNum();
+
+    // Obtains the number of msync() issued so far.
+    inline uint64_t GetSyncCalls() const
+    {
+        return syncCalls_.load();
+    }
+
+private:
+    void Loop();
+    void Insert(off_t start, off_t end);
+
+    MappedFile& file_;
+    InnerMutex mutex_ INNER_MUTEX_NAME("MappedFileFlusher");
+    InnerMutex flushMutex_ INNER_MUTEX_NAME("MappedFileFlusher.flush"); // held while writing back, before mutex_
+    InnerConditionVariable cond_;
+    std::map<off_t, off_t> ranges_; // start to end of runs of dirty pages, neither overlapping nor adjacent
+    off_t dirtySize_ = 0;
+    off_t dirtyLimit_ = 0;
+    int intervalMs_ = DEFAULT_INTERVAL_MS;
+    bool running_ = false;
+    std::thread thread_;
+    std::atomic<uint64_t> syncCalls_ {0};
+};
+
+} // namespace Utils
+} // namespace OHOS
+#endif
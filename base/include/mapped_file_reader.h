@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mapped_file_reader.h
+ *
+ * @brief Provides a streaming reader over a file mapped window by window.
+ */
+
+#ifndef UTILS_BASE_MAPPED_FILE_READER_H
+#define UTILS_BASE_MAPPED_FILE_READER_H
+
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include "common_mapped_file_errors.h"
+#include "errors.h"
+
+namespace OHOS {
+namespace Utils {
+
+enum class RecordFormat : uint8_t {
+    LINE,            // Records end with '\n', which is not part of them. The last one may lack it.
+    LENGTH_PREFIXED, // Each record follows its length, a uint32_t in host byte order.
+};
+
+// A record pointing into the mapping. It is valid until the reader moves on to the next window, copy it to keep it.
+struct MappedRecord {
+    const char* data = nullptr;
+    size_t size = 0;
+};
+
+/*
+ * Reads a file from start to end through two read-only mappings.
+ *
+ * The file is cut into windows of `windowSize` bytes. Each mapping covers a
+ * window plus the first `overlap` bytes of the following one, so any record
+ * starting in a window and not longer than the overlap is contiguous in it.
+ * While the cursor is in one window, the next one is already mapped and being
+ * read ahead, and moving to it only swaps the two. Pages the cursor has passed
+ * are released with MADV_DONTNEED, so the memory in use stays bounded by the
+ * two mappings whatever the size of the file.
+ *
+ * The file is opened and its size taken once by Open(), then each window is
+ * mapped directly from that fd; data appended later is not read.
+ */
+class MappedFileReader {
+public:
+    static constexpr off_t DEFAULT_WINDOW_SIZE = 4 * 1024 * 1024;
+    static constexpr off_t DEFAULT_OVERLAP = 64 * 1024;
+
+    class Iterator {
+    public:
+        Iterator() = default;
+        explicit Iterator(MappedFileReader* reader);
+
+        inline const MappedRecord& operator*() const
+        {
+            return record_;
+        }
+
+        inline const MappedRecord* operator->() const
+        {
+            return &record_;
+        }
+
+        Iterator& operator++();
+
+        inline bool operator==(const Iterator& other) const
+        {
+            return reader_ == other.reader_;
+        }
+
+        inline bool operator!=(const Iterator& other) const
+        {
+            return reader_ != other.reader_;
+        }
+
+    private:
+        MappedFileReader* reader_ = nullptr;
+        MappedRecord record_;
+    };
+
+    explicit MappedFileReader(const std::string& path, RecordFormat format = RecordFormat::LINE,
+                              off_t windowSize = DEFAULT_WINDOW_SIZE, off_t overlap = DEFAULT_OVERLAP);
+    MappedFileReader(const MappedFileReader&) = delete;
+    MappedFileReader& operator=(const MappedFileReader&) = delete;
+    virtual ~MappedFileReader();
+
+    // Maps the first two windows. Window size and overlap are rounded up to pages, the overlap is at most a window.
+    ErrCode Open();
+    void Close();
+
+    /*
+     * Obtains the next record and moves the cursor after it.
+     * Returns ERR_ENOUGH_DATA at the end of file, ERR_OVERFLOW if the record is longer than the overlap,
+     * and ERR_INVALID_VALUE if the file ends within a length-prefixed record. The cursor is kept on errors.
+     */
+    ErrCode Next(MappedRecord& record);
+
+    // Obtains `len` contiguous bytes at the cursor and moves the cursor after them, errors are those of Next().
+    ErrCode Read(size_t len, MappedRecord& out);
+
+    // Iterates records from the cursor until Next() fails, LastError() tells why it stopped.
+    Iterator begin();
+    Iterator end();
+
+    inline ErrCode LastError() const
+    {
+        return lastError_;
+    }
+
+    inline off_t Position() const
+    {
+        return pos_;
+    }
+
+    inline off_t FileSize() const
+    {
+        return fileSize_;
+    }
+
+    inline bool IsOpen() const
+    {
+        return fd_ != -1;
+    }
+
+    inline off_t GetWindowSize() const
+    {
+        return windowSize_;
+    }
+
+    inline off_t GetOverlap() const
+    {
+        return overlap_;
+    }
+
+private:
+    struct Window {
+        char* data = nullptr;
+        off_t size = 0;
+    };
+
+    ErrCode MapWindow(Window& window, off_t index);
+    void UnmapWindow(Window& window);
+    ErrCode SwitchWindow();
+    ErrCode Prepare(size_t len, const char*& data, size_t& avail);
+    void Consume(size_t len);
+    void ReleaseConsumed();
+
+    std::string path_;
+    RecordFormat format_;
+    off_t windowSize_;
+    off_t overlap_;
+    off_t fileSize_ = 0;
+    off_t pos_ = 0;
+    off_t released_ = 0;    // pages of the current window before it are released
+    off_t curIndex_ = 0;
+    ErrCode lastError_ = MAPPED_FILE_ERR_OK;
+    int fd_ = -1;
+    Window cur_;
+    Window next_;  // mapped only if the file has a window after the current one
+};
+
+} // namespace Utils
+} // namespace OHOS
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file mapped_log.h
+ *
+ * @brief Provides an append-only log kept in a memory-mapped file.
+ */
+
+#ifndef UTILS_BASE_MAPPED_LOG_H
+#define UTILS_BASE_MAPPED_LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include "errors.h"
+#include "lock_profiler.h"
+
+namespace OHOS {
+namespace Utils {
+
+// Room reserved for a record. `data` stays valid as long as the log is open.
+struct MappedLogRecord {
+    char* data = nullptr;
+    uint32_t size = 0;
+    off_t offset = -1; // offset of the record in the log
+};
+
+/*
+ * Append-only log of records in a file, mapped as it grows.
+ *
+ * The address range of `capacity` bytes is reserved when opening, and the
+ * file is extended by `extentSize` bytes at a time with fallocate() and
+ * mapped at the next address of the range. Hence the log never moves, and
+ * pointers to records stay valid while appending.
+ *
+ * Appending a record reserves its room by advancing an atomic cursor, once
+ * the room is mapped, so appenders on different threads only contend when the
+ * log has to grow. A failed reservation leaves the cursor where it was.
+ * A record is written in place, then committed by publishing its header.
+ * Replay() passes the committed records in place, up to the first one not
+ * committed, which is also where appending restarts when the file is opened
+ * again. Records committed after it, by other appenders of a process that
+ * stopped, are lost: opening clears the file from there.
+ */
+class MappedLog {
+public:
+    static constexpr off_t DEFAULT_CAPACITY = 1024LL * 1024 * 1024;
+    static constexpr off_t DEFAULT_EXTENT_SIZE = 4 * 1024 * 1024;
+    static constexpr uint32_t MAX_RECORD_SIZE = (1U << 31) - 1;
+
+    // Visits a committed record, returns false to stop.
+    using Visitor = std::function<bool(const char* data, uint32_t size, off_t offset)>;
+
+    explicit MappedLog(const std::string& path, off_t capacity = DEFAULT_CAPACITY,
+                       off_t extentSize = DEFAULT_EXTENT_SIZE);
+    MappedLog(const MappedLog&) = delete;
+    MappedLog& operator=(const MappedLog&) = delete;
+    virtual ~MappedLog();
+
+    // Opens or creates the file, finds the end of its committed records and clears the file after it.
+    ErrCode Open();
+    void Close();
+
+    // Reserves room for a record of `size` bytes. It is lost unless committed.
+    // Returns ERR_OVERFLOW once the capacity is exhausted, or MAPPED_FILE_ERR_FAILED if the log cannot grow.
+    ErrCode Reserve(uint32_t size, MappedLogRecord& record);
+    void Commit(const MappedLogRecord& record);
+
+    // Reserves, copies the data and commits.
+    ErrCode Append(const void* data, uint32_t size);
+
+    // Visits the committed records from `offset`, which must be that of a record.
+    ErrCode Replay(const Visitor& visitor, off_t offset = 0) const;
+
+    // Writes back the records reserved so far.
+    ErrCode Flush(bool async = false);
+
+    inline bool IsOpen() const
+    {
+        return base_ != nullptr;
+    }
+
+    inline char* Base() const
+    {
+        return base_;
+    }
+
+    // Obtains the offset where the next record will be reserved.
+    inline off_t Tail() const
+    {
+        return static_cast<off_t>(tail_.load());
+    }
+
+    // Obtains the size of the file mapped so far.
+    inline off_t MappedSize() const
+    {
+        return static_cast<off_t>(mapped_.load());
+    }
+
+    inline off_t Capacity() const
+    {
+        return capacity_;
+    }
+
+    inline off_t ExtentSize() const
+    {
+        return extentSize_;
+    }
+
+private:
+    ErrCode Grow(uint64_t end);
+    off_t Recover() const;
+    void ClearFrom(uint64_t offset);
+
+    std::string path_;
+    off_t capacity_;
+    off_t extentSize_;
+    int fd_ = -1;
+    char* base_ = nullptr;
+    std::atomic<uint64_t> tail_ {0};
+    std::atomic<uint64_t> mapped_ {0};
+    InnerMutex growMutex_ INNER_MUTEX_NAME("MappedLog");
+};
+
+} // namespace Utils
+} // namespace OHOS
+#endif
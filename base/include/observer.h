@@ -21,6 +21,8 @@
 #include <set>
 #include <mutex>
 
+#include "lock_profiler.h"
+
 namespace OHOS {
 
 /**
@@ -106,7 +108,7 @@ protected:
 
 protected:
     std::set<std::shared_ptr<Observer>> obs; // A collection of observers.
-    std::mutex mutex_;
+    Utils::InnerMutex mutex_ INNER_MUTEX_NAME("Observable");
 
 private:
     bool changed_ = false; // The state of this Observable object.
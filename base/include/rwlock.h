@@ -23,9 +23,13 @@
 #define UTILS_RWLOCK_H
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
 #include <thread>
 
 #include "nocopyable.h"
+#include "thread_safety_analysis_macros.h"
 
 namespace OHOS {
 namespace Utils {
@@ -38,7 +42,7 @@ namespace Utils {
  * and read and write operations are mutually exclusive.
  * However, read operations are not mutually exclusive.
  */
-class RWLock : NoCopyable {
+class CAPABILITY("rwlock") RWLock : NoCopyable {
 public:
 /**
  * @brief Enumerates the lock states.
@@ -70,7 +74,7 @@ public:
  * In other modes, a read lock can be obtained when the state is
  * non-write-locked.
  */
-    void LockRead();
+    void LockRead() ACQUIRE_SHARED();
 
 /**
  * @brief Releases the read lock.
@@ -79,7 +83,7 @@ public:
  * LockRead() will return directly.
  * This function will also return directly when called.
  */
-    void UnLockRead();
+    void UnLockRead() RELEASE_SHARED();
 
 /**
  *@brief Obtains a write lock
@@ -89,16 +93,78 @@ public:
  * The write lock can be obtained only when no other thread has obtained a read
  * lock or a write lock; otherwise, the thread shall wait.
  */
-    void LockWrite();
+    void LockWrite() ACQUIRE();
 
 /**
  * @brief Releases the write lock.
  *
  * If the thread has not obtained a write lock, this function returns directly.
  */
-    void UnLockWrite();
+    void UnLockWrite() RELEASE();
+
+/**
+ * @brief Tries to obtain a read lock without waiting.
+ *
+ * Follows the same rules as LockRead(), but fails immediately instead of
+ * waiting when the read lock cannot be obtained.
+ *
+ * @return Returns <b>true</b> if the read lock is obtained;
+ * returns <b>false</b> otherwise.
+ */
+    bool TryLockRead() TRY_ACQUIRE_SHARED(true);
+
+/**
+ * @brief Tries to obtain the write lock without waiting.
+ *
+ * @return Returns <b>true</b> if the write lock is obtained;
+ * returns <b>false</b> if another thread holds a read or write lock.
+ */
+    bool TryLockWrite() TRY_ACQUIRE(true);
+
+/**
+ * @brief Obtains a read lock, waiting at most for the specified duration.
+ *
+ * @param timeout Indicates the maximum duration to wait.
+ * @return Returns <b>true</b> if the read lock is obtained;
+ * returns <b>false</b> if the timeout expires.
+ */
+    bool LockReadFor(std::chrono::nanoseconds timeout) TRY_ACQUIRE_SHARED(true);
+
+/**
+ * @brief Obtains the write lock, waiting at most for the specified duration.
+ *
+ * While waiting, the thread counts as a waiting writer, so that in
+ * write-first mode new readers are held back.
+ *
+ * @param timeout Indicates the maximum duration to wait.
+ * @return Returns <b>true</b> if the write lock is obtained;
+ * returns <b>false</b> if the timeout expires.
+ */
+    bool LockWriteFor(std::chrono::nanoseconds timeout) TRY_ACQUIRE(true);
+
+/**
+ * @brief Upgrades the read lock held by this thread to the write lock.
+ *
+ * The upgrade succeeds only when this thread is the only reader. It is
+ * atomic: no other writer can get the lock in between. On failure, the
+ * thread still holds its read lock.
+ *
+ * @return Returns <b>true</b> if the lock is upgraded;
+ * returns <b>false</b> if other readers hold the lock.
+ */
+    bool TryUpgradeToWrite() REQUIRES_SHARED(this);
+
+/**
+ * @brief Downgrades the write lock held by this thread to a read lock.
+ *
+ * The downgrade is atomic: no other writer can get the lock in between.
+ * If the thread does not hold the write lock, this function returns directly.
+ */
+    void DowngradeToRead() RELEASE() ACQUIRE_SHARED();
 
 private:
+    bool TryLockReadOnce();
+
     bool writeFirst_;  // Whether the thread is write-first. The value true means that the thread is write-first.
     std::thread::id writeThreadID_;  // ID of the write thread.
 
@@ -110,6 +176,98 @@ private:
     std::atomic_uint writeWaitCount_;
 };
 
+/**
+ * @brief Implements the <b>BigReaderLock</b> class, a read-write lock
+ * optimized for read-mostly workloads.
+ *
+ * Each reader thread is bound to one of several reader slots, and every slot
+ * owns a counter padded to a cache line. Readers only touch their own slot,
+ * so concurrent readers on different cores do not contend on a shared cache
+ * line. A writer announces itself and then waits until every slot drains,
+ * which makes writes more expensive than with <b>RWLock</b>.
+ * The lock is always write-first. It can be used with
+ * <b>UniqueReadGuard</b> and <b>UniqueWriteGuard</b>.
+ */
+class CAPABILITY("rwlock") BigReaderLock : NoCopyable {
+public:
+/**
+ * @brief Creates a <b>BigReaderLock</b> object.
+ *
+ * The number of reader slots defaults to the number of hardware threads.
+ */
+    BigReaderLock() : BigReaderLock(0) {}
+
+/**
+ * @brief Creates a <b>BigReaderLock</b> object.
+ *
+ * @param slotCount Indicates the number of reader slots. The value 0 means
+ * the number of hardware threads is used.
+ */
+    explicit BigReaderLock(size_t slotCount);
+
+/**
+ * @brief Destroys this <b>BigReaderLock</b> object.
+ */
+    ~BigReaderLock() override {}
+
+/**
+ * @brief Obtains a read lock.
+ *
+ * If the thread has obtained the write lock, this function returns directly.
+ * Otherwise, the read lock can be obtained only when no writer holds or is
+ * waiting for the write lock.
+ */
+    void LockRead() ACQUIRE_SHARED();
+
+/**
+ * @brief Releases the read lock.
+ *
+ * If the thread has obtained the write lock, this function returns directly.
+ */
+    void UnLockRead() RELEASE_SHARED();
+
+/**
+ * @brief Obtains the write lock.
+ *
+ * If the thread has obtained the write lock, this function returns directly.
+ * Otherwise, the thread waits until other writers have finished and every
+ * reader slot has been released.
+ */
+    void LockWrite() ACQUIRE();
+
+/**
+ * @brief Releases the write lock.
+ *
+ * If the thread has not obtained the write lock, this function returns directly.
+ */
+    void UnLockWrite() RELEASE();
+
+/**
+ * @brief Obtains the number of reader slots.
+ */
+    size_t GetSlotCount() const
+    {
+        return slotCount_;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    // Reader counter of one slot. Padded so that each slot owns a cache line.
+    struct alignas(CACHE_LINE_SIZE) ReaderSlot {
+        std::atomic_int count {0};
+    };
+
+    ReaderSlot& CurrentSlot();
+
+    size_t slotCount_;
+    std::unique_ptr<ReaderSlot[]> slots_;
+
+    // Whether a writer holds or is waiting for the write lock.
+    alignas(CACHE_LINE_SIZE) std::atomic_bool writerPresent_;
+    std::thread::id writeThreadID_;  // ID of the write thread.
+};
+
 /**
  * @brief UniqueWriteGuard object controls the ownership of a lockable object
  * within a scope, and is used only as acquisition
@@ -119,15 +277,15 @@ private:
  * providing a convenient RAII mechanism.
  */
 template <typename RWLockable>
-class UniqueWriteGuard : NoCopyable {
+class SCOPED_CAPABILITY UniqueWriteGuard : NoCopyable {
 public:
-    explicit UniqueWriteGuard(RWLockable &rwLockable)
+    explicit UniqueWriteGuard(RWLockable &rwLockable) ACQUIRE(rwLockable)
         : rwLockable_(rwLockable)
     {
         rwLockable_.LockWrite();
     }
 
-    ~UniqueWriteGuard() override
+    ~UniqueWriteGuard() RELEASE() override
     {
         rwLockable_.UnLockWrite();
     }
@@ -149,15 +307,15 @@ private:
  * providing a convenient RAII mechanism.
  */
 template <typename RWLockable>
-class UniqueReadGuard : NoCopyable {
+class SCOPED_CAPABILITY UniqueReadGuard : NoCopyable {
 public:
-    explicit UniqueReadGuard(RWLockable &rwLockable)
+    explicit UniqueReadGuard(RWLockable &rwLockable) ACQUIRE_SHARED(rwLockable)
         : rwLockable_(rwLockable)
     {
         rwLockable_.LockRead();
     }
 
-    ~UniqueReadGuard() override
+    ~UniqueReadGuard() RELEASE() override
     {
         rwLockable_.UnLockRead();
     }
@@ -169,6 +327,86 @@ private:
     RWLockable &rwLockable_;
 };
 
+/**
+ * @brief UniqueTryWriteGuard object tries to obtain the write lock of a
+ * lockable object at construction time, either without waiting or within a
+ * timeout, and releases it during destruction if it was obtained.
+ *
+ * Call OwnsLock() to check whether the write lock is held.
+ */
+template <typename RWLockable>
+class UniqueTryWriteGuard : NoCopyable {
+public:
+    explicit UniqueTryWriteGuard(RWLockable &rwLockable)
+        : rwLockable_(rwLockable), owns_(rwLockable_.TryLockWrite())
+    {
+    }
+
+    UniqueTryWriteGuard(RWLockable &rwLockable, std::chrono::nanoseconds timeout)
+        : rwLockable_(rwLockable), owns_(rwLockable_.LockWriteFor(timeout))
+    {
+    }
+
+    ~UniqueTryWriteGuard() NO_THREAD_SAFETY_ANALYSIS override
+    {
+        if (owns_) {
+            rwLockable_.UnLockWrite();
+        }
+    }
+
+    bool OwnsLock() const
+    {
+        return owns_;
+    }
+
+private:
+    UniqueTryWriteGuard() = delete;
+
+private:
+    RWLockable &rwLockable_;
+    bool owns_;
+};
+
+/**
+ * @brief UniqueTryReadGuard object tries to obtain a read lock of a
+ * lockable object at construction time, either without waiting or within a
+ * timeout, and releases it during destruction if it was obtained.
+ *
+ * Call OwnsLock() to check whether the read lock is held.
+ */
+template <typename RWLockable>
+class UniqueTryReadGuard : NoCopyable {
+public:
+    explicit UniqueTryReadGuard(RWLockable &rwLockable)
+        : rwLockable_(rwLockable), owns_(rwLockable_.TryLockRead())
+    {
+    }
+
+    UniqueTryReadGuard(RWLockable &rwLockable, std::chrono::nanoseconds timeout)
+        : rwLockable_(rwLockable), owns_(rwLockable_.LockReadFor(timeout))
+    {
+    }
+
+    ~UniqueTryReadGuard() NO_THREAD_SAFETY_ANALYSIS override
+    {
+        if (owns_) {
+            rwLockable_.UnLockRead();
+        }
+    }
+
+    bool OwnsLock() const
+    {
+        return owns_;
+    }
+
+private:
+    UniqueTryReadGuard() = delete;
+
+private:
+    RWLockable &rwLockable_;
+    bool owns_;
+};
+
 } // namespace Utils
 } // namespace OHOS
 #endif
@@ -30,6 +30,8 @@
 #include <queue>
 #include <atomic>
 
+#include "lock_profiler.h"
+
 namespace OHOS {
 
 /**
@@ -57,7 +59,7 @@ public:
  */
     virtual void Push(T const& elem)
     {
-        std::unique_lock<std::mutex> lock(mutexLock_);
+        std::unique_lock<Utils::InnerMutex> lock(mutexLock_);
         while (queueT_.size() >= maxSize_) {
             // If the queue is full, wait for jobs to be taken.
             cvNotFull_.wait(lock, [&]() { return (queueT_.size() < maxSize_); });
@@ -79,7 +81,7 @@ public:
  */
     T Pop()
     {
-        std::unique_lock<std::mutex> lock(mutexLock_);
+        std::unique_lock<Utils::InnerMutex> lock(mutexLock_);
 
         while (queueT_.empty()) {
             // If the queue is empty, wait for elements to be pushed in.
@@ -104,7 +106,7 @@ public:
  */
     virtual bool PushNoWait(T const& elem)
     {
-        std::unique_lock<std::mutex> lock(mutexLock_);
+        std::unique_lock<Utils::InnerMutex> lock(mutexLock_);
         if (queueT_.size() >= maxSize_) {
             return false;
         }
@@ -126,7 +128,7 @@ public:
  */
     bool PopNotWait(T& outtask)
     {
-        std::unique_lock<std::mutex> lock(mutexLock_);
+        std::unique_lock<Utils::InnerMutex> lock(mutexLock_);
         if (queueT_.empty()) {
             return false;
         }
@@ -140,19 +142,19 @@ public:
 
     unsigned int Size()
     {
-        std::unique_lock<std::mutex> lock(mutexLock_);
+        std::unique_lock<Utils::InnerMutex> lock(mutexLock_);
         return queueT_.size();
     }
 
     bool IsEmpty()
     {
-        std::unique_lock<std::mutex> lock(mutexLock_);
+        std::unique_lock<Utils::InnerMutex> lock(mutexLock_);
         return queueT_.empty();
     }
 
     bool IsFull()
     {
-        std::unique_lock<std::mutex> lock(mutexLock_);
+        std::unique_lock<Utils::InnerMutex> lock(mutexLock_);
         return queueT_.size() == maxSize_;
     }
 
@@ -160,9 +162,9 @@ public:
 
 protected:
     unsigned long maxSize_;  // Capacity of the queue
-    std::mutex mutexLock_;
-    std::condition_variable cvNotEmpty_;
-    std::condition_variable cvNotFull_;
+    Utils::InnerMutex mutexLock_ INNER_MUTEX_NAME("SafeBlockQueue");
+    Utils::InnerConditionVariable cvNotEmpty_;
+    Utils::InnerConditionVariable cvNotFull_;
     std::queue<T> queueT_;
 };
 
@@ -192,7 +194,7 @@ public:
     virtual void Push(T const& elem)
     {
         unfinishedTaskCount_++;
-        std::unique_lock<std::mutex> lock(mutexLock_);
+        std::unique_lock<Utils::InnerMutex> lock(mutexLock_);
         while (queueT_.size() >= maxSize_) {
             // If the queue is full, wait for jobs to be taken.
             cvNotFull_.wait(lock, [&]() { return (queueT_.size() < maxSize_); });
@@ -214,7 +216,7 @@ public:
  */
     virtual bool PushNoWait(T const& elem)
     {
-        std::unique_lock<std::mutex> lock(mutexLock_);
+        std::unique_lock<Utils::InnerMutex> lock(mutexLock_);
         if (queueT_.size() >= maxSize_) {
             return false;
         }
@@ -237,7 +239,7 @@ public:
  */
     bool OneTaskDone()
     {
-        std::unique_lock<std::mutex> lock(mutexLock_);
+        std::unique_lock<Utils::InnerMutex> lock(mutexLock_);
         int unfinished = unfinishedTaskCount_ - 1;
 
         if (unfinished <= 0) {
@@ -259,7 +261,7 @@ public:
  */
     void Join()
     {
-        std::unique_lock<std::mutex> lock(mutexLock_);
+        std::unique_lock<Utils::InnerMutex> lock(mutexLock_);
         cvAllTasksDone_.wait(lock, [&] { return unfinishedTaskCount_ == 0; });
     }
 
@@ -279,7 +281,7 @@ protected:
     using SafeBlockQueue<T>::queueT_;
 
     std::atomic<int> unfinishedTaskCount_;
-    std::condition_variable cvAllTasksDone_;
+    Utils::InnerConditionVariable cvAllTasksDone_;
 };
 
 } // namespace OHOS
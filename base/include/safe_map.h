@@ -20,6 +20,8 @@
 #include <mutex>
 #include <functional>
 
+#include "lock_profiler.h"
+
 namespace OHOS {
 
 /**
@@ -43,7 +45,7 @@ public:
             return *this;
         }
         auto tmp = rhs.Clone();
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         map_ = std::move(tmp);
 
         return *this;
@@ -51,14 +53,14 @@ public:
 
     V ReadVal(const K& key)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         return map_[key];
     }
 
     template<typename LambdaCallback>
     void ChangeValueByLambda(const K& key, LambdaCallback callback)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         callback(map_[key]);
     }
 
@@ -71,7 +73,7 @@ public:
      */
     int Size()
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         return map_.size();
     }
 
@@ -87,7 +89,7 @@ public:
      */
     bool IsEmpty()
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         return map_.empty();
     }
 
@@ -101,7 +103,7 @@ public:
      */
     bool Insert(const K& key, const V& value)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         auto ret = map_.insert(std::pair<K, V>(key, value));
         return ret.second;
     }
@@ -116,7 +118,7 @@ public:
      */
     void EnsureInsert(const K& key, const V& value)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         auto ret = map_.insert(std::pair<K, V>(key, value));
         // find key and cannot insert
         if (!ret.second) {
@@ -138,7 +140,7 @@ public:
     bool Find(const K& key, V& value)
     {
         bool ret = false;
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
 
         auto iter = map_.find(key);
         if (iter != map_.end()) {
@@ -161,7 +163,7 @@ public:
     bool FindOldAndSetNew(const K& key, V& oldValue, const V& newValue)
     {
         bool ret = false;
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         if (map_.size() > 0) {
             auto iter = map_.find(key);
             if (iter != map_.end()) {
@@ -182,7 +184,7 @@ public:
      */
     void Erase(const K& key)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         map_.erase(key);
     }
 
@@ -191,7 +193,7 @@ public:
      */
     void Clear()
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         map_.clear();
         return;
     }
@@ -206,7 +208,7 @@ public:
      */
     void Iterate(const SafeMapCallBack& callback)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         if (!map_.empty()) {
             for (auto it = map_.begin(); it != map_.end(); it++) {
                 callback(it -> first, it -> second);
@@ -215,12 +217,12 @@ public:
     }
 
 private:
-    mutable std::mutex mutex_;
+    mutable Utils::InnerMutex mutex_ INNER_MUTEX_NAME("SafeMap");
     std::map<K, V> map_;
 
     std::map<K, V> Clone() const noexcept
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         return map_;
     }
 };
@@ -28,6 +28,8 @@
 #include <deque>
 #include <mutex>
 
+#include "lock_profiler.h"
+
 namespace OHOS {
 
 /**
@@ -50,7 +52,7 @@ public:
 
     void Erase(const T& object)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         for (auto iter = deque_.begin(); iter != deque_.end(); iter++) {
             if (*iter == object) {
                 deque_.erase(iter);
@@ -61,19 +63,19 @@ public:
 
     bool Empty()
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         return deque_.empty();
     }
 
     void Push(const T& pt)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         return DoPush(pt);
     }
 
     void Clear()
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         if (!deque_.empty()) {
             deque_.clear();
         }
@@ -83,13 +85,13 @@ public:
 
     int Size()
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         return deque_.size();
     }
 
     bool Pop(T& pt)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<Utils::InnerMutex> lock(mutex_);
         return DoPop(pt);
     }
 
@@ -98,7 +100,7 @@ protected:
     virtual bool DoPop(T& pt) = 0;
 
     std::deque<T> deque_;
-    std::mutex mutex_;
+    Utils::InnerMutex mutex_ INNER_MUTEX_NAME("SafeQueue");
 };
 
 /**
@@ -16,6 +16,7 @@
 #define THREAD_POOL_H
 
 #include "nocopyable.h"
+#include "lock_profiler.h"
 
 #include <thread>
 #include <mutex>
@@ -104,9 +105,9 @@ private:
 
 private:
     std::string myName_;
-    std::mutex mutex_;
-    std::condition_variable hasTaskToDo_;
-    std::condition_variable acceptNewTask_;
+    Utils::InnerMutex mutex_ INNER_MUTEX_NAME("ThreadPool");
+    Utils::InnerConditionVariable hasTaskToDo_;
+    Utils::InnerConditionVariable acceptNewTask_;
     std::vector<std::thread> threads_;
     std::deque<Task> tasks_;
     size_t maxTaskNum_;
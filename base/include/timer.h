@@ -17,19 +17,43 @@
 #define UTILS_TIMER_H
 
 #include <sys/types.h>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <string>
 #include <list>
 #include <map>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 #include <functional>
 #include <memory>
 
+#include "lock_profiler.h"
+
 namespace OHOS {
+class ThreadPool;
 namespace Utils {
 class EventReactor;
+class TimingWheel;
+struct ExpiredTimer;
+
+// Bucket i counts callbacks which ran less than 2^i microseconds late. The last bucket counts all later ones.
+constexpr size_t TIMER_LATENCY_HISTOGRAM_BUCKETS = 20;
+
+/**
+ * @brief Statistics of how late timed event callbacks ran compared with their
+ * scheduled expiry.
+ */
+struct TimerLatencyStats {
+    uint64_t callbacks = 0;  // Number of callbacks which have started.
+    uint64_t wakeups = 0;  // Number of times the timer thread woke up to handle expiries.
+    uint64_t totalLatencyNs = 0;
+    uint64_t maxLatencyNs = 0;
+    std::vector<uint64_t> latencyHistogram;  // See TIMER_LATENCY_HISTOGRAM_BUCKETS.
+};
+
 /**
  * @brief Implements a timer manager.
  *
@@ -53,6 +77,48 @@ public:
     using TimerCallback = std::function<void ()>;
     using TimerCallbackPtr = std::shared_ptr<TimerCallback>;
     using TimerListCallback = std::function<void (int timerFd)>;
+    // The argument is the number of expiries which are also due, see RepeatMode.
+    using TimerOverrunCallback = std::function<void (uint64_t overruns)>;
+
+    /**
+     * @brief Specifies how a timer keeps its timed events.
+     */
+    enum class TimerEngine {
+        /**
+         * One timerfd for each interval and each one-shot event. Suitable
+         * for a small number of timed events.
+         */
+        PER_INTERVAL_FD,
+        /**
+         * A hierarchical timing wheel with a 1 ms tick (by default),
+         * multiplexed onto a single timerfd. Register() and Unregister() take O(1) time, and
+         * the timer thread wakes up at most once per tick no matter how many
+         * timed events are due. Suitable for a large number of timed events.
+         */
+        TIMING_WHEEL,
+    };
+
+    /**
+     * @brief Specifies how a periodic timed event registered by duration or
+     * deadline handles expiries it missed, for example because a callback
+     * overran. Expiries always stay on the fixed-rate grid
+     * `first expiry + k * period`, so the event never drifts.
+     */
+    enum class RepeatMode {
+        /**
+         * The missed expiries are merged into one callback, whose argument
+         * is the number of the skipped ones.
+         */
+        SKIP_MISSED,
+        /**
+         * The callback runs once for each missed expiry, back to back, until
+         * it has caught up. The argument is the number of expiries still
+         * queued behind the current one. At most 64 missed expiries run at
+         * a time, the last of them receives the number of the others, which
+         * are skipped.
+         */
+        CATCH_UP,
+    };
 
 public:
     /**
@@ -70,6 +136,19 @@ public:
      * triggered). `0` means not to wait, which occupies too much CPU time.
      */
     explicit Timer(const std::string& name, int timeoutMs = 1000);
+    /**
+     * @brief Creates a timer which uses the specified engine.
+     *
+     * @param name Indicates the name of the timer.
+     * @param timeoutMs Indicates the duration for which the timer will wait.
+     * @param engine Indicates the engine which keeps the timed events.
+     * @param wheelTick Indicates the tick of the timing wheel, which is the
+     * precision of all the timed events on it. It is ignored by
+     * `TimerEngine::PER_INTERVAL_FD`.
+     * @see TimerEngine
+     */
+    Timer(const std::string& name, int timeoutMs, TimerEngine engine,
+        std::chrono::nanoseconds wheelTick = std::chrono::milliseconds(1));
     virtual ~Timer();
 
     /**
@@ -102,7 +181,9 @@ public:
      * The value `true` means that the timed event is one-shot,
 	 * and `false` means the opposite. The default value is `false`.
      * @return Returns the ID of a timed event. You can use it as the
-     * parameter of Unregister().
+     * parameter of Unregister(). With `TimerEngine::TIMING_WHEEL`, a
+     * periodic timed event of interval `0` is refused with
+     * `TIMER_ERR_INVALID_VALUE`.
      * @see Unregister
      */
     uint32_t Register(const TimerCallback& callback, uint32_t interval /* ms */, bool once = false);
@@ -115,37 +196,154 @@ public:
      */
     void Unregister(uint32_t timerId);
 
+    /**
+     * @brief Registers a timed event with an interval of any precision.
+     *
+     * With `TimerEngine::PER_INTERVAL_FD`, the timed events registered by
+     * duration or deadline share one timerfd, which is always armed with an
+     * absolute CLOCK_MONOTONIC deadline, at a precision of 1 us. With
+     * `TimerEngine::TIMING_WHEEL`, the precision is the tick of the wheel.
+     *
+     * @param callback Indicates the callback function of the timed event.
+     * @param interval Indicates the interval of the timed event, for example
+     * `std::chrono::microseconds(500)`.
+     * @param once Indicates whether the timed event is one-shot.
+     * @param mode Indicates how a periodic timed event handles missed expiries.
+     * @param slack Indicates how late each expiry may be handled. Expiries
+     * with slack are aligned to a coarse boundary, so that the expiries of
+     * many timed events are handled in a single wakeup of the timer thread.
+     * The default value `0` means as precise as possible.
+     * @return Returns the ID of the timed event, `TIMER_ERR_INVALID_VALUE`
+     * if a periodic timed event has an interval of `0`, or
+     * `TIMER_ERR_DEAL_FAILED` on other failures. You can use it as the
+     * parameter of Unregister().
+     */
+    uint32_t Register(const TimerOverrunCallback& callback, std::chrono::nanoseconds interval, bool once = false,
+        RepeatMode mode = RepeatMode::SKIP_MISSED, std::chrono::nanoseconds slack = std::chrono::nanoseconds::zero());
+
+    /**
+     * @brief Registers a timed event which first expires at an absolute time.
+     *
+     * @param callback Indicates the callback function of the timed event.
+     * @param deadline Indicates the first expiry. std::chrono::steady_clock
+     * is CLOCK_MONOTONIC.
+     * @param period Indicates the period of the timed event after the first
+     * expiry. Zero (default) means that the timed event is one-shot.
+     * @param mode Indicates how a periodic timed event handles missed expiries.
+     * @param slack Indicates how late each expiry may be handled.
+     * @return Returns the ID of the timed event, or `TIMER_ERR_DEAL_FAILED`
+     * on failure.
+     */
+    uint32_t RegisterAt(const TimerOverrunCallback& callback, std::chrono::steady_clock::time_point deadline,
+        std::chrono::nanoseconds period = std::chrono::nanoseconds::zero(), RepeatMode mode = RepeatMode::SKIP_MISSED,
+        std::chrono::nanoseconds slack = std::chrono::nanoseconds::zero());
+
+    /**
+     * @brief Dispatches the callbacks of expired timed events to a thread pool.
+     *
+     * By default, callbacks run one after another in the thread of the timer,
+     * so a slow callback delays all the other timed events. With a thread
+     * pool attached, the timer thread only queues the callbacks. Notice that
+     * a callback already queued still runs after its timed event is
+     * unregistered, and a periodic callback slower than its interval may
+     * run concurrently with itself.
+     *
+     * @param pool Indicates a started thread pool, which must outlive the
+     * timer or be detached first. `nullptr` means to run callbacks in the
+     * timer thread again.
+     */
+    void SetCallbackThreadPool(ThreadPool* pool);
+
+    /**
+     * @brief Obtains how late the callbacks ran compared with the expiry of
+     * their timed events, including the time queued in the thread pool, and
+     * how many times the timer thread woke up to handle expiries.
+     */
+    TimerLatencyStats GetLatencyStats() const;
+
+    /**
+     * @brief Clears the latency statistics.
+     */
+    void ResetLatencyStats();
+
 private:
     void MainLoop();
     void OnTimer(int timerFd);
     virtual uint32_t DoRegister(const TimerListCallback& callback, uint32_t interval, bool once, int &timerFd);
-    virtual void DoUnregister(uint32_t interval);
     void DoTimerListCallback(const TimerListCallback& callback, int timerFd);
-    uint32_t GetValidId(uint32_t timerId) const;
-    int GetTimerFd(uint32_t interval /* ms */);
-    void EraseUnusedTimerId(uint32_t interval, const std::vector<uint32_t>& unusedIds);
+    uint32_t AllocEntry();
+    void FreeEntry(uint32_t index);
+    bool LookupEntry(uint32_t timerId, uint32_t& index) const;
+    uint32_t MakeEntryId(uint32_t index) const;
+    void RemoveEntry(uint32_t index);
+    void ReleaseTimerFd(int timerFd);
+    uint32_t RegisterOnWheel(const std::shared_ptr<TimerOverrunCallback>& callback, uint64_t expiryNs,
+        uint64_t periodNs, RepeatMode mode, uint64_t slackNs);
+    void OnWheelTimer();
+    void ArmWheel();
+    void ReleaseWheelTimerFd();
+    void DispatchCallback(const std::shared_ptr<TimerOverrunCallback>& callback, uint64_t scheduledNs,
+        uint64_t overruns);
 
 private:
+    static constexpr uint32_t ENTRY_NIL = UINT32_MAX;
+
+    // Timed event of TimerEngine::PER_INTERVAL_FD. Entries live in a slot map, and the ID of an entry carries
+    // a generation, so a stale ID never matches a reused entry.
     struct TimerEntry {
-        uint32_t       timerId;  // Unique ID.
+        uint32_t       generation = 1;
+        bool           used = false;
+        bool           removed = false;  // Unregistered while its callback runs, see TimerFdEntries.
+        int            timerFd = -1;
+        uint64_t       round = 0;  // TimerFdEntries::round when registered.
+        std::shared_ptr<TimerOverrunCallback> callback;
+        uint32_t       prev = ENTRY_NIL;
+        uint32_t       next = ENTRY_NIL;  // Also links the free entries.
+    };
+
+    // Entries sharing one timerfd, all periodic ones of an interval or a single one-shot one.
+    struct TimerFdEntries {
         uint32_t       interval;  // million second
-        TimerCallback  callback;
         bool           once;
-        int            timerFd;
+        uint64_t       startNs;  // When the timerfd was armed, CLOCK_MONOTONIC.
+        uint32_t       head;
+        uint32_t       tail;
+        uint32_t       count;
+        uint64_t       round;  // Number of expiries handled. Entries registered during one are skipped by it.
+        // Entry whose callback OnTimer() is running without holding mutex_. It is only marked as removed when
+        // unregistered, and OnTimer() frees it, so that the walk over the list can go on.
+        uint32_t       dispatching;
     };
 
-    using TimerEntryPtr = std::shared_ptr<TimerEntry>;
-    using TimerEntryList = std::list<TimerEntryPtr>;
-
-    std::map<uint32_t, TimerEntryList> intervalToTimers_;  // interval to TimerEntryList
-    std::map<uint32_t, TimerEntryPtr> timerToEntries_;  // timer_id to TimerEntry
+    std::vector<TimerEntry> entries_;
+    uint32_t freeEntry_;
+    std::unordered_map<int, TimerFdEntries> timerFdEntries_;  // timer_fd to its entries
+    std::unordered_map<uint32_t, int> intervalToTimerFd_;  // interval to the timer_fd of its periodic entries
 
     std::string name_;
     int timeoutMs_;
     std::thread thread_;
     EventReactor *reactor_;
-    std::map<uint32_t, uint32_t> timers_;  // timer_fd to interval
-    std::mutex mutex_;
+
+    TimerEngine engine_;
+    // Keeps all the timed events of TimerEngine::TIMING_WHEEL, and the ones registered by duration or deadline
+    // of TimerEngine::PER_INTERVAL_FD, in which case it is created on first use.
+    std::unique_ptr<TimingWheel> wheel_;
+    int wheelTimerFd_;
+    uint64_t wheelDeadlineNs_;  // Deadline the timerfd is armed with, 0 if disarmed.
+    std::vector<ExpiredTimer> expired_;  // Only touched by the timer thread.
+    InnerMutex mutex_ INNER_MUTEX_NAME("Timer");
+
+    std::atomic<ThreadPool*> pool_;
+    struct LatencyCounters {
+        std::atomic<uint64_t> callbacks {0};
+        std::atomic<uint64_t> wakeups {0};
+        std::atomic<uint64_t> totalLatencyNs {0};
+        std::atomic<uint64_t> maxLatencyNs {0};
+        std::atomic<uint64_t> histogram[TIMER_LATENCY_HISTOGRAM_BUCKETS] {};
+    };
+    // Shared with the queued tasks, which may run after the timer is destroyed.
+    std::shared_ptr<LatencyCounters> latency_;
 };
 
 } // namespace Utils
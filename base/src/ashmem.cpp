@@ -15,12 +15,14 @@
 
 #include "ashmem.h"
 
+#include <atomic>
 #include <fcntl.h>
 #include <pthread.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include "map_options.h"
 #include "securec.h"
 #include "utils_log.h"
 
@@ -137,7 +139,8 @@ int AshmemGetSize(int fd)
     return TEMP_FAILURE_RETRY(ioctl(fd, ASHMEM_GET_SIZE, NULL));
 }
 
-Ashmem::Ashmem(int fd, int32_t size) : memoryFd_(fd), memorySize_(size), flag_(0), startAddr_(nullptr)
+Ashmem::Ashmem(int fd, int32_t size)
+    : memoryFd_(fd), memorySize_(size), flag_(0), startAddr_(nullptr), grantedOptions_(0)
 {
 }
 
@@ -192,6 +195,7 @@ void Ashmem::CloseAshmem()
     memorySize_ = 0;
     flag_ = 0;
     startAddr_ = nullptr;
+    grantedOptions_ = 0;
 }
 
 #ifdef UTILS_CXX_RUST
@@ -200,14 +204,61 @@ bool Ashmem::MapAshmem(int mapType) const
 bool Ashmem::MapAshmem(int mapType)
 #endif
 {
-    void *startAddr = ::mmap(nullptr, memorySize_, mapType, MAP_SHARED, memoryFd_, 0);
+    return MapAshmem(mapType, MAP_OPTION_NONE);
+}
+
+#ifdef UTILS_CXX_RUST
+bool Ashmem::MapAshmem(int mapType, int options) const
+#else
+bool Ashmem::MapAshmem(int mapType, int options)
+#endif
+{
+    unsigned int asked = static_cast<unsigned int>(options);
+    int mapFlags = MAP_SHARED;
+    if ((asked & MAP_OPTION_POPULATE) != 0) {
+        mapFlags |= MAP_POPULATE;
+    }
+    void *startAddr = ::mmap(nullptr, memorySize_, mapType, mapFlags, memoryFd_, 0);
     if (startAddr == MAP_FAILED) {
         UTILS_LOGE("Failed to exec mmap, errno = %{public}d", errno);
         return false;
     }
 
+    int granted = 0;
+    size_t len = static_cast<size_t>(memorySize_);
+    // Huge pages are only confirmed once the pages are faulted in.
+    bool advised = false;
+    if ((asked & MAP_OPTION_HUGE_PAGE) != 0) {
+        advised = Utils::AdviseHugePage(startAddr, len);
+        if (!advised) {
+            UTILS_LOGW("%{public}s: Huge pages not granted, errno = %{public}d", __func__, errno);
+        }
+    }
+    if ((asked & MAP_OPTION_LOCKED) != 0) {
+        if (Utils::LockMapping(startAddr, len)) {
+            granted |= MAP_OPTION_LOCKED;
+        } else {
+            UTILS_LOGW("%{public}s: Locking not granted, errno = %{public}d", __func__, errno);
+        }
+    }
+    if ((asked & MAP_OPTION_POPULATE) != 0) {
+        if (Utils::CheckPopulated(startAddr, len)) {
+            granted |= MAP_OPTION_POPULATE;
+        } else {
+            UTILS_LOGW("%{public}s: Population not granted, errno = %{public}d", __func__, errno);
+        }
+    }
+    if (advised) {
+        if (Utils::CheckHugePaged(startAddr, len)) {
+            granted |= MAP_OPTION_HUGE_PAGE;
+        } else {
+            UTILS_LOGW("%{public}s: Huge pages advised but not in use", __func__);
+        }
+    }
+
     startAddr_ = startAddr;
     flag_ = mapType;
+    grantedOptions_ = granted;
 
     return true;
 }
@@ -241,6 +292,7 @@ void Ashmem::UnmapAshmem()
         startAddr_ = nullptr;
     }
     flag_ = 0;
+    grantedOptions_ = 0;
 }
 
 #ifdef UTILS_CXX_RUST
@@ -282,6 +334,46 @@ const void *Ashmem::ReadFromAshmem(int32_t size, int32_t offset)
     return reinterpret_cast<const char *>(startAddr_) + offset;
 }
 
+AshmemWriteView Ashmem::GetWriteView(int32_t size, int32_t offset) const
+{
+    AshmemWriteView view;
+    if (!CheckValid(size, offset, PROT_WRITE)) {
+        UTILS_LOGE("%{public}s: invalid input or not map", __func__);
+        return view;
+    }
+
+    view.data = reinterpret_cast<char *>(startAddr_) + offset;
+    view.size = size;
+    view.offset = offset;
+    return view;
+}
+
+bool Ashmem::CommitWrite(const AshmemWriteView &view, int32_t written) const
+{
+    if (!view.IsValid() || written < 0 || written > view.size || startAddr_ == nullptr ||
+        view.data != reinterpret_cast<char *>(startAddr_) + view.offset) {
+        UTILS_LOGE("%{public}s: invalid view or not map, written = %{public}d", __func__, written);
+        return false;
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
+}
+
+AshmemReadView Ashmem::GetReadView(int32_t size, int32_t offset) const
+{
+    AshmemReadView view;
+    if (!CheckValid(size, offset, PROT_READ)) {
+        UTILS_LOGE("%{public}s: invalid input or not map", __func__);
+        return view;
+    }
+
+    view.data = reinterpret_cast<const char *>(startAddr_) + offset;
+    view.size = size;
+    view.offset = offset;
+    return view;
+}
+
 bool Ashmem::CheckValid(int32_t size, int32_t offset, int cmd) const
 {
     if (startAddr_ == nullptr) {
@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ashmem_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <iterator>
+#include <unistd.h>
+#include "utils_log.h"
+
+namespace OHOS {
+namespace {
+std::atomic<uint32_t> g_poolSeq(1);
+
+// The pid tells the pools of live processes apart, the sequence those of one process. Never 0.
+uint64_t NewPoolId()
+{
+    return (static_cast<uint64_t>(getpid()) << 32) | g_poolSeq.fetch_add(1); // 32: bits of the sequence
+}
+
+int32_t RoundToAlign(int32_t size)
+{
+    int32_t align = AshmemPool::BLOCK_ALIGN;
+    if (size > INT32_MAX - align) {
+        return -1;
+    }
+    return (size + align - 1) / align * align;
+}
+} // namespace
+
+bool AshmemBlock::Marshalling(Parcel &parcel) const
+{
+    return parcel.WriteUint64(poolId) && parcel.WriteInt32(regionId) && parcel.WriteInt32(offset) &&
+        parcel.WriteInt32(length);
+}
+
+bool AshmemBlock::Unmarshalling(Parcel &parcel, AshmemBlock &block)
+{
+    AshmemBlock res;
+    if (!parcel.ReadUint64(res.poolId) || !parcel.ReadInt32(res.regionId) || !parcel.ReadInt32(res.offset) ||
+        !parcel.ReadInt32(res.length)) {
+        UTILS_LOGE("%{public}s: Failed to read the block", __func__);
+        return false;
+    }
+    block = res;
+    return true;
+}
+
+AshmemPool::AshmemPool(const char *name, int32_t regionSize, int32_t blockSize, int32_t maxRegions)
+    : name_(name == nullptr ? "" : name), poolId_(NewPoolId()), regionSize_(RoundToAlign(regionSize)),
+    blockSize_(blockSize > 0 ? RoundToAlign(blockSize) : 0), maxRegions_(maxRegions)
+{
+    if (regionSize_ < blockSize_) {
+        regionSize_ = blockSize_;
+    }
+}
+
+AshmemPool::~AshmemPool() = default;
+
+AshmemPool::Region *AshmemPool::FindRegion(int32_t id)
+{
+    for (std::unique_ptr<Region> &region : regions_) {
+        if (region->id == id) {
+            return region.get();
+        }
+    }
+    return nullptr;
+}
+
+AshmemPool::Region *AshmemPool::AddRegion()
+{
+    if (static_cast<int32_t>(regions_.size()) >= maxRegions_ || regionSize_ <= 0 || blockSize_ < 0) {
+        UTILS_LOGE("%{public}s: No more regions, num = %{public}zu", __func__, regions_.size());
+        return nullptr;
+    }
+
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem(name_.c_str(), regionSize_);
+    if (ashmem == nullptr || !ashmem->MapReadAndWriteAshmem()) {
+        UTILS_LOGE("%{public}s: Failed to create or map a region, size = %{public}d", __func__, regionSize_);
+        return nullptr;
+    }
+
+    std::unique_ptr<Region> region = std::make_unique<Region>();
+    region->base = ashmem->GetWriteView(regionSize_, 0).data;
+    region->ashmem = ashmem;
+    region->id = nextId_++;
+    region->size = regionSize_;
+    if (blockSize_ > 0) {
+        int32_t num = regionSize_ / blockSize_;
+        region->allocated.assign(num, false);
+        region->freeBlocks.reserve(num);
+        // Pushed backwards, so that blocks are allocated from the start of the region.
+        for (int32_t index = num - 1; index >= 0; index--) {
+            region->freeBlocks.push_back(index * blockSize_);
+        }
+    } else {
+        region->freeRanges.emplace(0, regionSize_);
+    }
+    regions_.push_back(std::move(region));
+    return regions_.back().get();
+}
+
+bool AshmemPool::AllocateFrom(Region &region, int32_t size, int32_t &offset)
+{
+    if (blockSize_ > 0) {
+        if (region.freeBlocks.empty()) {
+            return false;
+        }
+        offset = region.freeBlocks.back();
+        region.freeBlocks.pop_back();
+        region.allocated[offset / blockSize_] = true;
+        region.used += blockSize_;
+        return true;
+    }
+
+    for (auto it = region.freeRanges.begin(); it != region.freeRanges.end(); ++it) {
+        if (it->second < size) {
+            continue;
+        }
+        offset = it->first;
+        int32_t rest = it->second - size;
+        region.freeRanges.erase(it);
+        if (rest > 0) {
+            region.freeRanges.emplace(offset + size, rest);
+        }
+        region.usedRanges.emplace(offset, size);
+        region.used += size;
+        return true;
+    }
+    return false;
+}
+
+bool AshmemPool::Allocate(int32_t size, AshmemBlock &block)
+{
+    int32_t length = RoundToAlign(size);
+    if (size <= 0 || length < 0 || length > (blockSize_ > 0 ? blockSize_ : regionSize_)) {
+        UTILS_LOGE("%{public}s: Size is invalid, size = %{public}d", __func__, size);
+        return false;
+    }
+    if (blockSize_ > 0) {
+        length = blockSize_;
+    }
+
+    std::lock_guard<Utils::InnerMutex> lock(mutex_);
+    int32_t offset = 0;
+    Region *found = nullptr;
+    for (std::unique_ptr<Region> &region : regions_) {
+        if (AllocateFrom(*region, length, offset)) {
+            found = region.get();
+            break;
+        }
+    }
+    if (found == nullptr) {
+        found = AddRegion();
+        if (found == nullptr || !AllocateFrom(*found, length, offset)) {
+            return false;
+        }
+    }
+
+    used_ += length;
+    block.poolId = poolId_;
+    block.regionId = found->id;
+    block.offset = offset;
+    block.length = size;
+    block.data = found->base + offset;
+    return true;
+}
+
+bool AshmemPool::FreeTo(Region &region, int32_t offset)
+{
+    if (blockSize_ > 0) {
+        int32_t index = offset / blockSize_;
+        if (offset % blockSize_ != 0 || index >= static_cast<int32_t>(region.allocated.size()) ||
+            !region.allocated[index]) {
+            return false;
+        }
+        region.allocated[index] = false;
+        region.freeBlocks.push_back(offset);
+        region.used -= blockSize_;
+        used_ -= blockSize_;
+        return true;
+    }
+
+    auto used = region.usedRanges.find(offset);
+    if (used == region.usedRanges.end()) {
+        return false;
+    }
+    int32_t start = offset;
+    int32_t end = offset + used->second;
+    region.used -= used->second;
+    used_ -= used->second;
+    region.usedRanges.erase(used);
+
+    // Merge with the free neighbours.
+    auto next = region.freeRanges.lower_bound(start);
+    if (next != region.freeRanges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == start) {
+            start = prev->first;
+            region.freeRanges.erase(prev);
+        }
+    }
+    if (next != region.freeRanges.end() && next->first == end) {
+        end += next->second;
+        region.freeRanges.erase(next);
+    }
+    region.freeRanges.emplace(start, end - start);
+    return true;
+}
+
+bool AshmemPool::Free(const AshmemBlock &block)
+{
+    if (!block.IsValid()) {
+        return false;
+    }
+
+    std::lock_guard<Utils::InnerMutex> lock(mutex_);
+    Region *region = (block.poolId == poolId_) ? FindRegion(block.regionId) : nullptr;
+    if (region != nullptr && block.offset < regionSize_ && FreeTo(*region, block.offset)) {
+        return true;
+    }
+    UTILS_LOGE("%{public}s: Not a block allocated, region = %{public}d, offset = %{public}d", __func__,
+               block.regionId, block.offset);
+    return false;
+}
+
+int32_t AshmemPool::Trim()
+{
+    std::lock_guard<Utils::InnerMutex> lock(mutex_);
+    size_t num = regions_.size();
+    regions_.erase(std::remove_if(regions_.begin(), regions_.end(),
+        [](const std::unique_ptr<Region> &region) { return region->used == 0; }),
+        regions_.end());
+    return static_cast<int32_t>(num - regions_.size());
+}
+
+sptr<Ashmem> AshmemPool::GetRegion(int32_t id)
+{
+    std::lock_guard<Utils::InnerMutex> lock(mutex_);
+    Region *region = FindRegion(id);
+    return (region == nullptr) ? nullptr : region->ashmem;
+}
+
+bool AshmemPool::AttachRegion(uint64_t poolId, int32_t id, const sptr<Ashmem> &ashmem)
+{
+    int32_t size = (ashmem == nullptr) ? 0 : ashmem->GetAshmemSize();
+    if (poolId == 0 || poolId == poolId_ || id < 0 || size <= 0) {
+        UTILS_LOGE("%{public}s: Invalid region, id = %{public}d", __func__, id);
+        return false;
+    }
+
+    std::lock_guard<Utils::InnerMutex> lock(mutex_);
+    if (attached_.count({poolId, id}) != 0) {
+        UTILS_LOGE("%{public}s: Already attached, id = %{public}d", __func__, id);
+        return false;
+    }
+    if (!ashmem->GetReadView(size, 0).IsValid() && !ashmem->MapReadAndWriteAshmem()) {
+        UTILS_LOGE("%{public}s: Failed to map the region, id = %{public}d", __func__, id);
+        return false;
+    }
+    char *base = ashmem->GetWriteView(size, 0).data;
+    if (base == nullptr) {
+        UTILS_LOGE("%{public}s: Region mapped read-only, id = %{public}d", __func__, id);
+        return false;
+    }
+
+    std::unique_ptr<Region> region = std::make_unique<Region>();
+    region->ashmem = ashmem;
+    region->base = base;
+    region->id = id;
+    region->size = size;
+    attached_.emplace(std::make_pair(poolId, id), std::move(region));
+    return true;
+}
+
+bool AshmemPool::DetachRegion(uint64_t poolId, int32_t id)
+{
+    std::lock_guard<Utils::InnerMutex> lock(mutex_);
+    return attached_.erase({poolId, id}) != 0;
+}
+
+bool AshmemPool::Resolve(AshmemBlock &block)
+{
+    if (!block.IsValid()) {
+        return false;
+    }
+
+    std::lock_guard<Utils::InnerMutex> lock(mutex_);
+    Region *region = nullptr;
+    if (block.poolId == poolId_) {
+        region = FindRegion(block.regionId);
+    } else {
+        auto it = attached_.find({block.poolId, block.regionId});
+        region = (it == attached_.end()) ? nullptr : it->second.get();
+    }
+    if (region == nullptr || block.offset > region->size || block.length > region->size - block.offset) {
+        UTILS_LOGE("%{public}s: Unknown block, region = %{public}d, offset = %{public}d", __func__,
+                   block.regionId, block.offset);
+        return false;
+    }
+    block.data = region->base + block.offset;
+    return true;
+}
+
+int32_t AshmemPool::GetRegionNum()
+{
+    std::lock_guard<Utils::InnerMutex> lock(mutex_);
+    return static_cast<int32_t>(regions_.size() + attached_.size());
+}
+
+int32_t AshmemPool::GetUsedSize()
+{
+    std::lock_guard<Utils::InnerMutex> lock(mutex_);
+    return used_;
+}
+} // namespace OHOS
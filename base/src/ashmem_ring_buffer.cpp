@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ashmem_ring_buffer.h"
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "utils_log.h"
+
+namespace OHOS {
+namespace {
+constexpr uint32_t RING_MAGIC = 0x52494E47; // "RING"
+constexpr uint32_t RING_VERSION = 1;
+constexpr uint32_t FLAG_MULTI_PRODUCER = 1;
+constexpr size_t CACHE_LINE_SIZE = 64;
+constexpr uint32_t COMMIT_BIT = 1U << 31;
+constexpr uint32_t PAD_BIT = 1U << 30; // the rest of the area up to its end is skipped
+constexpr uint32_t SIZE_MASK = PAD_BIT - 1;
+constexpr uint32_t RECORD_ALIGN = 8;
+
+uint32_t RecordLength(uint32_t size)
+{
+    return (AshmemRingBuffer::RECORD_HEADER_SIZE + size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+}
+
+bool IsValidCapacity(int64_t capacity)
+{
+    return capacity >= AshmemRingBuffer::MIN_CAPACITY && capacity <= (INT32_MAX / 2 + 1) &&
+        (capacity & (capacity - 1)) == 0;
+}
+
+// The region is shared, so the futex is not private to the process.
+void FutexWait(uint32_t *addr, uint32_t val, const struct timespec *timeout)
+{
+    syscall(SYS_futex, addr, FUTEX_WAIT, val, timeout, nullptr, 0);
+}
+
+void FutexWake(uint32_t *addr, int count)
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE, count, nullptr, nullptr, 0);
+}
+
+// Waits until `ready` holds. `waiting` is raised before checking it again, so
+// that a peer making it hold after the check bumps `seq` and ends the wait.
+bool Wait(uint32_t *seq, uint32_t *waiting, int64_t timeoutMs, const std::function<bool()> &ready)
+{
+    if (timeoutMs == 0) {
+        return false;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (true) {
+        __atomic_store_n(waiting, 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        uint32_t cur = __atomic_load_n(seq, __ATOMIC_SEQ_CST);
+        if (ready()) {
+            return true;
+        }
+        if (timeoutMs < 0) {
+            FutexWait(seq, cur, nullptr);
+            continue;
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0) {
+            return false;
+        }
+        struct timespec timeout = {
+            static_cast<time_t>(remaining / std::nano::den),
+            static_cast<long>(remaining % std::nano::den),
+        };
+        FutexWait(seq, cur, &timeout);
+    }
+}
+
+// Called after making the condition of a waiter hold, only makes a system call if there is one.
+void Wake(uint32_t *seq, uint32_t *waiting, int count)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(waiting, __ATOMIC_RELAXED) == 0 || __atomic_exchange_n(waiting, 0, __ATOMIC_SEQ_CST) == 0) {
+        return;
+    }
+    __atomic_add_fetch(seq, 1, __ATOMIC_SEQ_CST);
+    FutexWake(seq, count);
+}
+} // namespace
+
+/*
+ * Layout of the start of the region. Positions only grow, the index of one in
+ * the records area is the position modulo the capacity. Each group of fields
+ * written by a different side is on its own cache line.
+ */
+struct AshmemRingBuffer::Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t flags;
+    alignas(CACHE_LINE_SIZE) uint64_t tail; // end of the room reserved by producers
+    alignas(CACHE_LINE_SIZE) uint64_t head; // start of the next record to read
+    alignas(CACHE_LINE_SIZE) uint32_t dataSeq; // futex of the consumer waiting for a record
+    uint32_t consumerWaiting;
+    alignas(CACHE_LINE_SIZE) uint32_t roomSeq; // futex of the producers waiting for room
+    uint32_t producerWaiting;
+};
+
+sptr<AshmemRingBuffer> AshmemRingBuffer::Create(const char *name, int32_t capacity, bool multiProducer)
+{
+    if (!IsValidCapacity(capacity)) {
+        UTILS_LOGE("%{public}s: Capacity is invalid, capacity = %{public}d", __func__, capacity);
+        return nullptr;
+    }
+
+    int32_t size = static_cast<int32_t>(sizeof(Header)) + capacity;
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem(name, size);
+    if (ashmem == nullptr || !ashmem->MapReadAndWriteAshmem()) {
+        UTILS_LOGE("%{public}s: Failed to create or map the region, size = %{public}d", __func__, size);
+        return nullptr;
+    }
+
+    char *base = ashmem->GetWriteView(size, 0).data;
+    Header *header = reinterpret_cast<Header *>(base);
+    memset(base, 0, size);
+    header->version = RING_VERSION;
+    header->capacity = static_cast<uint32_t>(capacity);
+    header->flags = multiProducer ? FLAG_MULTI_PRODUCER : 0;
+    __atomic_store_n(&header->magic, RING_MAGIC, __ATOMIC_RELEASE);
+    return new AshmemRingBuffer(ashmem, base, header->capacity, multiProducer);
+}
+
+sptr<AshmemRingBuffer> AshmemRingBuffer::Attach(const sptr<Ashmem> &ashmem)
+{
+    if (ashmem == nullptr) {
+        return nullptr;
+    }
+    int32_t size = ashmem->GetAshmemSize();
+    if (size < static_cast<int32_t>(sizeof(Header))) {
+        UTILS_LOGE("%{public}s: Region is too small, size = %{public}d", __func__, size);
+        return nullptr;
+    }
+    // Mapped only if not mapped yet, mapping it again would leak the mapping in use.
+    if (!ashmem->GetReadView(size, 0).IsValid() && !ashmem->MapReadAndWriteAshmem()) {
+        UTILS_LOGE("%{public}s: Failed to map the region", __func__);
+        return nullptr;
+    }
+    char *base = ashmem->GetWriteView(size, 0).data;
+    if (base == nullptr) {
+        UTILS_LOGE("%{public}s: Region mapped read-only", __func__);
+        return nullptr;
+    }
+
+    Header *header = reinterpret_cast<Header *>(base);
+    // Validated once, the header may be changed by the peers afterwards.
+    bool valid = __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) == RING_MAGIC && header->version == RING_VERSION;
+    uint32_t capacity = header->capacity;
+    if (!valid || !IsValidCapacity(capacity) || sizeof(Header) + capacity > static_cast<size_t>(size)) {
+        UTILS_LOGE("%{public}s: Not a ring buffer, size = %{public}d", __func__, size);
+        return nullptr;
+    }
+    return new AshmemRingBuffer(ashmem, base, capacity, (header->flags & FLAG_MULTI_PRODUCER) != 0);
+}
+
+AshmemRingBuffer::AshmemRingBuffer(const sptr<Ashmem> &ashmem, char *base, uint32_t capacity, bool multiProducer)
+    : ashmem_(ashmem), header_(reinterpret_cast<Header *>(base)), records_(base + sizeof(Header)),
+    capacity_(capacity), multiProducer_(multiProducer),
+    cachedHead_(__atomic_load_n(&header_->head, __ATOMIC_ACQUIRE))
+{
+}
+
+AshmemRingBuffer::~AshmemRingBuffer() = default;
+
+bool AshmemRingBuffer::HasRoom(uint64_t tail, uint32_t length)
+{
+    // Acquired from the producer having read it, the room freed by the consumer is visible.
+    uint64_t head = cachedHead_.load(std::memory_order_acquire);
+    if (tail + length - head <= capacity_) {
+        return true;
+    }
+    // Only read the line of the consumer when the room last seen is used up.
+    head = __atomic_load_n(&header_->head, __ATOMIC_ACQUIRE);
+    cachedHead_.store(head, std::memory_order_release);
+    return tail + length - head <= capacity_;
+}
+
+bool AshmemRingBuffer::Reserve(uint32_t length, uint64_t &start, int64_t timeoutMs)
+{
+    uint64_t tail = __atomic_load_n(&header_->tail, __ATOMIC_RELAXED);
+    while (true) {
+        uint32_t index = static_cast<uint32_t>(tail & (capacity_ - 1));
+        // A record does not wrap around, the rest of the area is padded then.
+        uint32_t pad = (index + length > capacity_) ? capacity_ - index : 0;
+        if (!HasRoom(tail, pad + length)) {
+            bool ready = Wait(&header_->roomSeq, &header_->producerWaiting, timeoutMs, [this, &tail, length] {
+                tail = __atomic_load_n(&header_->tail, __ATOMIC_RELAXED);
+                uint32_t index = static_cast<uint32_t>(tail & (capacity_ - 1));
+                return HasRoom(tail, (index + length > capacity_) ? capacity_ - index + length : length);
+            });
+            if (!ready) {
+                return false;
+            }
+            continue;
+        }
+        if (multiProducer_ &&
+            !__atomic_compare_exchange_n(&header_->tail, &tail, tail + pad + length, true, __ATOMIC_RELAXED,
+                                         __ATOMIC_RELAXED)) {
+            continue;
+        }
+        if (pad > 0) {
+            __atomic_store_n(reinterpret_cast<uint32_t *>(records_ + index), PAD_BIT | COMMIT_BIT, __ATOMIC_RELEASE);
+        }
+        start = tail + pad;
+        return true;
+    }
+}
+
+bool AshmemRingBuffer::Write(const void *data, uint32_t size, int64_t timeoutMs)
+{
+    if ((data == nullptr && size != 0) || size > GetMaxRecordSize()) {
+        UTILS_LOGE("%{public}s: Size is invalid, size = %{public}u", __func__, size);
+        return false;
+    }
+
+    uint32_t length = RecordLength(size);
+    uint64_t start = 0;
+    if (!Reserve(length, start, timeoutMs)) {
+        return false;
+    }
+    char *record = records_ + (start & (capacity_ - 1));
+    if (size != 0) {
+        memcpy(record + RECORD_HEADER_SIZE, data, size);
+    }
+    __atomic_store_n(reinterpret_cast<uint32_t *>(record), size | COMMIT_BIT, __ATOMIC_RELEASE);
+    if (!multiProducer_) {
+        // The only producer publishes the tail once the record is written.
+        __atomic_store_n(&header_->tail, start + length, __ATOMIC_RELEASE);
+    }
+    Wake(&header_->dataSeq, &header_->consumerWaiting, 1);
+    return true;
+}
+
+bool AshmemRingBuffer::HasRecord(uint64_t head) const
+{
+    if (__atomic_load_n(&header_->tail, __ATOMIC_ACQUIRE) <= head) {
+        return false;
+    }
+    const uint32_t *word = reinterpret_cast<const uint32_t *>(records_ + (head & (capacity_ - 1)));
+    return (__atomic_load_n(word, __ATOMIC_ACQUIRE) & COMMIT_BIT) != 0;
+}
+
+void AshmemRingBuffer::Release(uint64_t end, uint32_t length)
+{
+    if (multiProducer_) {
+        // Producers reserve room before writing the header of their records, clear it so that no stale header
+        // is taken as committed.
+        memset(records_ + ((end - length) & (capacity_ - 1)), 0, length);
+    }
+    __atomic_store_n(&header_->head, end, __ATOMIC_RELEASE);
+    Wake(&header_->roomSeq, &header_->producerWaiting, INT_MAX);
+}
+
+bool AshmemRingBuffer::Peek(const void *&data, uint32_t &size, int64_t timeoutMs)
+{
+    uint64_t head = __atomic_load_n(&header_->head, __ATOMIC_RELAXED);
+    while (true) {
+        if (!HasRecord(head) &&
+            !Wait(&header_->dataSeq, &header_->consumerWaiting, timeoutMs, [this, head] { return HasRecord(head); })) {
+            return false;
+        }
+
+        uint32_t index = static_cast<uint32_t>(head & (capacity_ - 1));
+        uint32_t word = __atomic_load_n(reinterpret_cast<const uint32_t *>(records_ + index), __ATOMIC_ACQUIRE);
+        uint64_t tail = __atomic_load_n(&header_->tail, __ATOMIC_ACQUIRE);
+        uint32_t length = (word & PAD_BIT) != 0 ? capacity_ - index : RecordLength(word & SIZE_MASK);
+        if (((word & PAD_BIT) == 0 && (word & SIZE_MASK) > GetMaxRecordSize()) || index + length > capacity_ ||
+            head + length > tail) {
+            UTILS_LOGE("%{public}s: Record is corrupted, header = %{public}u", __func__, word);
+            return false;
+        }
+        if ((word & PAD_BIT) != 0) {
+            head += length;
+            Release(head, length);
+            continue;
+        }
+
+        data = records_ + index + RECORD_HEADER_SIZE;
+        size = word & SIZE_MASK;
+        peeked_ = head + length;
+        return true;
+    }
+}
+
+void AshmemRingBuffer::Pop()
+{
+    if (peeked_ == 0) {
+        return;
+    }
+    uint64_t head = __atomic_load_n(&header_->head, __ATOMIC_RELAXED);
+    Release(peeked_, static_cast<uint32_t>(peeked_ - head));
+    peeked_ = 0;
+}
+
+bool AshmemRingBuffer::Read(void *buffer, uint32_t bufferSize, uint32_t &size, int64_t timeoutMs)
+{
+    const void *data = nullptr;
+    if (!Peek(data, size, timeoutMs)) {
+        return false;
+    }
+    if (size > bufferSize || (buffer == nullptr && size != 0)) {
+        peeked_ = 0;
+        return false;
+    }
+    if (size != 0) {
+        memcpy(buffer, data, size);
+    }
+    Pop();
+    return true;
+}
+
+uint32_t AshmemRingBuffer::GetUsedSize() const
+{
+    uint64_t head = __atomic_load_n(&header_->head, __ATOMIC_ACQUIRE);
+    uint64_t tail = __atomic_load_n(&header_->tail, __ATOMIC_ACQUIRE);
+    return tail > head ? static_cast<uint32_t>(tail - head) : 0;
+}
+} // namespace OHOS
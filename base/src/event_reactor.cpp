@@ -60,7 +60,7 @@ void EventReactor::CleanUp()
 {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     for (auto &itor : timerEventHandlers_) {
-        itor->Uninitialize();
+        itor.second->Uninitialize();
     }
 }
 
@@ -104,21 +104,44 @@ uint32_t EventReactor::ScheduleTimer(const TimerCallback& cb, uint32_t interval,
     }
 
     timerFd = handler->GetHandle();
-    timerEventHandlers_.push_back(handler);
+    timerEventHandlers_[timerFd] = handler;
     return TIMER_ERR_OK;
 }
 
+uint32_t EventReactor::ScheduleDeadlineTimer(const TimerCallback& cb, int& timerFd)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    std::shared_ptr<TimerEventHandler> handler = std::make_shared<TimerEventHandler>(this);
+    handler->SetTimerCallback(cb);
+    uint32_t ret = handler->Initialize();
+    if (ret != TIMER_ERR_OK) {
+        UTILS_LOGD("ScheduleDeadlineTimer initialize failed");
+        return ret;
+    }
+
+    timerFd = handler->GetHandle();
+    timerEventHandlers_[timerFd] = handler;
+    return TIMER_ERR_OK;
+}
+
+uint32_t EventReactor::SetTimerDeadline(int timerFd, const timespec& deadline)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    auto itor = timerEventHandlers_.find(timerFd);
+    if (itor == timerEventHandlers_.end()) {
+        return TIMER_ERR_INVALID_VALUE;
+    }
+    return itor->second->SetDeadline(deadline);
+}
+
 void EventReactor::CancelTimer(int timerFd)
 {
     UTILS_LOGD("Cancel timer, timerFd: %{public}d.", timerFd);
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    auto itor = timerEventHandlers_.begin();
-    for (; itor != timerEventHandlers_.end(); ++itor) {
-        if ((*itor)->GetHandle() == timerFd) {
-            (*itor)->Uninitialize();
-            timerEventHandlers_.erase(itor);
-            return;
-        }
+    auto itor = timerEventHandlers_.find(timerFd);
+    if (itor != timerEventHandlers_.end()) {
+        itor->second->Uninitialize();
+        timerEventHandlers_.erase(itor);
     }
 }
 
@@ -18,10 +18,11 @@
 
 #include <sys/types.h>
 #include <cstdint>
+#include <ctime>
 #include <memory>
 #include <mutex>
-#include <list>
 #include <functional>
+#include <unordered_map>
 
 namespace OHOS {
 namespace Utils {
@@ -68,6 +69,9 @@ public:
     void UpdateEventHandler(EventHandler* handler);
 
     uint32_t ScheduleTimer(const TimerCallback& cb, uint32_t interval /* ms */, int& timerFd, bool once);
+    // Creates a disarmed timer which fires once at the time passed to SetTimerDeadline().
+    uint32_t ScheduleDeadlineTimer(const TimerCallback& cb, int& timerFd);
+    uint32_t SetTimerDeadline(int timerFd, const timespec& deadline);
     void CancelTimer(int timerFd);
 
 private:
@@ -75,7 +79,7 @@ private:
     volatile bool switch_; // a switch to enable while-loop in RunLoop(). true: start, false: stop.
     std::unique_ptr<EventDemultiplexer> demultiplexer_;
     std::recursive_mutex mutex_;
-    std::list<std::shared_ptr<TimerEventHandler>> timerEventHandlers_;
+    std::unordered_map<int, std::shared_ptr<TimerEventHandler>> timerEventHandlers_; // keyed by timerfd
 };
 
 } // namespace Utils
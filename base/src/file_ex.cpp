@@ -18,7 +18,12 @@
 #include <unistd.h>
 #include <climits>
 #include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <sys/stat.h>
+#include "common_mapped_file_errors.h"
 #include "directory_ex.h"
+#include "mapped_file.h"
 #include "utils_log.h"
 
 using namespace std;
@@ -249,6 +254,47 @@ bool SaveStringToFd(int fd, const std::string& content)
     return true;
 }
 
+bool MapFileRegion(const string& filePath, sptr<Utils::MappedRegion>& region, Utils::MapAdvice advice)
+{
+    struct stat stb = {0};
+    if (stat(filePath.c_str(), &stb) != 0) {
+        UTILS_LOGD("get file size failed! filePath:%{private}s", filePath.c_str());
+        return false;
+    }
+
+    region = nullptr;
+    if (stb.st_size == 0) {
+        return true;
+    }
+
+    string path(filePath);
+    Utils::MappedFile file(path, Utils::MapMode::READ_ONLY);
+    file.Advise(advice);
+    if (file.Map() != Utils::MAPPED_FILE_ERR_OK) {
+        UTILS_LOGD("map file failed! filePath:%{private}s", filePath.c_str());
+        return false;
+    }
+    // The handle keeps the mapping once the file is closed.
+    region = file.Share();
+    return region != nullptr;
+}
+
+bool LoadRegionFromFile(const string& filePath, sptr<Utils::MappedRegion>& region)
+{
+    return MapFileRegion(filePath, region, Utils::MapAdvice::NORMAL);
+}
+
+bool LoadRegionFromFd(int fd, sptr<Utils::MappedRegion>& region)
+{
+    if (fd <= 0) {
+        UTILS_LOGD("invalid fd:%{public}d", fd);
+        return false;
+    }
+
+    // Reopens the file itself rather than its current name, which it may no longer have.
+    return LoadRegionFromFile("/proc/self/fd/" + std::to_string(fd), region);
+}
+
 bool LoadBufferFromNodeFile(const string& filePath, vector<char>& content)
 {
     string realPath;
@@ -348,70 +394,86 @@ bool FileExists(const string& fileName)
     return (access(fileName.c_str(), F_OK) == 0);
 }
 
-bool StringExistsInFile(const string& fileName, const string& subStr, bool caseSensitive /*= true*/)
+// Counts the non-overlapping occurrences of subStr in data, up to `limit`.
+int CountStrInData(const char* data, size_t size, const string& subStr, bool caseSensitive, int limit)
 {
-    if (subStr.empty()) {
-        UTILS_LOGD("String is empty");
-        return false;
-    }
-
-    string str;
-    if (!LoadStringFromFile(fileName, str)) {
-        UTILS_LOGD("File load fail, filePath:%{private}s", fileName.c_str());
-        return false;
-    }
-
+    size_t length = subStr.length();
+    int count = 0;
     if (caseSensitive) {
-        return (str.find(subStr) != string::npos);
+        const char* cur = data;
+        const char* end = data + size;
+        while (count < limit && static_cast<size_t>(end - cur) >= length) {
+            const char* found = static_cast<const char*>(memmem(cur, end - cur, subStr.data(), length));
+            if (found == nullptr) {
+                break;
+            }
+            count++;
+            cur = found + length;
+        }
+        return count;
     }
 
-    string strlower(str);
+    // Horspool search comparing lowercase characters, so that neither the data nor a copy of it is converted.
     string sublower(subStr);
-    transform(str.begin(), str.end(), strlower.begin(), ::tolower);
     transform(subStr.begin(), subStr.end(), sublower.begin(), ::tolower);
-    return (strlower.find(sublower) != string::npos);
+    size_t shift[UCHAR_MAX + 1];
+    std::fill(shift, shift + UCHAR_MAX + 1, length);
+    for (size_t i = 0; i + 1 < length; i++) {
+        unsigned char c = static_cast<unsigned char>(sublower[i]);
+        shift[c] = length - 1 - i;
+        shift[static_cast<unsigned char>(toupper(c))] = length - 1 - i;
+    }
+
+    size_t pos = 0;
+    while (count < limit && pos + length <= size) {
+        size_t i = length;
+        while (i > 0 && tolower(static_cast<unsigned char>(data[pos + i - 1])) ==
+            static_cast<unsigned char>(sublower[i - 1])) {
+            i--;
+        }
+        if (i == 0) {
+            count++;
+            pos += length;
+        } else {
+            pos += shift[static_cast<unsigned char>(data[pos + length - 1])];
+        }
+    }
+    return count;
 }
 
-int CountStrInStr(const string& str, const string& subStr)
+// Searches the file in place, or loads it if it cannot be mapped, e.g. for files of pseudo file systems.
+int CountStrInFileData(const string& fileName, const string& subStr, bool caseSensitive, int limit)
 {
-    if (subStr.empty()) {
-        UTILS_LOGD("subStr is empty");
-        return 0;
+    sptr<Utils::MappedRegion> region;
+    if (MapFileRegion(fileName, region, Utils::MapAdvice::SEQUENTIAL) && region != nullptr) {
+        return CountStrInData(region->Begin(), static_cast<size_t>(region->Size()), subStr, caseSensitive, limit);
     }
 
-    size_t position = 0;
-    int count = 0;
-    size_t length = subStr.length();
-    while ((position = str.find(subStr, position)) != string::npos) {
-        position += length;
-        count++;
+    string str;
+    if (!LoadStringFromFile(fileName, str)) {
+        UTILS_LOGD("File load fail, filePath:%{private}s", fileName.c_str());
+        return -1;
     }
-
-    return count;
+    return CountStrInData(str.data(), str.size(), subStr, caseSensitive, limit);
 }
 
-int CountStrInFile(const string& fileName, const string& subStr, bool caseSensitive /*= true*/)
+bool StringExistsInFile(const string& fileName, const string& subStr, bool caseSensitive /*= true*/)
 {
     if (subStr.empty()) {
         UTILS_LOGD("String is empty");
-        return -1;
+        return false;
     }
 
-    string str;
-    if (!LoadStringFromFile(fileName, str)) {
-        UTILS_LOGD("File load fail, filePath:%{private}s", fileName.c_str());
-        return -1;
-    }
+    return CountStrInFileData(fileName, subStr, caseSensitive, 1) > 0;
+}
 
-    // If case-insensitive, strings are converted to lowercase.
-    if (caseSensitive) {
-        return CountStrInStr(str, subStr);
+int CountStrInFile(const string& fileName, const string& subStr, bool caseSensitive /*= true*/)
+{
+    if (subStr.empty()) {
+        UTILS_LOGD("String is empty");
+        return -1;
     }
 
-    string strlower(str);
-    string sublower(subStr);
-    transform(str.begin(), str.end(), strlower.begin(), ::tolower);
-    transform(subStr.begin(), subStr.end(), sublower.begin(), ::tolower);
-    return CountStrInStr(strlower, sublower);
+    return CountStrInFileData(fileName, subStr, caseSensitive, INT_MAX);
 }
 }
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTILS_EVENT_BACKEND_H
+#define UTILS_EVENT_BACKEND_H
+
+#include <cstdint>
+#include <vector>
+#include "io_event_common.h"
+#include "errors.h"
+
+namespace OHOS {
+namespace Utils {
+
+// Demultiplexer waited on by IOEventReactor. Polling() runs on the loop thread, the other methods are called
+// with the reactor lock held.
+class IOEventBackend {
+public:
+    IOEventBackend() = default;
+    IOEventBackend(const IOEventBackend&) = delete;
+    IOEventBackend& operator=(const IOEventBackend&) = delete;
+    virtual ~IOEventBackend() {}
+
+    virtual ErrCode SetUp() = 0;
+    virtual void CleanUp() = 0;
+
+    virtual ErrCode Polling(int timeout, std::vector<std::pair<int, REventId>>&) = 0;
+
+    // Applies the interested events of the fd at once, EVENT_NONE stops watching it. A change of the fd still
+    // queued is dropped, it would otherwise be applied after this one.
+    virtual ErrCode ModifyEvents(int fd, REventId events) = 0;
+
+    // Queues a change of the interested events from `from` to `to`. Called on the loop thread only, the change
+    // takes effect at the latest with the next Polling().
+    virtual ErrCode QueueEvents(int fd, REventId from, REventId to) = 0;
+    virtual void ApplyChanges() = 0;
+
+    virtual void GetStats(IOEventSyscallStats& stats) const = 0;
+    virtual IOEventBackendType GetType() const = 0;
+};
+
+} // namespace Utils
+} // namespace OHOS
+#endif /* UTILS_EVENT_BACKEND_H */
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <sys/epoll.h>
 #include <unistd.h>
 #include "utils_log.h"
@@ -23,7 +24,8 @@
 namespace OHOS {
 namespace Utils {
 IOEventEpoll::IOEventEpoll()
-    : epollFd_(epoll_create1(EPOLL_CLOEXEC)), maxEvents_(EPOLL_MAX_EVENTS_INIT) {}
+    : epollFd_(epoll_create1(EPOLL_CLOEXEC)), maxEvents_(EPOLL_MAX_EVENTS_INIT), lowPolls_(0),
+    epollEvents_(EPOLL_MAX_EVENTS_INIT), waitCalls_(0), ctlCalls_(0), mergedChanges_(0) {}
 
 IOEventEpoll::~IOEventEpoll()
 {
@@ -58,6 +60,7 @@ bool IOEventEpoll::OperateEpoll(int op, int fd, EPEventId epollEvents)
     event.events = epollEvents;
     event.data.fd = fd;
 
+    ctlCalls_.fetch_add(1, std::memory_order_relaxed);
     if (epoll_ctl(epollFd_, op, fd, &event) != 0) {
         UTILS_LOGE("%{public}s: Operate on epoll failed, %{public}s. epoll_fd: %{public}d , operation: %{public}d, \
                    target fd: %{public}d", __FUNCTION__, strerror(errno), epollFd_, op, fd);
@@ -66,10 +69,10 @@ bool IOEventEpoll::OperateEpoll(int op, int fd, EPEventId epollEvents)
 
     switch (op) {
         case EPOLL_CTL_ADD:
-            interestFds_.insert(fd);
+            SetInterested(fd, true);
             break;
         case EPOLL_CTL_DEL:
-            interestFds_.erase(fd);
+            SetInterested(fd, false);
             break;
         default:
             break;
@@ -77,6 +80,38 @@ bool IOEventEpoll::OperateEpoll(int op, int fd, EPEventId epollEvents)
     return true;
 }
 
+bool IOEventEpoll::TestBit(const std::vector<uint64_t>& bits, int fd)
+{
+    size_t word = static_cast<size_t>(fd) / 64; // 64: bits per word
+    return (word < bits.size()) && ((bits[word] >> (static_cast<size_t>(fd) % 64)) & 1u);
+}
+
+void IOEventEpoll::SetBit(std::vector<uint64_t>& bits, int fd, bool value)
+{
+    size_t word = static_cast<size_t>(fd) / 64; // 64: bits per word
+    if (word >= bits.size()) {
+        if (!value) {
+            return;
+        }
+        bits.resize(word + 1);
+    }
+    uint64_t bit = 1ULL << (static_cast<size_t>(fd) % 64);
+    bits[word] = value ? (bits[word] | bit) : (bits[word] & ~bit);
+}
+
+bool IOEventEpoll::IsInterested(int fd) const
+{
+    return TestBit(interestBits_, fd);
+}
+
+void IOEventEpoll::SetInterested(int fd, bool interested)
+{
+    SetBit(interestBits_, fd, interested);
+    if (!interested) {
+        SetBit(exclusiveBits_, fd, false);
+    }
+}
+
 ErrCode IOEventEpoll::ModifyEvents(int fd, REventId events)
 {
     if (fd == -1) {
@@ -84,10 +119,28 @@ ErrCode IOEventEpoll::ModifyEvents(int fd, REventId events)
         return EVENT_SYS_ERR_BADF;
     }
 
+    auto itor = std::find_if(pendingChanges_.begin(), pendingChanges_.end(),
+        [fd](const PendingChange& change) { return change.fd == fd; });
+    if (itor != pendingChanges_.end()) {
+        pendingChanges_.erase(itor);
+        mergedChanges_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ApplyEvents(fd, events);
+}
+
+ErrCode IOEventEpoll::ApplyEvents(int fd, REventId events)
+{
+    bool exclusive = (events & Events::EVENT_EXCLUSIVE) != 0;
     int op = EPOLL_CTL_ADD;
-    if (interestFds_.find(fd) != interestFds_.end()) {
+    if (IsInterested(fd)) {
         if (events == Events::EVENT_NONE) {
             op = EPOLL_CTL_DEL;
+        } else if (exclusive || TestBit(exclusiveBits_, fd)) {
+            // EPOLL_CTL_MOD refuses fds added with EPOLLEXCLUSIVE, and EPOLLEXCLUSIVE itself.
+            if (!OperateEpoll(EPOLL_CTL_DEL, fd, 0)) {
+                UTILS_LOGE("%{public}s: Modify events failed.", __FUNCTION__);
+                return EVENT_SYS_ERR_FAILED;
+            }
         } else {
             op = EPOLL_CTL_MOD;
         }
@@ -97,28 +150,99 @@ ErrCode IOEventEpoll::ModifyEvents(int fd, REventId events)
         UTILS_LOGE("%{public}s: Modify events failed.", __FUNCTION__);
         return EVENT_SYS_ERR_FAILED;
     }
+    if (op == EPOLL_CTL_ADD) {
+        SetBit(exclusiveBits_, fd, exclusive);
+    }
     return EVENT_SYS_ERR_OK;
 }
 
-ErrCode IOEventEpoll::Polling(int timeout /* ms */, std::vector<std::pair<int, REventId>>& res)
+ErrCode IOEventEpoll::QueueEvents(int fd, REventId from, REventId to)
 {
-    struct epoll_event epollEvents[maxEvents_];
-    int nfds = epoll_wait(epollFd_, &epollEvents[0], maxEvents_, timeout);
-    if (nfds == 0) {
-        return EVENT_SYS_ERR_NOEVENT;
+    if (fd == -1) {
+        UTILS_LOGE("%{public}s: Failed, bad fd.", __FUNCTION__);
+        return EVENT_SYS_ERR_BADF;
     }
+
+    // Batches are short, the latest changes are the likeliest to be changed again.
+    for (auto itor = pendingChanges_.rbegin(); itor != pendingChanges_.rend(); ++itor) {
+        if (itor->fd == fd) {
+            itor->to = to;
+            mergedChanges_.fetch_add(1, std::memory_order_relaxed);
+            return EVENT_SYS_ERR_OK;
+        }
+    }
+    pendingChanges_.push_back({fd, from, to});
+    return EVENT_SYS_ERR_OK;
+}
+
+void IOEventEpoll::ApplyChanges()
+{
+    for (const PendingChange& change : pendingChanges_) {
+        if (change.from == change.to && (change.to != Events::EVENT_NONE || !IsInterested(change.fd))) {
+            mergedChanges_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (ApplyEvents(change.fd, change.to) == EVENT_SYS_ERR_OK) {
+            continue;
+        }
+        // The fd may have been closed, and maybe reused, while its change was queued. Closing it has removed
+        // it from the epoll instance already.
+        SetInterested(change.fd, false);
+        if (change.to != Events::EVENT_NONE && ApplyEvents(change.fd, change.to) != EVENT_SYS_ERR_OK) {
+            UTILS_LOGE("%{public}s: Apply events: %{public}u to fd: %{public}d failed.", __FUNCTION__, change.to,
+                change.fd);
+        }
+    }
+    pendingChanges_.clear();
+}
+
+void IOEventEpoll::GetStats(IOEventSyscallStats& stats) const
+{
+    stats.waitCalls = waitCalls_.load(std::memory_order_relaxed);
+    stats.ctlCalls = ctlCalls_.load(std::memory_order_relaxed);
+    stats.mergedChanges = mergedChanges_.load(std::memory_order_relaxed);
+    stats.eventCapacity = static_cast<uint32_t>(maxEvents_.load(std::memory_order_relaxed));
+}
+
+ErrCode IOEventEpoll::Polling(int timeout /* ms */, std::vector<std::pair<int, REventId>>& res)
+{
+    waitCalls_.fetch_add(1, std::memory_order_relaxed);
+    int nfds = epoll_wait(epollFd_, epollEvents_.data(), maxEvents_.load(std::memory_order_relaxed), timeout);
     if (nfds == -1) {
         UTILS_LOGE("%{public}s: epoll_wait() failed, %{public}s", __FUNCTION__, strerror(errno));
         return EVENT_SYS_ERR_FAILED;
     }
     for (int idx = 0; idx < nfds; ++idx) {
-        res.emplace_back(std::make_pair(epollEvents[idx].data.fd, Epoll2Reactor(epollEvents[idx].events)));
+        res.emplace_back(static_cast<int>(epollEvents_[idx].data.fd), Epoll2Reactor(epollEvents_[idx].events));
     }
 
-    if (nfds == maxEvents_) {
-        maxEvents_ *= EXPANSION_COEFF;
+    AdjustEventArray(nfds);
+    return (nfds == 0) ? EVENT_SYS_ERR_NOEVENT : EVENT_SYS_ERR_OK;
+}
+
+// Grows the event array when a poll fills it, and shrinks it back when the ready counts stay low for a while.
+void IOEventEpoll::AdjustEventArray(int nfds)
+{
+    int maxEvents = maxEvents_.load(std::memory_order_relaxed);
+    if (nfds == maxEvents) {
+        maxEvents *= EXPANSION_COEFF;
+        epollEvents_.resize(maxEvents);
+        maxEvents_.store(maxEvents, std::memory_order_relaxed);
+        lowPolls_ = 0;
+        return;
+    }
+
+    if (maxEvents <= EPOLL_MAX_EVENTS_INIT || nfds > maxEvents / (EXPANSION_COEFF * EXPANSION_COEFF)) {
+        lowPolls_ = 0;
+        return;
+    }
+    if (++lowPolls_ >= SHRINK_AFTER_POLLS) {
+        maxEvents /= EXPANSION_COEFF;
+        maxEvents_.store(maxEvents, std::memory_order_relaxed);
+        epollEvents_.resize(maxEvents);
+        epollEvents_.shrink_to_fit();
+        lowPolls_ = 0;
     }
-    return EVENT_SYS_ERR_OK;
 }
 
 REventId IOEventEpoll::Epoll2Reactor(EPEventId epollEvents)
@@ -159,6 +283,19 @@ EPEventId IOEventEpoll::Reactor2Epoll(REventId reactorEvent)
         res |= EPOLLERR;
     }
 
+    if (reactorEvent & Events::EVENT_ET) {
+        res |= EPOLLET;
+    }
+
+    if (reactorEvent & Events::EVENT_ONESHOT) {
+        res |= EPOLLONESHOT;
+    }
+
+    if (reactorEvent & Events::EVENT_EXCLUSIVE) {
+        // EPOLLPRI is refused together with EPOLLEXCLUSIVE.
+        res = (res & ~static_cast<EPEventId>(EPOLLPRI)) | EPOLLEXCLUSIVE;
+    }
+
     return res;
 }
 
@@ -16,46 +16,81 @@
 #ifndef UTILS_EVENT_DEMULTIPLEXER_H
 #define UTILS_EVENT_DEMULTIPLEXER_H
 
+#include <sys/epoll.h>
+#include <atomic>
 #include <mutex>
 #include <cstdint>
 #include <vector>
-#include <set>
 #include "io_event_common.h"
 #include "errors.h"
+#include "io_event_backend.h"
 
 namespace OHOS {
 namespace Utils {
 
 class IOEventHandler;
 
-class IOEventEpoll {
+class IOEventEpoll : public IOEventBackend {
 public:
     using REventId = uint32_t;
     using EPEventId = uint32_t;
 
     static constexpr int EPOLL_MAX_EVENTS_INIT = 8;
     static constexpr int EXPANSION_COEFF = 2;
+    // The event array shrinks after this many polls in a row return at most a quarter of its size.
+    static constexpr uint32_t SHRINK_AFTER_POLLS = 64;
 
     IOEventEpoll();
     IOEventEpoll(const IOEventEpoll&) = delete;
     IOEventEpoll& operator=(const IOEventEpoll&) = delete;
-    virtual ~IOEventEpoll();
+    ~IOEventEpoll() override;
 
-    virtual ErrCode SetUp();
-    virtual void CleanUp();
+    ErrCode SetUp() override;
+    void CleanUp() override;
 
-    virtual ErrCode Polling(int timeout, std::vector<std::pair<int, REventId>>&);
+    ErrCode Polling(int timeout, std::vector<std::pair<int, REventId>>&) override;
 
-    virtual ErrCode ModifyEvents(int fd, REventId events);
+    ErrCode ModifyEvents(int fd, REventId events) override;
+
+    // Queues a change of the interested events from `from` to `to`, applied by ApplyChanges(). Changes of the
+    // same fd are merged, and none is applied if the fd ends up with the events it had.
+    ErrCode QueueEvents(int fd, REventId from, REventId to) override;
+    void ApplyChanges() override;
+
+    void GetStats(IOEventSyscallStats& stats) const override;
+
+    IOEventBackendType GetType() const override
+    {
+        return IOEventBackendType::EPOLL;
+    }
 
 private:
+    struct PendingChange {
+        int fd;
+        REventId from;
+        REventId to;
+    };
+
     EPEventId Reactor2Epoll(REventId reactorEvent);
     REventId Epoll2Reactor(EPEventId epollEvents);
     bool OperateEpoll(int op, int fd, EPEventId epollEvents);
+    ErrCode ApplyEvents(int fd, REventId events);
+    void AdjustEventArray(int nfds);
+    bool IsInterested(int fd) const;
+    void SetInterested(int fd, bool interested);
+    static bool TestBit(const std::vector<uint64_t>& bits, int fd);
+    static void SetBit(std::vector<uint64_t>& bits, int fd, bool value);
 
     int epollFd_;
-    int maxEvents_;
-    std::set<int> interestFds_;
+    std::atomic<int> maxEvents_;  // Read by GetStats() from other threads.
+    uint32_t lowPolls_;  // Polls in a row which used at most a quarter of the event array.
+    std::vector<struct epoll_event> epollEvents_;
+    std::vector<uint64_t> interestBits_;  // Bit fd is set if fd is added to the epoll instance.
+    std::vector<uint64_t> exclusiveBits_;  // Bit fd is set if fd is added with EPOLLEXCLUSIVE.
+    std::vector<PendingChange> pendingChanges_;
+    std::atomic<uint64_t> waitCalls_;
+    std::atomic<uint64_t> ctlCalls_;
+    std::atomic<uint64_t> mergedChanges_;
 };
 
 } // Utils
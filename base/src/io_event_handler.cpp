@@ -22,23 +22,18 @@ namespace OHOS {
 namespace Utils {
 IOEventHandler::IOEventHandler()
     :prev_(nullptr), next_(nullptr), fd_(IO_EVENT_INVALID_FD), events_(Events::EVENT_NONE),
-    cb_(nullptr), enabled_(false) {}
+    cb_(nullptr), enabled_(false), reactor_(nullptr) {}
 
 IOEventHandler::IOEventHandler(int fd, EventId events, const EventCallback& cb)
-    :prev_(nullptr), next_(nullptr), fd_(fd), events_(events), cb_(cb), enabled_(false) {}
+    :prev_(nullptr), next_(nullptr), fd_(fd), events_(events), cb_(cb), enabled_(false), reactor_(nullptr) {}
 
 IOEventHandler::~IOEventHandler()
 {
-    if (prev_ != nullptr) {
-        prev_->next_ = next_;
+    // The reactor holds the head of the handler list of the fd, so a handler released while added is removed
+    // through it.
+    if (reactor_ != nullptr) {
+        reactor_->RemoveHandler(this);
     }
-
-    if (next_ != nullptr) {
-        next_->prev_ = prev_;
-    }
-
-    prev_ = nullptr;
-    next_ = nullptr;
 }
 
 bool IOEventHandler::Start(IOEventReactor* reactor)
@@ -13,54 +13,215 @@
  * limitations under the License.
  */
 
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cstring>
 #include "utils_log.h"
 #include "common_event_sys_errors.h"
 #include "io_event_epoll.h"
+#include "io_event_uring.h"
 #include "io_event_reactor.h"
 #include <climits>
 
 namespace OHOS {
 namespace Utils {
-constexpr int MAX_FD = 40000;
+namespace {
+// Soft limit of RLIMIT_NOFILE if `hard` is false, otherwise the hard one.
+int GetNoFileLimit(bool hard)
+{
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return INT_MAX;
+    }
+    rlim_t value = hard ? limit.rlim_max : limit.rlim_cur;
+    return (value == RLIM_INFINITY || value > static_cast<rlim_t>(INT_MAX)) ? INT_MAX : static_cast<int>(value);
+}
+} // namespace
 
 IOEventReactor::IOEventReactor()
-    :loopReady_(false), enabled_(false), count_(0), ioHandlers_(INIT_FD_NUMS), backend_(new IOEventEpoll()) {}
+    :loopReady_(false), enabled_(false), count_(0), fdLimit_(GetNoFileLimit(false)), backend_(new IOEventEpoll()),
+    dispatching_(nullptr), wakeupFd_(IO_EVENT_INVALID_FD) {}
 
 IOEventReactor::~IOEventReactor()
 {
     CleanUp();
+    if (wakeupFd_ != IO_EVENT_INVALID_FD) {
+        close(wakeupFd_);
+    }
 }
 
-ErrCode IOEventReactor::SetUp()
+ErrCode IOEventReactor::SetUp(IOEventBackendType type)
 {
-    if (backend_ == nullptr) {
-        backend_ = std::make_unique<IOEventEpoll>();
+    std::lock_guard<InnerMutex> lock(mutex_);
+    if (backend_ == nullptr || backend_->GetType() != type) {
+        if (count_ != 0) {
+            UTILS_LOGE("%{public}s: Failed, cannot change the backend with handlers added.", __FUNCTION__);
+            return EVENT_SYS_ERR_ALREADY_STARTED;
+        }
+        if (type == IOEventBackendType::IO_URING) {
+            backend_ = std::make_unique<IOEventUring>();
+        } else {
+            backend_ = std::make_unique<IOEventEpoll>();
+        }
     }
 
     ErrCode res = backend_->SetUp();
+    if (res != EVENT_SYS_ERR_OK && backend_->GetType() == IOEventBackendType::IO_URING) {
+        UTILS_LOGW("%{public}s: io_uring is not available, fall back to epoll.", __FUNCTION__);
+        backend_ = std::make_unique<IOEventEpoll>();
+        res = backend_->SetUp();
+    }
     if (res != EVENT_SYS_ERR_OK) {
         UTILS_LOGE("%{public}s: Backend start failed.", __FUNCTION__);
         return res;
     }
+    if (!SetUpWakeup()) {
+        return EVENT_SYS_ERR_BADF;
+    }
 
     loopReady_ = true;
     return res;
 }
 
-void IOEventReactor::InsertNodeFront(int fd, IOEventHandler* target)
+bool IOEventReactor::SetUpWakeup()
+{
+    if (wakeupFd_ == IO_EVENT_INVALID_FD) {
+        wakeupFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeupFd_ < 0) {
+            UTILS_LOGE("%{public}s: Create eventfd failed, %{public}s.", __FUNCTION__, strerror(errno));
+            wakeupFd_ = IO_EVENT_INVALID_FD;
+            return false;
+        }
+    }
+    // Watched on every SetUp(), as the backend may have been replaced.
+    if (backend_->ModifyEvents(wakeupFd_, Events::EVENT_READ) != EVENT_SYS_ERR_OK) {
+        UTILS_LOGE("%{public}s: Watch eventfd failed.", __FUNCTION__);
+        return false;
+    }
+    return true;
+}
+
+void IOEventReactor::Wakeup()
+{
+    if (wakeupFd_ == IO_EVENT_INVALID_FD) {
+        return;
+    }
+    uint64_t one = 1;
+    if (write(wakeupFd_, &one, sizeof(one)) != sizeof(one)) {
+        UTILS_LOGD("%{public}s: Write eventfd failed, %{public}s.", __FUNCTION__, strerror(errno));
+    }
+}
+
+ErrCode IOEventReactor::Post(const EventCallback& task)
+{
+    if (!task) {
+        return EVENT_SYS_ERR_FAILED;
+    }
+    if (wakeupFd_ == IO_EVENT_INVALID_FD) {
+        UTILS_LOGE("%{public}s: Failed, reactor is not set up.", __FUNCTION__);
+        return EVENT_SYS_ERR_BADF;
+    }
+
+    {
+        std::lock_guard<InnerMutex> lock(tasksMutex_);
+        tasks_.push_back(task);
+    }
+    Wakeup();
+    return EVENT_SYS_ERR_OK;
+}
+
+void IOEventReactor::RunTasks()
+{
+    uint64_t count = 0;
+    if (read(wakeupFd_, &count, sizeof(count)) != sizeof(count)) {
+        UTILS_LOGD("%{public}s: Read eventfd failed, %{public}s.", __FUNCTION__, strerror(errno));
+    }
+
+    std::vector<EventCallback> tasks;
+    {
+        std::lock_guard<InnerMutex> lock(tasksMutex_);
+        tasks.swap(tasks_);
+    }
+    for (const EventCallback& task : tasks) {
+        task();
+    }
+}
+
+// Blocks on the eventfd alone while handling is disabled, the backend would keep reporting pending events.
+void IOEventReactor::Park()
+{
+    struct pollfd wakeup;
+    wakeup.fd = wakeupFd_;
+    wakeup.events = POLLIN;
+    wakeup.revents = 0;
+    if (poll(&wakeup, 1, -1) > 0) {
+        RunTasks();
+    }
+}
+
+ErrCode IOEventReactor::SetFdLimit(int limit)
 {
-    IOEventHandler* h = ioHandlers_[fd].head.get();
-    target->next_ = h->next_;
-    target->prev_ = h;
-    if (h->next_ != nullptr) {
-        h->next_->prev_ = target;
+    int hardLimit = GetNoFileLimit(true);
+    if (limit <= 0 || limit > hardLimit) {
+        UTILS_LOGE("%{public}s: Failed, limit: %{public}d is out of (0, %{public}d].", __FUNCTION__, limit, hardLimit);
+        return EVENT_SYS_ERR_FAILED;
     }
-    h->next_ = target;
+    fdLimit_ = limit;
+    return EVENT_SYS_ERR_OK;
+}
+
+// Only checked when adding, handlers added before the limit is lowered can still be found and removed.
+bool IOEventReactor::IsValidFd(int fd) const
+{
+    // If fd is -1, it is uninitialized, if less than -1, it is invalid.
+    return fd >= 0 && fd < fdLimit_;
+}
+
+IOEventReactor::FdEvents* IOEventReactor::FindEntry(int fd)
+{
+    size_t chunk = static_cast<size_t>(fd) / FD_CHUNK_SIZE;
+    if (fd < 0 || chunk >= fdChunks_.size() || fdChunks_[chunk] == nullptr) {
+        return nullptr;
+    }
+    return &fdChunks_[chunk][static_cast<size_t>(fd) % FD_CHUNK_SIZE];
+}
+
+// Obtains the entry of a valid fd, allocating its chunk if needed. Only the chunks are allocated, so the
+// entries of idle fds are a few words each, and fds far apart share no memory.
+IOEventReactor::FdEvents& IOEventReactor::GetEntry(int fd)
+{
+    size_t chunk = static_cast<size_t>(fd) / FD_CHUNK_SIZE;
+    if (chunk >= fdChunks_.size()) {
+        fdChunks_.resize(chunk + 1);
+    }
+    if (fdChunks_[chunk] == nullptr) {
+        UTILS_LOGD("%{public}s: Allocate chunk: %{public}zu when fd: %{public}d", __FUNCTION__, chunk, fd);
+        fdChunks_[chunk] = std::make_unique<FdEvents[]>(FD_CHUNK_SIZE);
+    }
+    return fdChunks_[chunk][static_cast<size_t>(fd) % FD_CHUNK_SIZE];
+}
+
+void IOEventReactor::InsertNodeFront(int fd, IOEventHandler* target)
+{
+    FdEvents& entry = GetEntry(fd);
+    target->next_ = entry.head;
+    target->prev_ = &anchor_;
+    target->reactor_ = this;
+    if (entry.head != nullptr) {
+        entry.head->prev_ = target;
+    }
+    entry.head = target;
 }
 
 void IOEventReactor::RemoveNode(IOEventHandler* target)
 {
-    target->prev_->next_ = target->next_;
+    if (target->prev_ == &anchor_) {
+        GetEntry(target->fd_).head = target->next_;
+    } else {
+        target->prev_->next_ = target->next_;
+    }
 
     if (target->next_ != nullptr) {
         target->next_->prev_ = target->prev_;
@@ -68,6 +229,7 @@ void IOEventReactor::RemoveNode(IOEventHandler* target)
 
     target->prev_ = nullptr;
     target->next_ = nullptr;
+    target->reactor_ = nullptr;
 }
 
 ErrCode IOEventReactor::AddHandler(IOEventHandler* target)
@@ -76,9 +238,7 @@ ErrCode IOEventReactor::AddHandler(IOEventHandler* target)
         return EVENT_SYS_ERR_NOT_FOUND;
     }
 
-    // If fd_ is -1, it is uninitialized, if less than -1, it is invalid.
-    // If fd_ is greater than INT32_MAX / 4, it is invalid.
-    if (target->fd_ < 0 || target->fd_ > MAX_FD) {
+    if (!IsValidFd(target->fd_)) {
         UTILS_LOGE("%{public}s: Failed, Bad fd.", __FUNCTION__);
         return EVENT_SYS_ERR_BADF;
     }
@@ -87,16 +247,11 @@ ErrCode IOEventReactor::AddHandler(IOEventHandler* target)
         return EVENT_SYS_ERR_ALREADY_STARTED;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<InnerMutex> lock(mutex_);
     int fd = target->fd_;
-    if (static_cast<size_t>(fd) > ioHandlers_.size() - 1u) {
-        UTILS_LOGD("%{public}s: Resize when fd: %{public}d", __FUNCTION__, fd);
-        ioHandlers_.resize(fd * EXPANSION_COEFF);
-    }
-
     InsertNodeFront(fd, target);
 
-    if ((ioHandlers_[fd].events & target->events_) != target->events_) {
+    if ((GetEntry(fd).events & target->events_) != target->events_) {
         if (backend_ == nullptr || !UpdateToDemultiplexer(target->fd_)) {
             UTILS_LOGE("%{public}s: Update fd: %{public}d to backend failed.", __FUNCTION__, target->fd_);
             return EVENT_SYS_ERR_FAILED;
@@ -114,9 +269,7 @@ ErrCode IOEventReactor::UpdateHandler(IOEventHandler* target)
         return EVENT_SYS_ERR_NOT_FOUND;
     }
 
-    // If fd_ is -1, it is uninitialized, if less than -1, it is invalid.
-    // If fd_ is greater than INT32_MAX / 4, it is invalid.
-    if (target->fd_ < 0 || target->fd_ > MAX_FD) {
+    if (target->fd_ < 0) {
         UTILS_LOGE("%{public}s: Failed, Bad fd.", __FUNCTION__);
         return EVENT_SYS_ERR_BADF;
     }
@@ -142,15 +295,17 @@ ErrCode IOEventReactor::RemoveHandler(IOEventHandler* target)
         return EVENT_SYS_ERR_NOT_FOUND;
     }
 
-    // If fd_ is -1, it is uninitialized, if less than -1, it is invalid.
-    // If fd_ is greater than INT32_MAX / 4, it is invalid.
-    if (target->fd_ < 0 || target->fd_ > MAX_FD) {
+    if (target->fd_ < 0) {
         UTILS_LOGE("%{public}s: Failed, Bad fd.", __FUNCTION__);
         return EVENT_SYS_ERR_BADF;
     }
 
     target->enabled_ = false;
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<InnerMutex> lock(mutex_);
+    // Once removed, the handler may be released, so wait for its callback running on the loop thread.
+    while (dispatching_ == target && std::this_thread::get_id() != loopThread_) {
+        dispatchDone_.wait(lock);
+    }
 
     if (!HasHandler(target)) {
         UTILS_LOGE("%{public}s Failed. Handler not found.", __FUNCTION__);
@@ -172,11 +327,12 @@ ErrCode IOEventReactor::RemoveHandler(IOEventHandler* target)
 
 bool IOEventReactor::HasHandler(IOEventHandler* target)
 {
-    if (target->fd_ < 0 || target->fd_ >= ioHandlers_.size()) {
+    FdEvents* entry = FindEntry(target->fd_);
+    if (entry == nullptr) {
         return false;
     }
-    
-    for (IOEventHandler* cur = ioHandlers_[target->fd_].head.get(); cur != nullptr; cur = cur->next_) {
+
+    for (IOEventHandler* cur = entry->head; cur != nullptr; cur = cur->next_) {
         if (cur == target) {
             return true;
         }
@@ -191,14 +347,12 @@ ErrCode IOEventReactor::FindHandler(IOEventHandler* target)
         return EVENT_SYS_ERR_NOT_FOUND;
     }
 
-    // If fd_ is -1, it is uninitialized, if less than -1, it is invalid.
-    // If fd_ is greater than INT32_MAX / 4, it is invalid.
-    if (target->fd_ < 0 || target->fd_ > MAX_FD) {
+    if (target->fd_ < 0) {
         UTILS_LOGD("%{public}s: Failed, Bad fd.", __FUNCTION__);
         return EVENT_SYS_ERR_BADF;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<InnerMutex> lock(mutex_);
 
     if (!HasHandler(target)) {
         UTILS_LOGD("%{public}s: Handler not found.", __FUNCTION__);
@@ -210,60 +364,83 @@ ErrCode IOEventReactor::FindHandler(IOEventHandler* target)
 
 bool IOEventReactor::UpdateToDemultiplexer(int fd)
 {
+    FdEvents& entry = GetEntry(fd);
     uint32_t emask = 0u;
-    for (IOEventHandler* cur = ioHandlers_[fd].head.get(); cur != nullptr; cur = cur->next_) {
+    for (IOEventHandler* cur = entry.head; cur != nullptr; cur = cur->next_) {
         emask |= cur->events_;
     }
 
-    if (emask == ioHandlers_[fd].events) {
+    bool disarmed = (entry.flags & FLAG_DISARMED) != 0;
+    if (emask == entry.events && !disarmed) {
         UTILS_LOGW("%{public}s: Warning, Interested events not changed.", __FUNCTION__);
         return true;
     }
 
-    ErrCode res = backend_->ModifyEvents(fd, emask);
+    // Changes made by callbacks on the loop thread are applied in one batch before the next poll. Re-arming is
+    // queued as a change from no events, so that it is not merged away.
+    REventId from = disarmed ? Events::EVENT_NONE : entry.events;
+    ErrCode res = (std::this_thread::get_id() == loopThread_) ?
+        backend_->QueueEvents(fd, from, emask) : backend_->ModifyEvents(fd, emask);
     if (res != EVENT_SYS_ERR_OK) {
         UTILS_LOGE("%{public}s: Modify events on backend failed. fd: %{public}d, \
                    new event: %{public}d, error code: %{public}d", __FUNCTION__, fd, emask, res);
         return false;
     }
 
-    ioHandlers_[fd].events = emask;
+    entry.events = emask;
+    entry.flags &= ~FLAG_DISARMED;
     return true;
 }
 
-void IOEventReactor::Execute(const std::vector<EventCallback>& tasks)
+bool IOEventReactor::IsLinked(int fd, IOEventHandler* target)
 {
-    for (const EventCallback& cb : tasks) {
-        cb();
+    for (IOEventHandler* cur = GetEntry(fd).head; cur != nullptr; cur = cur->next_) {
+        if (cur == target) {
+            return true;
+        }
     }
+    return false;
 }
 
 ErrCode IOEventReactor::HandleEvents(int fd, EventId event)
 {
-    std::vector<EventCallback> taskQue;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (!(ioHandlers_[fd].events & event)) {
-            UTILS_LOGD("%{public}s: Non-interested event: %{public}d with fd: %{public}d, interested events: \
-                       %{public}d", __FUNCTION__, event, fd, ioHandlers_[fd].events);
-            return EVENT_SYS_ERR_BADEVENT;
+    std::unique_lock<InnerMutex> lock(mutex_);
+    FdEvents* entry = FindEntry(fd);
+    if (entry == nullptr || !(entry->events & event)) {
+        UTILS_LOGD("%{public}s: Non-interested event: %{public}d with fd: %{public}d", __FUNCTION__, event, fd);
+        return EVENT_SYS_ERR_BADEVENT;
+    }
+    if (entry->events & Events::EVENT_ONESHOT) {
+        entry->flags |= FLAG_DISARMED;
+    }
+
+    pending_.clear();
+    for (IOEventHandler* cur = entry->head; cur != nullptr; cur = cur->next_) {
+        if (cur->events_ != Events::EVENT_NONE && cur->enabled_ && (cur->events_ & event) && cur->cb_) {
+            pending_.push_back(cur);
+            UTILS_LOGD("%{public}s: Handling event success: %{public}d with fd: %{public}d; \
+                       handler interested events: %{public}d, active-status: %{public}d", \
+                       __FUNCTION__, event, fd, cur->events_, cur->enabled_);
+        } else {
+            UTILS_LOGD("%{public}s: Handling event ignore: %{public}d with fd: %{public}d; \
+                       handler interested events: %{public}d, active-status: %{public}d", \
+                       __FUNCTION__, event, fd, cur->events_, cur->enabled_);
         }
+    }
 
-        for (IOEventHandler* cur = ioHandlers_[fd].head.get()->next_; cur != nullptr; cur = cur->next_) {
-            if (cur->events_ != Events::EVENT_NONE && cur->enabled_ && (cur->events_ & event) && cur->cb_) {
-                taskQue.push_back(cur->cb_);
-                UTILS_LOGD("%{public}s: Handling event success: %{public}d with fd: %{public}d; \
-                           handler interested events: %{public}d, active-status: %{public}d", \
-                           __FUNCTION__, event, fd, cur->events_, cur->enabled_);
-            } else {
-                UTILS_LOGD("%{public}s: Handling event ignore: %{public}d with fd: %{public}d; \
-                           handler interested events: %{public}d, active-status: %{public}d", \
-                           __FUNCTION__, event, fd, cur->events_, cur->enabled_);
-            }
+    // Callbacks are invoked in place. A callback may remove or release handlers, so each pending one is only
+    // dereferenced after checking that it is still linked, and RemoveHandler() waits for the running one.
+    for (IOEventHandler* target : pending_) {
+        if (!IsLinked(fd, target) || !target->enabled_ || !(target->events_ & event) || !target->cb_) {
+            continue;
         }
+        dispatching_ = target;
+        lock.unlock();
+        target->cb_();
+        lock.lock();
+        dispatching_ = nullptr;
+        dispatchDone_.notify_all();
     }
-
-    Execute(taskQue);
     return EVENT_SYS_ERR_OK;
 }
 
@@ -272,6 +449,10 @@ void IOEventReactor::HandleAll(const std::vector<std::pair<int, EventId>>& event
     for (size_t idx = 0u; idx < events.size(); idx++) {
         int fd = events[idx].first;
         EventId event = events[idx].second;
+        if (fd == wakeupFd_) {
+            RunTasks();
+            continue;
+        }
 
         UTILS_LOGD("%{public}s: Processing. Handling event: %{public}d, with fd: %{public}d.", \
                    __FUNCTION__, event, fd);
@@ -285,25 +466,24 @@ void IOEventReactor::HandleAll(const std::vector<std::pair<int, EventId>>& event
 void IOEventReactor::Run(int timeout)
 {
     std::vector<std::pair<int, EventId>> gotEvents;
+    {
+        std::lock_guard<InnerMutex> lock(mutex_);
+        loopThread_ = std::this_thread::get_id();
+    }
     while (loopReady_) {
         if (!enabled_) {
+            Park();
             continue;
         }
-        ErrCode res;
-        if (timeout == -1) {
-            std::lock_guard<std::mutex> lock(mutex_);
-            if (count_ ==0) {
-                continue;
-            }
-            res = backend_->Polling(timeout, gotEvents);
-        } else {
-            res = backend_->Polling(timeout, gotEvents);
-        }
+        // mutex_ is not held while waiting, so that handlers can be added from other threads meanwhile. The
+        // eventfd is always watched, so the wait ends on Terminate() even if no handler is added.
+        ErrCode res = backend_->Polling(timeout, gotEvents);
 
         switch (res) {
             case EVENT_SYS_ERR_OK:
                 HandleAll(gotEvents);
                 gotEvents.clear();
+                ApplyQueuedChanges();
                 break;
             case EVENT_SYS_ERR_NOEVENT:
                 UTILS_LOGD("%{public}s: No events captured.", __FUNCTION__);
@@ -315,19 +495,50 @@ void IOEventReactor::Run(int timeout)
                 break;
         }
     }
+
+    std::lock_guard<InnerMutex> lock(mutex_);
+    loopThread_ = std::thread::id();
+    backend_->ApplyChanges();
+}
+
+void IOEventReactor::ApplyQueuedChanges()
+{
+    std::lock_guard<InnerMutex> lock(mutex_);
+    backend_->ApplyChanges();
+}
+
+IOEventSyscallStats IOEventReactor::GetSyscallStats()
+{
+    IOEventSyscallStats stats;
+    std::lock_guard<InnerMutex> lock(mutex_);
+    if (backend_ != nullptr) {
+        backend_->GetStats(stats);
+    }
+    return stats;
+}
+
+IOEventBackendType IOEventReactor::GetBackendType()
+{
+    std::lock_guard<InnerMutex> lock(mutex_);
+    return (backend_ != nullptr) ? backend_->GetType() : IOEventBackendType::EPOLL;
 }
 
 bool IOEventReactor::DoClean(int fd)
 {
-    if (ioHandlers_[fd].head->next_ == nullptr) {
+    FdEvents* entry = FindEntry(fd);
+    if (entry == nullptr || entry->head == nullptr) {
         return true;
     }
 
-    for (IOEventHandler* cur = ioHandlers_[fd].head->next_; cur != nullptr; cur = cur->next_) {
-        cur->prev_->next_ = nullptr;
+    IOEventHandler* next = nullptr;
+    for (IOEventHandler* cur = entry->head; cur != nullptr; cur = next) {
+        next = cur->next_;
         cur->prev_ = nullptr;
+        cur->next_ = nullptr;
+        cur->reactor_ = nullptr;
         cur->enabled_ = false;
     }
+    entry->head = nullptr;
 
     if (!UpdateToDemultiplexer(fd)) {
         UTILS_LOGD("%{public}s: Clear handler list success, while updating backend failed.", __FUNCTION__);
@@ -339,10 +550,10 @@ bool IOEventReactor::DoClean(int fd)
 
 ErrCode IOEventReactor::CleanUp()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<InnerMutex> lock(mutex_);
     ErrCode res = EVENT_SYS_ERR_OK;
-    for (size_t fd = 0u; fd < ioHandlers_.size() && fd <= INT_MAX; fd++) {
-        if (!DoClean(fd)) {
+    for (size_t fd = 0u; fd < fdChunks_.size() * FD_CHUNK_SIZE && fd <= INT_MAX; fd++) {
+        if (!DoClean(static_cast<int>(fd))) {
             UTILS_LOGD("%{public}s Failed.", __FUNCTION__);
             res = EVENT_SYS_ERR_FAILED;
         }
@@ -358,7 +569,7 @@ ErrCode IOEventReactor::Clean(int fd)
         return EVENT_SYS_ERR_BADF;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<InnerMutex> lock(mutex_);
     if (!DoClean(fd)) {
         UTILS_LOGD("%{public}s: Failed.", __FUNCTION__);
         return EVENT_SYS_ERR_FAILED;
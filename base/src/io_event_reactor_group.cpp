@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils_log.h"
+#include "common_event_sys_errors.h"
+#include "io_event_reactor_group.h"
+
+namespace OHOS {
+namespace Utils {
+
+IOEventReactorGroup::IOEventReactorGroup(size_t loopNum, AssignPolicy policy)
+    : policy_(policy), started_(false)
+{
+    if (loopNum == 0) {
+        loopNum = 1;
+    }
+    for (size_t i = 0; i < loopNum; i++) {
+        std::unique_ptr<Loop> loop = std::make_unique<Loop>();
+        loop->reactor = std::make_unique<IOEventReactor>();
+        loops_.push_back(std::move(loop));
+    }
+}
+
+IOEventReactorGroup::~IOEventReactorGroup()
+{
+    Stop();
+}
+
+ErrCode IOEventReactorGroup::SetUp(IOEventBackendType backend)
+{
+    for (auto& loop : loops_) {
+        ErrCode res = loop->reactor->SetUp(backend);
+        if (res != EVENT_SYS_ERR_OK) {
+            UTILS_LOGE("%{public}s: Reactor set up failed.", __FUNCTION__);
+            return res;
+        }
+        loop->reactor->EnableHandling();
+    }
+    return EVENT_SYS_ERR_OK;
+}
+
+ErrCode IOEventReactorGroup::Start(int timeout)
+{
+    if (started_) {
+        UTILS_LOGW("%{public}s: Warning, already started.", __FUNCTION__);
+        return EVENT_SYS_ERR_ALREADY_STARTED;
+    }
+
+    for (auto& loop : loops_) {
+        IOEventReactor* reactor = loop->reactor.get();
+        loop->thread = std::thread([reactor, timeout] { reactor->Run(timeout); });
+    }
+    started_ = true;
+    return EVENT_SYS_ERR_OK;
+}
+
+void IOEventReactorGroup::Stop()
+{
+    if (!started_) {
+        return;
+    }
+
+    for (auto& loop : loops_) {
+        loop->reactor->Terminate();
+    }
+    for (auto& loop : loops_) {
+        if (loop->thread.joinable()) {
+            loop->thread.join();
+        }
+    }
+    started_ = false;
+}
+
+size_t IOEventReactorGroup::PickLoop(int fd)
+{
+    if (policy_ == AssignPolicy::FD_HASH) {
+        return static_cast<size_t>(fd) % loops_.size();
+    }
+
+    size_t picked = 0;
+    for (size_t i = 1; i < loops_.size(); i++) {
+        if (loops_[i]->fdNum < loops_[picked]->fdNum) {
+            picked = i;
+        }
+    }
+    return picked;
+}
+
+ErrCode IOEventReactorGroup::AddHandler(IOEventHandler* target)
+{
+    if (target == nullptr) {
+        return EVENT_SYS_ERR_NOT_FOUND;
+    }
+    int fd = target->GetFd();
+    if (fd < 0) {
+        UTILS_LOGE("%{public}s: Failed, Bad fd.", __FUNCTION__);
+        return EVENT_SYS_ERR_BADF;
+    }
+
+    std::lock_guard<InnerMutex> lock(mutex_);
+    auto itor = assignments_.find(fd);
+    size_t index = (itor != assignments_.end()) ? itor->second.loop : PickLoop(fd);
+    ErrCode res = loops_[index]->reactor->AddHandler(target);
+    if (res != EVENT_SYS_ERR_OK) {
+        return res;
+    }
+
+    if (itor != assignments_.end()) {
+        itor->second.handlerNum++;
+    } else {
+        assignments_[fd] = {index, 1};
+        loops_[index]->fdNum++;
+        UTILS_LOGD("%{public}s: Assign fd: %{public}d to loop %{public}zu.", __FUNCTION__, fd, index);
+    }
+    return EVENT_SYS_ERR_OK;
+}
+
+ErrCode IOEventReactorGroup::RemoveHandler(IOEventHandler* target)
+{
+    if (target == nullptr) {
+        return EVENT_SYS_ERR_NOT_FOUND;
+    }
+
+    int fd = target->GetFd();
+    size_t index = 0;
+    {
+        std::lock_guard<InnerMutex> lock(mutex_);
+        auto itor = assignments_.find(fd);
+        if (itor == assignments_.end()) {
+            UTILS_LOGE("%{public}s Failed. Handler not found.", __FUNCTION__);
+            return EVENT_SYS_ERR_NOT_FOUND;
+        }
+        index = itor->second.loop;
+    }
+
+    // Not locked, the reactor waits for the running callback of the handler, which may call into the group.
+    ErrCode res = loops_[index]->reactor->RemoveHandler(target);
+    if (res != EVENT_SYS_ERR_OK) {
+        return res;
+    }
+
+    std::lock_guard<InnerMutex> lock(mutex_);
+    auto itor = assignments_.find(fd);
+    if (itor != assignments_.end() && --itor->second.handlerNum == 0) {
+        assignments_.erase(itor);
+        loops_[index]->fdNum--;
+    }
+    return EVENT_SYS_ERR_OK;
+}
+
+ErrCode IOEventReactorGroup::UpdateHandler(IOEventHandler* target)
+{
+    if (target == nullptr) {
+        return EVENT_SYS_ERR_NOT_FOUND;
+    }
+    if (target->Prev() == nullptr) {
+        return AddHandler(target);
+    }
+
+    std::lock_guard<InnerMutex> lock(mutex_);
+    auto itor = assignments_.find(target->GetFd());
+    if (itor == assignments_.end()) {
+        UTILS_LOGE("%{public}s: Failed, handler not found.", __FUNCTION__);
+        return EVENT_SYS_ERR_NOT_FOUND;
+    }
+    return loops_[itor->second.loop]->reactor->UpdateHandler(target);
+}
+
+ErrCode IOEventReactorGroup::Post(size_t loop, const EventCallback& task)
+{
+    if (loop >= loops_.size()) {
+        UTILS_LOGE("%{public}s: Failed, loop %{public}zu not found.", __FUNCTION__, loop);
+        return EVENT_SYS_ERR_NOT_FOUND;
+    }
+    return loops_[loop]->reactor->Post(task);
+}
+
+int IOEventReactorGroup::GetLoopIndex(int fd)
+{
+    std::lock_guard<InnerMutex> lock(mutex_);
+    auto itor = assignments_.find(fd);
+    return (itor == assignments_.end()) ? -1 : static_cast<int>(itor->second.loop);
+}
+
+size_t IOEventReactorGroup::GetLoopLoad(size_t loop)
+{
+    std::lock_guard<InnerMutex> lock(mutex_);
+    return (loop < loops_.size()) ? loops_[loop]->fdNum : 0;
+}
+
+IOEventReactor* IOEventReactorGroup::GetReactor(size_t loop)
+{
+    return (loop < loops_.size()) ? loops_[loop]->reactor.get() : nullptr;
+}
+
+} // namespace Utils
+} // namespace OHOS
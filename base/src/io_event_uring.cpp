@@ -0,0 +1,500 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+#include "utils_log.h"
+#include "common_event_sys_errors.h"
+#include "io_event_uring.h"
+
+namespace OHOS {
+namespace Utils {
+namespace {
+// user_data of a poll is its generation and fd, ctrl operations have the top bit set and are only checked for errors.
+constexpr uint64_t CTRL_USER_DATA = 1ULL << 63;
+constexpr uint32_t GENERATION_MASK = 0x7fffffffu;
+constexpr uint32_t FD_BITS = 32;
+
+uint64_t PollUserData(int fd, uint32_t generation)
+{
+    return (static_cast<uint64_t>(generation & GENERATION_MASK) << FD_BITS) | static_cast<uint32_t>(fd);
+}
+
+template<typename T>
+T* RingField(void* ring, uint32_t offset)
+{
+    return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+} // namespace
+
+IOEventUring::IOEventUring()
+    : ringFd_(IO_EVENT_INVALID_FD), sqRing_(MAP_FAILED), sqRingSize_(0), cqRing_(MAP_FAILED), cqRingSize_(0),
+    sqes_(nullptr), sqesSize_(0), sqHead_(nullptr), sqTail_(nullptr), sqMask_(0), sqArray_(nullptr),
+    cqHead_(nullptr), cqTail_(nullptr), cqMask_(0), cqes_(nullptr), cqEntries_(0), unsubmitted_(0),
+    filesRegistered_(false), invalidFd_(IO_EVENT_INVALID_FD), waitCalls_(0), ctlCalls_(0), mergedChanges_(0) {}
+
+IOEventUring::~IOEventUring()
+{
+    CleanUp();
+}
+
+ErrCode IOEventUring::SetUp()
+{
+    std::lock_guard<InnerMutex> lock(mutex_);
+    if (ringFd_ != IO_EVENT_INVALID_FD) {
+        return EVENT_SYS_ERR_OK;
+    }
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ringFd_ = static_cast<int>(syscall(__NR_io_uring_setup, SQ_ENTRIES, &params));
+    if (ringFd_ < 0) {
+        UTILS_LOGW("%{public}s: io_uring_setup() failed, %{public}s.", __FUNCTION__, strerror(errno));
+        ringFd_ = IO_EVENT_INVALID_FD;
+        return EVENT_SYS_ERR_BADF;
+    }
+
+    // Multishot polls came with the same kernel as IORING_FEAT_RSRC_TAGS.
+    const uint32_t required = IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG | IORING_FEAT_RSRC_TAGS;
+    if ((params.features & required) != required || !MapRings(params)) {
+        UTILS_LOGW("%{public}s: io_uring features: %{public}u not supported.", __FUNCTION__, params.features);
+        UnmapRings();
+        close(ringFd_);
+        ringFd_ = IO_EVENT_INVALID_FD;
+        return EVENT_SYS_ERR_FAILED;
+    }
+
+    std::vector<int> emptySlots(REGISTERED_FILES, IO_EVENT_INVALID_FD);
+    filesRegistered_ = syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_FILES, emptySlots.data(),
+        REGISTERED_FILES) == 0;
+    if (!filesRegistered_) {
+        UTILS_LOGD("%{public}s: Register files failed, %{public}s.", __FUNCTION__, strerror(errno));
+    }
+    slotFds_.resize(REGISTERED_FILES);
+    for (int slot = 0; slot < REGISTERED_FILES; slot++) {
+        slotFds_[slot] = slot;
+    }
+    return EVENT_SYS_ERR_OK;
+}
+
+bool IOEventUring::MapRings(const struct io_uring_params& params)
+{
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        sqRingSize_ = (cqRingSize_ > sqRingSize_) ? cqRingSize_ : sqRingSize_;
+        cqRingSize_ = 0;
+    }
+
+    sqRing_ = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_,
+        IORING_OFF_SQ_RING);
+    if (sqRing_ == MAP_FAILED) {
+        return false;
+    }
+    if (cqRingSize_ != 0) {
+        cqRing_ = mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_,
+            IORING_OFF_CQ_RING);
+        if (cqRing_ == MAP_FAILED) {
+            return false;
+        }
+    }
+    sqesSize_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_,
+        IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return false;
+    }
+    sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+    void* cqRing = (cqRingSize_ != 0) ? cqRing_ : sqRing_;
+    sqHead_ = RingField<uint32_t>(sqRing_, params.sq_off.head);
+    sqTail_ = RingField<uint32_t>(sqRing_, params.sq_off.tail);
+    sqMask_ = *RingField<uint32_t>(sqRing_, params.sq_off.ring_mask);
+    sqArray_ = RingField<uint32_t>(sqRing_, params.sq_off.array);
+    cqHead_ = RingField<uint32_t>(cqRing, params.cq_off.head);
+    cqTail_ = RingField<uint32_t>(cqRing, params.cq_off.tail);
+    cqMask_ = *RingField<uint32_t>(cqRing, params.cq_off.ring_mask);
+    cqes_ = RingField<struct io_uring_cqe>(cqRing, params.cq_off.cqes);
+    cqEntries_ = params.cq_entries;
+    // Sqes are used in ring order, so the indirection array never changes.
+    for (uint32_t idx = 0; idx < params.sq_entries; idx++) {
+        sqArray_[idx] = idx;
+    }
+    return true;
+}
+
+void IOEventUring::UnmapRings()
+{
+    if (sqes_ != nullptr) {
+        munmap(sqes_, sqesSize_);
+        sqes_ = nullptr;
+    }
+    if (cqRing_ != MAP_FAILED) {
+        munmap(cqRing_, cqRingSize_);
+        cqRing_ = MAP_FAILED;
+    }
+    if (sqRing_ != MAP_FAILED) {
+        munmap(sqRing_, sqRingSize_);
+        sqRing_ = MAP_FAILED;
+    }
+}
+
+void IOEventUring::CleanUp()
+{
+    std::lock_guard<InnerMutex> lock(mutex_);
+    if (ringFd_ == IO_EVENT_INVALID_FD) {
+        return;
+    }
+    UnmapRings();
+    // Closing the ring cancels its polls and releases the registered files.
+    if (close(ringFd_) != 0) {
+        UTILS_LOGW("%{public}s: Failed, cannot close fd: %{public}s.", __FUNCTION__, strerror(errno));
+    }
+    ringFd_ = IO_EVENT_INVALID_FD;
+    unsubmitted_ = 0;
+    filesRegistered_ = false;
+    fds_.clear();
+    pendingChanges_.clear();
+}
+
+struct io_uring_sqe* IOEventUring::GetSqe()
+{
+    uint32_t tail = *sqTail_;
+    if (tail - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) > sqMask_ && (!Submit() ||
+        tail - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) > sqMask_)) {
+        UTILS_LOGE("%{public}s: Submission queue is full.", __FUNCTION__);
+        return nullptr;
+    }
+    struct io_uring_sqe* sqe = &sqes_[tail & sqMask_];
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+void IOEventUring::CommitSqe()
+{
+    __atomic_store_n(sqTail_, *sqTail_ + 1, __ATOMIC_RELEASE);
+    unsubmitted_++;
+}
+
+bool IOEventUring::Submit()
+{
+    while (unsubmitted_ != 0) {
+        ctlCalls_.fetch_add(1, std::memory_order_relaxed);
+        int res = static_cast<int>(syscall(__NR_io_uring_enter, ringFd_, unsubmitted_, 0, 0, nullptr, 0));
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            UTILS_LOGE("%{public}s: io_uring_enter() failed, %{public}s.", __FUNCTION__, strerror(errno));
+            return false;
+        }
+        unsubmitted_ -= static_cast<uint32_t>(res);
+    }
+    return true;
+}
+
+bool IOEventUring::ArmPoll(int fd)
+{
+    FdState& state = fds_[fd];
+    if (filesRegistered_ && fd < REGISTERED_FILES && !state.registered) {
+        // A queued unregistration of the slot must not overwrite the registration.
+        struct io_uring_files_update update;
+        memset(&update, 0, sizeof(update));
+        update.offset = static_cast<uint32_t>(fd);
+        update.fds = reinterpret_cast<uintptr_t>(&slotFds_[fd]);
+        ctlCalls_.fetch_add(1, std::memory_order_relaxed);
+        state.registered = Submit() &&
+            syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_FILES_UPDATE, &update, 1) == 1;
+    }
+
+    struct io_uring_sqe* sqe = GetSqe();
+    if (sqe == nullptr) {
+        return false;
+    }
+    state.generation = (state.generation + 1) & GENERATION_MASK;
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->flags = state.registered ? IOSQE_FIXED_FILE : 0;
+    sqe->len = (state.events & Events::EVENT_ONESHOT) ? 0 : IORING_POLL_ADD_MULTI;
+    sqe->poll32_events = Reactor2Poll(state.events);
+    sqe->user_data = PollUserData(fd, state.generation);
+    CommitSqe();
+    state.armed = true;
+    return true;
+}
+
+bool IOEventUring::PrepareChange(int fd, REventId events)
+{
+    if (ringFd_ == IO_EVENT_INVALID_FD) {
+        return false;
+    }
+    if (static_cast<size_t>(fd) >= fds_.size()) {
+        fds_.resize(static_cast<size_t>(fd) + 1);
+    }
+
+    FdState& state = fds_[fd];
+    if (state.events == events && (state.armed || events == Events::EVENT_NONE)) {
+        return true;
+    }
+    state.events = events;
+    if (events != Events::EVENT_NONE && !state.armed) {
+        return ArmPoll(fd);
+    }
+
+    struct io_uring_sqe* sqe = nullptr;
+    if (state.armed) {
+        if ((sqe = GetSqe()) == nullptr) {
+            return false;
+        }
+        sqe->opcode = IORING_OP_POLL_REMOVE;
+        sqe->fd = -1;
+        sqe->addr = PollUserData(fd, state.generation);
+        sqe->user_data = CTRL_USER_DATA;
+        if (events != Events::EVENT_NONE) {
+            // Updates the events of the armed poll in place.
+            sqe->len = IORING_POLL_UPDATE_EVENTS | ((events & Events::EVENT_ONESHOT) ? 0 : IORING_POLL_ADD_MULTI);
+            sqe->poll32_events = Reactor2Poll(events);
+            CommitSqe();
+            return true;
+        }
+        CommitSqe();
+        state.armed = false;
+        state.generation = (state.generation + 1) & GENERATION_MASK;
+    }
+
+    if (state.registered) {
+        if ((sqe = GetSqe()) == nullptr) {
+            return false;
+        }
+        sqe->opcode = IORING_OP_FILES_UPDATE;
+        sqe->fd = -1;
+        sqe->off = static_cast<uint64_t>(fd);
+        sqe->addr = reinterpret_cast<uintptr_t>(&invalidFd_);
+        sqe->len = 1;
+        sqe->user_data = CTRL_USER_DATA;
+        CommitSqe();
+        state.registered = false;
+    }
+    return true;
+}
+
+ErrCode IOEventUring::ModifyEvents(int fd, REventId events)
+{
+    if (fd == -1) {
+        UTILS_LOGE("%{public}s: Failed, bad fd.", __FUNCTION__);
+        return EVENT_SYS_ERR_BADF;
+    }
+    if (events & Events::EVENT_EXCLUSIVE) {
+        UTILS_LOGE("%{public}s: Failed, exclusive mode is not supported.", __FUNCTION__);
+        return EVENT_SYS_ERR_BADEVENT;
+    }
+
+    std::lock_guard<InnerMutex> lock(mutex_);
+    auto itor = std::find_if(pendingChanges_.begin(), pendingChanges_.end(),
+        [fd](const PendingChange& change) { return change.fd == fd; });
+    if (itor != pendingChanges_.end()) {
+        pendingChanges_.erase(itor);
+        mergedChanges_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (!PrepareChange(fd, events) || !Submit()) {
+        UTILS_LOGE("%{public}s: Modify events failed.", __FUNCTION__);
+        return EVENT_SYS_ERR_FAILED;
+    }
+    return EVENT_SYS_ERR_OK;
+}
+
+ErrCode IOEventUring::QueueEvents(int fd, REventId /* from */, REventId to)
+{
+    if (fd == -1) {
+        UTILS_LOGE("%{public}s: Failed, bad fd.", __FUNCTION__);
+        return EVENT_SYS_ERR_BADF;
+    }
+    if (to & Events::EVENT_EXCLUSIVE) {
+        UTILS_LOGE("%{public}s: Failed, exclusive mode is not supported.", __FUNCTION__);
+        return EVENT_SYS_ERR_BADEVENT;
+    }
+
+    std::lock_guard<InnerMutex> lock(mutex_);
+    for (auto itor = pendingChanges_.rbegin(); itor != pendingChanges_.rend(); ++itor) {
+        if (itor->fd == fd) {
+            itor->to = to;
+            mergedChanges_.fetch_add(1, std::memory_order_relaxed);
+            return EVENT_SYS_ERR_OK;
+        }
+    }
+    pendingChanges_.push_back({fd, to});
+    return EVENT_SYS_ERR_OK;
+}
+
+void IOEventUring::ApplyChanges()
+{
+    // Only writes the sqes, they are submitted by the io_uring_enter() of the next Polling().
+    std::lock_guard<InnerMutex> lock(mutex_);
+    for (const PendingChange& change : pendingChanges_) {
+        if (static_cast<size_t>(change.fd) < fds_.size() && fds_[change.fd].events == change.to &&
+            (fds_[change.fd].armed || change.to == Events::EVENT_NONE)) {
+            mergedChanges_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (!PrepareChange(change.fd, change.to)) {
+            UTILS_LOGE("%{public}s: Apply events: %{public}u to fd: %{public}d failed.", __FUNCTION__, change.to,
+                change.fd);
+        }
+    }
+    pendingChanges_.clear();
+}
+
+void IOEventUring::GetStats(IOEventSyscallStats& stats) const
+{
+    stats.waitCalls = waitCalls_.load(std::memory_order_relaxed);
+    stats.ctlCalls = ctlCalls_.load(std::memory_order_relaxed);
+    stats.mergedChanges = mergedChanges_.load(std::memory_order_relaxed);
+    stats.eventCapacity = cqEntries_;
+}
+
+ErrCode IOEventUring::Polling(int timeout /* ms */, std::vector<std::pair<int, REventId>>& res)
+{
+    uint32_t toSubmit = 0;
+    bool ready = false;
+    {
+        std::lock_guard<InnerMutex> lock(mutex_);
+        if (ringFd_ == IO_EVENT_INVALID_FD) {
+            return EVENT_SYS_ERR_BADF;
+        }
+        toSubmit = unsubmitted_;
+        unsubmitted_ = 0;
+        ready = *cqHead_ != __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    }
+
+    if (toSubmit != 0 || !ready) {
+        struct __kernel_timespec ts;
+        ts.tv_sec = (timeout > 0) ? timeout / 1000 : 0; // 1000: ms per second
+        ts.tv_nsec = (timeout > 0) ? (timeout % 1000) * 1000000L : 0; // 1000, 1000000: ms per second, ns per ms
+        struct io_uring_getevents_arg arg;
+        memset(&arg, 0, sizeof(arg));
+        arg.sigmask_sz = _NSIG / 8; // 8: bits per byte
+        arg.ts = (timeout < 0) ? 0 : reinterpret_cast<uintptr_t>(&ts);
+
+        waitCalls_.fetch_add(1, std::memory_order_relaxed);
+        int submitted = static_cast<int>(syscall(__NR_io_uring_enter, ringFd_, toSubmit, (timeout == 0) ? 0 : 1,
+            IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg)));
+        if (submitted < 0) {
+            submitted = 0;
+            if (errno != ETIME && errno != EINTR) {
+                UTILS_LOGE("%{public}s: io_uring_enter() failed, %{public}s", __FUNCTION__, strerror(errno));
+            }
+        }
+        if (static_cast<uint32_t>(submitted) < toSubmit) {
+            std::lock_guard<InnerMutex> lock(mutex_);
+            unsubmitted_ += toSubmit - static_cast<uint32_t>(submitted);
+        }
+    }
+
+    size_t before = res.size();
+    {
+        std::lock_guard<InnerMutex> lock(mutex_);
+        if (ringFd_ != IO_EVENT_INVALID_FD) {
+            ReapCompletions(res);
+        }
+    }
+    return (res.size() == before) ? EVENT_SYS_ERR_NOEVENT : EVENT_SYS_ERR_OK;
+}
+
+void IOEventUring::ReapCompletions(std::vector<std::pair<int, REventId>>& res)
+{
+    uint32_t head = *cqHead_;
+    uint32_t tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+        const struct io_uring_cqe& cqe = cqes_[head & cqMask_];
+        if (cqe.user_data & CTRL_USER_DATA) {
+            if (cqe.res < 0 && cqe.res != -ENOENT && cqe.res != -EALREADY) {
+                UTILS_LOGD("%{public}s: Ctrl operation failed, %{public}s.", __FUNCTION__, strerror(-cqe.res));
+            }
+            continue;
+        }
+
+        int fd = static_cast<int>(static_cast<uint32_t>(cqe.user_data));
+        uint32_t generation = static_cast<uint32_t>(cqe.user_data >> FD_BITS);
+        if (static_cast<size_t>(fd) >= fds_.size() || fds_[fd].generation != generation) {
+            continue;  // Completion of a removed poll.
+        }
+        FdState& state = fds_[fd];
+        if (cqe.res > 0) {
+            res.emplace_back(fd, Poll2Reactor(static_cast<uint32_t>(cqe.res)));
+        }
+        if (cqe.flags & IORING_CQE_F_MORE) {
+            continue;
+        }
+        // The poll has terminated, as it is one-shot, or for example as the completion queue overflowed. Arm it
+        // again unless it failed or waits to be re-armed.
+        state.armed = false;
+        if (cqe.res < 0) {
+            UTILS_LOGE("%{public}s: Poll of fd: %{public}d failed, %{public}s.", __FUNCTION__, fd,
+                strerror(-cqe.res));
+        } else if (state.events != Events::EVENT_NONE && !(state.events & Events::EVENT_ONESHOT)) {
+            ArmPoll(fd);
+        }
+    }
+    __atomic_store_n(cqHead_, tail, __ATOMIC_RELEASE);
+}
+
+REventId IOEventUring::Poll2Reactor(uint32_t pollEvents)
+{
+    REventId res = Events::EVENT_NONE;
+    if ((pollEvents & POLLHUP) && !(pollEvents & POLLIN)) {
+        res |= Events::EVENT_CLOSE;
+    }
+
+    if (pollEvents & POLLERR) {
+        res |= Events::EVENT_ERROR;
+    }
+
+    if (pollEvents & (POLLIN | POLLPRI | POLLRDHUP)) {
+        res |= Events::EVENT_READ;
+    }
+
+    if (pollEvents & POLLOUT) {
+        res |= Events::EVENT_WRITE;
+    }
+
+    return res;
+}
+
+uint32_t IOEventUring::Reactor2Poll(REventId reactorEvent)
+{
+    uint32_t res = 0u;
+
+    if (reactorEvent & Events::EVENT_READ) {
+        res |= POLLIN | POLLPRI;
+    }
+
+    if (reactorEvent & Events::EVENT_WRITE) {
+        res |= POLLOUT;
+    }
+
+    if (reactorEvent & Events::EVENT_ERROR) {
+        res |= POLLERR;
+    }
+
+    return res;
+}
+
+} // namespace Utils
+} // namespace OHOS
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTILS_EVENT_URING_H
+#define UTILS_EVENT_URING_H
+
+#include <linux/io_uring.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "io_event_common.h"
+#include "errors.h"
+#include "io_event_backend.h"
+#include "lock_profiler.h"
+
+namespace OHOS {
+namespace Utils {
+
+/*
+ * Watches fds with multishot polls of an io_uring instance.
+ *
+ * A poll stays armed after reporting events, so handling them submits nothing. Queued interest changes are
+ * merged per fd, written to the submission queue by ApplyChanges() and submitted by the io_uring_enter() which
+ * waits for the next events. Changes made from other threads are submitted at once. Fds below REGISTERED_FILES
+ * are registered to the ring when first watched, which spares the kernel looking them up, and unregistered once
+ * no event of them is interested any more.
+ *
+ * A multishot poll reports readiness as it changes, as EVENT_ET asks for, so all fds are watched edge-triggered.
+ * EVENT_EXCLUSIVE has no counterpart for polls and is refused.
+ */
+class IOEventUring : public IOEventBackend {
+public:
+    static constexpr uint32_t SQ_ENTRIES = 256;
+    static constexpr int REGISTERED_FILES = 1024;
+
+    IOEventUring();
+    IOEventUring(const IOEventUring&) = delete;
+    IOEventUring& operator=(const IOEventUring&) = delete;
+    ~IOEventUring() override;
+
+    // Fails if io_uring is not available, or lacks multishot polls or waiting with a timeout.
+    ErrCode SetUp() override;
+    void CleanUp() override;
+
+    ErrCode Polling(int timeout, std::vector<std::pair<int, REventId>>&) override;
+
+    ErrCode ModifyEvents(int fd, REventId events) override;
+    ErrCode QueueEvents(int fd, REventId from, REventId to) override;
+    void ApplyChanges() override;
+
+    void GetStats(IOEventSyscallStats& stats) const override;
+
+    IOEventBackendType GetType() const override
+    {
+        return IOEventBackendType::IO_URING;
+    }
+
+private:
+    struct PendingChange {
+        int fd;
+        REventId to;
+    };
+
+    struct FdState {
+        REventId events = Events::EVENT_NONE;
+        uint32_t generation = 0;  // Completions of polls of earlier generations are stale.
+        bool armed = false;
+        bool registered = false;
+    };
+
+    bool MapRings(const struct io_uring_params& params);
+    void UnmapRings();
+    struct io_uring_sqe* GetSqe();
+    void CommitSqe();
+    bool Submit();
+    bool PrepareChange(int fd, REventId events);
+    bool ArmPoll(int fd);
+    void ReapCompletions(std::vector<std::pair<int, REventId>>& res);
+    uint32_t Reactor2Poll(REventId reactorEvent);
+    REventId Poll2Reactor(uint32_t pollEvents);
+
+    int ringFd_;
+    void* sqRing_;
+    size_t sqRingSize_;
+    void* cqRing_;
+    size_t cqRingSize_;
+    struct io_uring_sqe* sqes_;
+    size_t sqesSize_;
+    uint32_t* sqHead_;
+    uint32_t* sqTail_;
+    uint32_t sqMask_;
+    uint32_t* sqArray_;
+    uint32_t* cqHead_;
+    uint32_t* cqTail_;
+    uint32_t cqMask_;
+    struct io_uring_cqe* cqes_;
+    uint32_t cqEntries_;
+    uint32_t unsubmitted_;  // Sqes written to the submission queue but not submitted yet.
+    bool filesRegistered_;
+    std::vector<int> slotFds_;  // slotFds_[fd] == fd, fd is registered to slot fd.
+    int invalidFd_;  // Written to a slot to unregister its fd.
+    std::vector<FdState> fds_;
+    std::vector<PendingChange> pendingChanges_;
+    InnerMutex mutex_ INNER_MUTEX_NAME("IOEventUring");  // Guards the rings against other submitting threads.
+    std::atomic<uint64_t> waitCalls_;
+    std::atomic<uint64_t> ctlCalls_;
+    std::atomic<uint64_t> mergedChanges_;
+};
+
+} // namespace Utils
+} // namespace OHOS
+#endif /* UTILS_EVENT_URING_H */
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lock_profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <dlfcn.h>
+#include <map>
+#include <memory>
+#include <sstream>
+
+namespace OHOS {
+namespace Utils {
+
+struct LockStats {
+    explicit LockStats(const std::string& lockName) : name(lockName) {}
+
+    const std::string name;
+    std::atomic<uint64_t> acquisitions {0};
+    std::atomic<uint64_t> contentions {0};
+    std::atomic<uint64_t> totalWaitNs {0};
+    std::atomic<uint64_t> maxWaitNs {0};
+    std::atomic<uint64_t> waitHistogram[LOCK_WAIT_HISTOGRAM_BUCKETS] {};
+
+    // Only touched on the contended path.
+    std::mutex sitesMutex;
+    std::map<const void*, uint64_t> holderSites;
+};
+
+namespace {
+class LockStatsRegistry {
+public:
+    LockStats* Get(const char* name)
+    {
+        std::string key = (name == nullptr) ? "unnamed" : name;
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& stats = stats_[key];
+        if (stats == nullptr) {
+            stats = std::make_unique<LockStats>(key);
+        }
+        return stats.get();
+    }
+
+    template <typename Visitor>
+    void ForEach(Visitor visitor)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& item : stats_) {
+            visitor(*item.second);
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    // Entries are never removed, so ProfiledMutex can keep a raw pointer to its statistics.
+    std::map<std::string, std::unique_ptr<LockStats>> stats_;
+};
+
+LockStatsRegistry& GetRegistry()
+{
+    // Intentionally leaked: static objects holding a ProfiledMutex may be destroyed after this one.
+    static LockStatsRegistry* registry = new LockStatsRegistry();
+    return *registry;
+}
+
+size_t WaitToBucket(uint64_t waitNs)
+{
+    const uint64_t nsPerUs = 1000;
+    uint64_t waitUs = waitNs / nsPerUs;
+    size_t bucket = 0;
+    while (waitUs > 0 && bucket < LOCK_WAIT_HISTOGRAM_BUCKETS - 1) {
+        waitUs >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+std::string SiteToString(const void* site)
+{
+    std::ostringstream os;
+    os << site;
+    Dl_info info;
+    if (site != nullptr && dladdr(site, &info) != 0 && info.dli_sname != nullptr) {
+        os << " (" << info.dli_sname << "+"
+           << (reinterpret_cast<uintptr_t>(site) - reinterpret_cast<uintptr_t>(info.dli_saddr)) << ")";
+    }
+    return os.str();
+}
+} // namespace
+
+ProfiledMutex::ProfiledMutex(const char* name)
+    : mutex_(), stats_(GetRegistry().Get(name)), holderSite_(nullptr)
+{
+}
+
+void ProfiledMutex::OnAcquired(const void* site)
+{
+    stats_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    holderSite_.store(site, std::memory_order_relaxed);
+}
+
+void ProfiledMutex::lock()
+{
+    const void* site = __builtin_return_address(0);
+    if (mutex_.try_lock()) {
+        OnAcquired(site);
+        return;
+    }
+
+    const void* holder = holderSite_.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    mutex_.lock();
+    uint64_t waitNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    OnAcquired(site);
+
+    stats_->contentions.fetch_add(1, std::memory_order_relaxed);
+    stats_->totalWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+    stats_->waitHistogram[WaitToBucket(waitNs)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t maxWait = stats_->maxWaitNs.load(std::memory_order_relaxed);
+    while (waitNs > maxWait && !stats_->maxWaitNs.compare_exchange_weak(maxWait, waitNs)) {}
+
+    std::lock_guard<std::mutex> lock(stats_->sitesMutex);
+    ++stats_->holderSites[holder];
+}
+
+bool ProfiledMutex::try_lock()
+{
+    if (!mutex_.try_lock()) {
+        return false;
+    }
+    OnAcquired(__builtin_return_address(0));
+    return true;
+}
+
+void ProfiledMutex::unlock()
+{
+    mutex_.unlock();
+}
+
+std::vector<LockContentionInfo> LockProfiler::GetReport()
+{
+    std::vector<LockContentionInfo> report;
+    GetRegistry().ForEach([&report](LockStats& stats) {
+        LockContentionInfo info;
+        info.name = stats.name;
+        info.acquisitions = stats.acquisitions.load(std::memory_order_relaxed);
+        info.contentions = stats.contentions.load(std::memory_order_relaxed);
+        info.totalWaitNs = stats.totalWaitNs.load(std::memory_order_relaxed);
+        info.maxWaitNs = stats.maxWaitNs.load(std::memory_order_relaxed);
+        for (auto& bucket : stats.waitHistogram) {
+            info.waitHistogram.push_back(bucket.load(std::memory_order_relaxed));
+        }
+        {
+            std::lock_guard<std::mutex> lock(stats.sitesMutex);
+            info.holderSites.assign(stats.holderSites.begin(), stats.holderSites.end());
+        }
+        std::sort(info.holderSites.begin(), info.holderSites.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+        report.push_back(std::move(info));
+    });
+
+    std::stable_sort(report.begin(), report.end(), [](const LockContentionInfo& lhs, const LockContentionInfo& rhs) {
+        return lhs.totalWaitNs > rhs.totalWaitNs;
+    });
+    return report;
+}
+
+std::string LockProfiler::DumpReport()
+{
+    const size_t maxSitesPerLock = 5;
+    std::ostringstream os;
+    for (const auto& info : GetReport()) {
+        os << info.name << ": acquisitions=" << info.acquisitions << " contentions=" << info.contentions
+           << " totalWaitNs=" << info.totalWaitNs << " maxWaitNs=" << info.maxWaitNs << "\n";
+        os << "  wait histogram (us):";
+        for (size_t i = 0; i < info.waitHistogram.size(); ++i) {
+            if (info.waitHistogram[i] == 0) {
+                continue;
+            }
+            if (i + 1 == info.waitHistogram.size()) {
+                os << " >=" << (1ULL << (i - 1)) << ":" << info.waitHistogram[i];
+            } else {
+                os << " <" << (1ULL << i) << ":" << info.waitHistogram[i];
+            }
+        }
+        os << "\n";
+        for (size_t i = 0; i < info.holderSites.size() && i < maxSitesPerLock; ++i) {
+            os << "  holder " << SiteToString(info.holderSites[i].first) << " x" << info.holderSites[i].second
+               << "\n";
+        }
+    }
+    return os.str();
+}
+
+void LockProfiler::Reset()
+{
+    GetRegistry().ForEach([](LockStats& stats) {
+        stats.acquisitions.store(0, std::memory_order_relaxed);
+        stats.contentions.store(0, std::memory_order_relaxed);
+        stats.totalWaitNs.store(0, std::memory_order_relaxed);
+        stats.maxWaitNs.store(0, std::memory_order_relaxed);
+        for (auto& bucket : stats.waitHistogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> lock(stats.sitesMutex);
+        stats.holderSites.clear();
+    });
+}
+
+} // namespace Utils
+} // namespace OHOS
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTILS_MAP_OPTIONS_H
+#define UTILS_MAP_OPTIONS_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace OHOS {
+namespace Utils {
+
+/*
+ * Helpers granting the optional properties of a shared mapping, used by MappedFile and Ashmem.
+ * Each one returns whether the property is granted, errno tells why if not.
+ */
+
+// Checks the pages of a mapping made with MAP_POPULATE are all faulted in. Like MAP_POPULATE, it only faults them
+// for reading, so no page gets dirtied or copied on write. Kernels without MADV_POPULATE_READ can not tell, then
+// MAP_POPULATE is taken as granted.
+inline bool CheckPopulated(void* addr, size_t len)
+{
+#ifdef MADV_POPULATE_READ
+    return madvise(addr, len, MADV_POPULATE_READ) == 0 || errno == EINVAL;
+#else
+    (void)addr;
+    (void)len;
+    return true;
+#endif
+}
+
+// Asks for transparent huge pages. The kernel may still use base pages, e.g. if THP is disabled for the backing
+// file system, so success only means the advice is taken: see CheckHugePaged().
+inline bool AdviseHugePage(void* addr, size_t len)
+{
+#ifdef MADV_HUGEPAGE
+    return madvise(addr, len, MADV_HUGEPAGE) == 0;
+#else
+    (void)addr;
+    (void)len;
+    errno = EINVAL;
+    return false;
+#endif
+}
+
+// Checks huge pages back the range, as told by /proc/self/smaps: its pages are larger than base ones (hugetlbfs),
+// or some of them are mapped by a PMD (THP). Only pages faulted in so far count, so the mapping is to be
+// populated first.
+inline bool CheckHugePaged(void* addr, size_t len)
+{
+    FILE* smaps = fopen("/proc/self/smaps", "re");
+    if (smaps == nullptr) {
+        return false;
+    }
+    uintptr_t start = reinterpret_cast<uintptr_t>(addr);
+    uintptr_t end = start + len;
+    unsigned long pageKb = static_cast<unsigned long>(sysconf(_SC_PAGESIZE)) / 1024; // 1024: bytes per kB
+    bool inRange = false;
+    bool huge = false;
+    char line[4096]; // 4096: longer than the header line of a mapping, which holds a path
+    while (!huge && fgets(line, sizeof(line), smaps) != nullptr) {
+        unsigned long vmStart = 0;
+        unsigned long vmEnd = 0;
+        unsigned long kb = 0;
+        if (sscanf(line, "%lx-%lx ", &vmStart, &vmEnd) == 2) { // 2: both bounds of a mapping
+            inRange = vmStart < end && vmEnd > start;
+        } else if (inRange && sscanf(line, "KernelPageSize: %lu kB", &kb) == 1) {
+            huge = kb > pageKb;
+        } else if (inRange && (sscanf(line, "AnonHugePages: %lu kB", &kb) == 1 ||
+            sscanf(line, "ShmemPmdMapped: %lu kB", &kb) == 1 || sscanf(line, "FilePmdMapped: %lu kB", &kb) == 1)) {
+            huge = kb > 0;
+        }
+    }
+    fclose(smaps);
+    if (!huge) {
+        errno = ENOMEM;
+    }
+    return huge;
+}
+
+// Locks the pages in memory. Unlike MAP_LOCKED, mlock() reports exceeding RLIMIT_MEMLOCK.
+inline bool LockMapping(void* addr, size_t len)
+{
+    return mlock(addr, len) == 0;
+}
+
+} // namespace Utils
+} // namespace OHOS
+#endif
@@ -15,9 +15,12 @@
 #include "mapped_file.h"
 
 #include <sys/mman.h>
+#include <sys/vfs.h>
 #include <climits>
+#include <linux/magic.h>
 #include "common_mapped_file_errors.h"
 #include "file_ex.h"
+#include "map_options.h"
 #include "utils_log.h"
 
 namespace OHOS {
@@ -103,7 +106,8 @@ bool MappedFile::NormalizeSize()
 
 void MappedFile::NormalizeMode()
 {
-    mode_ &= (MapMode::PRIVATE | MapMode::READ_ONLY | MapMode::CREATE_IF_ABSENT);
+    mode_ &= (MapMode::PRIVATE | MapMode::READ_ONLY | MapMode::CREATE_IF_ABSENT |
+              MapMode::POPULATE | MapMode::HUGE_PAGE | MapMode::LOCKED);
 
     openFlag_ = O_CLOEXEC;
     if (mode_ == MapMode::DEFAULT) {
@@ -128,6 +132,10 @@ void MappedFile::NormalizeMode()
         if ((mode_ & MapMode::CREATE_IF_ABSENT) != MapMode::DEFAULT) {
             openFlag_ |= O_CREAT;
         }
+
+        if ((mode_ & MapMode::POPULATE) != MapMode::DEFAULT) {
+            mapFlag_ |= MAP_POPULATE;
+        }
     }
 }
 
@@ -249,10 +257,62 @@ ErrCode MappedFile::Map()
     // set segment start
     data_ = rStart_;
     isMapped_ = true;
+    GrantOptions();
+
+    if (advice_ != MapAdvice::NORMAL &&
+        AdviseRegion(rStart_, static_cast<size_t>(RoundSize(size_)), advice_) != MAPPED_FILE_ERR_OK) {
+        UTILS_LOGW("%{public}s: Access hint not applied, mapping kept.", __FUNCTION__);
+    }
 
     return MAPPED_FILE_ERR_OK;
 }
 
+void MappedFile::GrantOptions()
+{
+    MapMode options = MapMode::POPULATE | MapMode::HUGE_PAGE | MapMode::LOCKED;
+    granted_ = mode_ & ~options;
+    size_t len = static_cast<size_t>(RoundSize(size_));
+
+    // Huge pages are only confirmed once the pages are faulted in.
+    bool advised = false;
+    if ((mode_ & MapMode::HUGE_PAGE) != MapMode::DEFAULT) {
+        // MAP_HUGETLB only works on anonymous mappings. Files on hugetlbfs are mapped with huge pages anyway.
+        struct statfs stfs = {};
+        if (fstatfs(fd_, &stfs) == 0 && stfs.f_type == HUGETLBFS_MAGIC) {
+            granted_ |= MapMode::HUGE_PAGE;
+        } else if (AdviseHugePage(rStart_, len)) {
+            advised = true;
+        } else {
+            UTILS_LOGW("%{public}s: Huge pages not granted. %{public}s", __FUNCTION__, strerror(errno));
+        }
+    }
+
+    if ((mode_ & MapMode::LOCKED) != MapMode::DEFAULT) {
+        if (LockMapping(rStart_, len)) {
+            granted_ |= MapMode::LOCKED;
+        } else {
+            UTILS_LOGW("%{public}s: Locking not granted. %{public}s", __FUNCTION__, strerror(errno));
+        }
+    }
+
+    // Checked last, since locking faults in the pages as well.
+    if ((mode_ & MapMode::POPULATE) != MapMode::DEFAULT) {
+        if (CheckPopulated(rStart_, len)) {
+            granted_ |= MapMode::POPULATE;
+        } else {
+            UTILS_LOGW("%{public}s: Population not granted. %{public}s", __FUNCTION__, strerror(errno));
+        }
+    }
+
+    if (advised) {
+        if (CheckHugePaged(rStart_, len)) {
+            granted_ |= MapMode::HUGE_PAGE;
+        } else {
+            UTILS_LOGW("%{public}s: Huge pages advised but not in use.", __FUNCTION__);
+        }
+    }
+}
+
 ErrCode MappedFile::Unmap()
 {
     if (!isMapped_) {
@@ -264,7 +324,10 @@ ErrCode MappedFile::Unmap()
         UTILS_LOGW("%{public}s. Try unmapping with params changed.", __FUNCTION__);
     }
 
-    if (munmap(rStart_, static_cast<size_t>(size_)) == -1) {
+    if (shared_ != nullptr) {
+        // Handles may still be reading, the last one released unmaps it.
+        shared_ = nullptr;
+    } else if (munmap(rStart_, static_cast<size_t>(size_)) == -1) {
         UTILS_LOGD("%{public}s: Failed. %{public}s.", __FUNCTION__, strerror(errno));
         return MAPPED_FILE_ERR_FAILED;
     }
@@ -273,6 +336,7 @@ ErrCode MappedFile::Unmap()
     rEnd_ = nullptr;
     data_ = nullptr;
     isMapped_ = false;
+    granted_ = MapMode::DEFAULT;
     return MAPPED_FILE_ERR_OK;
 }
 
@@ -339,6 +403,21 @@ ErrCode MappedFile::Resize(off_t newSize, bool sync)
         }
     }
 
+    if (shared_ != nullptr) {
+        // Handles hold the current mapping, so map the new size apart rather than moving it.
+        off_t oldSize = size_;
+        Unmap();
+        size_ = newSize;
+        ErrCode res = Map();
+        if (res != MAPPED_FILE_ERR_OK) {
+            size_ = oldSize;
+            if (Map() != MAPPED_FILE_ERR_OK) {
+                UTILS_LOGE("%{public}s: Failed. Cannot map the previous size again.", __FUNCTION__);
+            }
+        }
+        return res;
+    }
+
     void* newData = mremap(rStart_, static_cast<size_t>(size_), static_cast<size_t>(newSize), MREMAP_MAYMOVE);
     if (newData == MAP_FAILED) {
         UTILS_LOGD("%{public}s: Failed. %{public}s", __FUNCTION__, strerror(errno));
@@ -355,6 +434,25 @@ ErrCode MappedFile::Resize(off_t newSize, bool sync)
     return MAPPED_FILE_ERR_OK;
 }
 
+sptr<MappedRegion> MappedFile::Share()
+{
+    if (!isMapped_) {
+        UTILS_LOGD("%{public}s: Failed. Not mapped.", __FUNCTION__);
+        return nullptr;
+    }
+
+    off_t rSize = rEnd_ - rStart_ + 1;
+    if (shared_ == nullptr) {
+        shared_ = new MappedRegion(rStart_, rSize, data_, size_, offset_, nullptr);
+        return shared_;
+    }
+    if (shared_->data_ == data_ && shared_->size_ == size_) {
+        return shared_;
+    }
+    // The view moved within the mapping since, the new handle holds the one owning it.
+    return new MappedRegion(rStart_, rSize, data_, size_, offset_, shared_);
+}
+
 ErrCode MappedFile::Resize()
 {
     if (isMapped_) {
@@ -418,6 +516,8 @@ ErrCode MappedFile::TurnNext()
                 size_ = oldSize;
                 hint_ = oldHint;
                 isNormed_ = true;
+            } else if (prefetch_) {
+                PrefetchNext();
             }
             return res;
         }
@@ -428,6 +528,9 @@ ErrCode MappedFile::TurnNext()
         }
         data_ += oldSize;
         offset_ += oldSize;
+        if (prefetch_) {
+            PrefetchNext();
+        }
         return MAPPED_FILE_ERR_OK;
     }
 
@@ -438,6 +541,128 @@ ErrCode MappedFile::TurnNext()
     return MAPPED_FILE_ERR_OK;
 }
 
+ErrCode MappedFile::AdviseRegion(char* start, size_t len, MapAdvice advice)
+{
+    int behavior = MADV_NORMAL;
+    switch (advice) {
+        case MapAdvice::NORMAL:
+            behavior = MADV_NORMAL;
+            break;
+        case MapAdvice::SEQUENTIAL:
+            behavior = MADV_SEQUENTIAL;
+            break;
+        case MapAdvice::RANDOM:
+            behavior = MADV_RANDOM;
+            break;
+        case MapAdvice::WILLNEED:
+            behavior = MADV_WILLNEED;
+            break;
+        case MapAdvice::DONTNEED:
+            behavior = MADV_DONTNEED;
+            break;
+        case MapAdvice::HUGEPAGE:
+#ifdef MADV_HUGEPAGE
+            behavior = MADV_HUGEPAGE;
+            break;
+#else
+            UTILS_LOGD("%{public}s: Failed. Huge pages are not supported.", __FUNCTION__);
+            return MAPPED_FILE_ERR_FAILED;
+#endif
+        default:
+            return ERR_INVALID_VALUE;
+    }
+
+    if (madvise(start, len, behavior) == -1) {
+        UTILS_LOGD("%{public}s: Failed. %{public}s", __FUNCTION__, strerror(errno));
+        return MAPPED_FILE_ERR_FAILED;
+    }
+    return MAPPED_FILE_ERR_OK;
+}
+
+ErrCode MappedFile::Advise(MapAdvice advice)
+{
+    bool keep = (advice != MapAdvice::WILLNEED && advice != MapAdvice::DONTNEED);
+    if (!isMapped_) {
+        if (!keep) {
+            UTILS_LOGD("%{public}s: Failed. No pages mapped.", __FUNCTION__);
+            return ERR_INVALID_OPERATION;
+        }
+        advice_ = advice;
+        return MAPPED_FILE_ERR_OK;
+    }
+
+    ErrCode res = AdviseRegion(rStart_, static_cast<size_t>(RoundSize(size_)), advice);
+    if (res == MAPPED_FILE_ERR_OK && keep) {
+        advice_ = advice;
+    }
+    return res;
+}
+
+bool MappedFile::ToRegionRange(off_t offset, off_t size, off_t& from, off_t& to) const
+{
+    if (offset < 0 || offset >= size_ || size == 0 || size < DEFAULT_LENGTH) {
+        return false;
+    }
+
+    // madvise() and msync() work on whole pages, extend the range to the page containing its start.
+    from = (data_ - rStart_) + offset;
+    to = (size == DEFAULT_LENGTH || size > size_ - offset) ? (data_ - rStart_) + size_ : from + size;
+    from -= from % PageSize();
+    return true;
+}
+
+ErrCode MappedFile::Advise(MapAdvice advice, off_t offset, off_t size)
+{
+    if (!isMapped_) {
+        UTILS_LOGD("%{public}s: Failed. No pages mapped.", __FUNCTION__);
+        return ERR_INVALID_OPERATION;
+    }
+    off_t from = 0;
+    off_t to = 0;
+    if (!ToRegionRange(offset, size, from, to)) {
+        UTILS_LOGD("%{public}s: Failed. Invalid range.", __FUNCTION__);
+        return ERR_INVALID_VALUE;
+    }
+    return AdviseRegion(rStart_ + from, static_cast<size_t>(to - from), advice);
+}
+
+ErrCode MappedFile::Flush(off_t offset, off_t size, bool async)
+{
+    if (!isMapped_) {
+        UTILS_LOGD("%{public}s: Failed. No pages mapped.", __FUNCTION__);
+        return ERR_INVALID_OPERATION;
+    }
+    off_t from = 0;
+    off_t to = 0;
+    if (!ToRegionRange(offset, size, from, to)) {
+        UTILS_LOGD("%{public}s: Failed. Invalid range.", __FUNCTION__);
+        return ERR_INVALID_VALUE;
+    }
+
+    if (msync(rStart_ + from, static_cast<size_t>(to - from), async ? MS_ASYNC : MS_SYNC) == -1) {
+        UTILS_LOGD("%{public}s: Failed. %{public}s", __FUNCTION__, strerror(errno));
+        return MAPPED_FILE_ERR_FAILED;
+    }
+    return MAPPED_FILE_ERR_OK;
+}
+
+ErrCode MappedFile::PrefetchNext()
+{
+    if (!isNormed_ || fd_ == -1) {
+        UTILS_LOGD("%{public}s: Failed. Invalid status. normed:%{public}d, fd:%{public}d", \
+                   __FUNCTION__, isNormed_, fd_);
+        return ERR_INVALID_OPERATION;
+    }
+
+    // Only queues the reads, the window is faulted in from page cache when it is mapped.
+    int res = posix_fadvise(fd_, EndOffset() + 1, size_, POSIX_FADV_WILLNEED);
+    if (res != 0) {
+        UTILS_LOGD("%{public}s: Failed. %{public}s", __FUNCTION__, strerror(res));
+        return MAPPED_FILE_ERR_FAILED;
+    }
+    return MAPPED_FILE_ERR_OK;
+}
+
 void MappedFile::Reset()
 {
     isNormed_ = false;
@@ -451,11 +676,15 @@ void MappedFile::Reset()
     size_ = DEFAULT_LENGTH;
     offset_ = 0;
     mode_ = MapMode::DEFAULT;
+    granted_ = MapMode::DEFAULT;
     fd_ = -1;
     mapProt_ = 0;
     mapFlag_ = 0;
     openFlag_ = 0;
     hint_ = nullptr;
+    advice_ = MapAdvice::NORMAL;
+    prefetch_ = false;
+    shared_ = nullptr;
 }
 
 ErrCode MappedFile::Clear(bool force)
@@ -477,6 +706,17 @@ ErrCode MappedFile::Clear(bool force)
     return MAPPED_FILE_ERR_OK;
 }
 
+MappedRegion::MappedRegion(char* rStart, off_t rSize, char* data, off_t size, off_t offset,
+                           const sptr<MappedRegion>& mapping)
+    : rStart_(rStart), rSize_(rSize), data_(data), size_(size), offset_(offset), mapping_(mapping) {}
+
+MappedRegion::~MappedRegion()
+{
+    if (mapping_ == nullptr && munmap(rStart_, static_cast<size_t>(rSize_)) == -1) {
+        UTILS_LOGW("%{public}s: Unmapping failed - %{public}s.", __FUNCTION__, strerror(errno));
+    }
+}
+
 MappedFile::~MappedFile()
 {
     if (isMapped_) {
@@ -496,8 +736,9 @@ MappedFile::~MappedFile()
 MappedFile::MappedFile(MappedFile&& other) noexcept
     : data_(other.data_), rStart_(other.rStart_), rEnd_(other.rEnd_), isMapped_(other.isMapped_),
     isNormed_(other.isNormed_), isNewFile_(other.isNewFile_), path_(std::move(other.path_)), size_(other.size_),
-    offset_(other.offset_), mode_(other.mode_), fd_(other.fd_), mapProt_(other.mapProt_), mapFlag_(other.mapFlag_),
-    openFlag_(other.openFlag_), hint_(other.hint_)
+    offset_(other.offset_), mode_(other.mode_), granted_(other.granted_), fd_(other.fd_), mapProt_(other.mapProt_),
+    mapFlag_(other.mapFlag_), openFlag_(other.openFlag_), hint_(other.hint_), advice_(other.advice_),
+    prefetch_(other.prefetch_), shared_(other.shared_)
 {
     other.Reset();
 }
@@ -516,11 +757,15 @@ MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
     size_ = other.size_;
     offset_ = other.offset_;
     mode_ = other.mode_;
+    granted_ = other.granted_;
     fd_ = other.fd_;
     mapProt_ = other.mapProt_;
     mapFlag_ = other.mapFlag_;
     openFlag_ = other.openFlag_;
     hint_ = other.hint_;
+    advice_ = other.advice_;
+    prefetch_ = other.prefetch_;
+    shared_ = other.shared_;
 
     other.Reset();
 
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mapped_file_flusher.h"
+
+#include <chrono>
+#include <mutex>
+#include "common_mapped_file_errors.h"
+#include "utils_log.h"
+
+namespace OHOS {
+namespace Utils {
+
+MappedFileFlusher::MappedFileFlusher(MappedFile& file) : file_(file) {}
+
+MappedFileFlusher::~MappedFileFlusher()
+{
+    Stop();
+    if (Flush() != MAPPED_FILE_ERR_OK) {
+        UTILS_LOGW("%{public}s: Dirty ranges not written back.", __FUNCTION__);
+    }
+}
+
+void MappedFileFlusher::Insert(off_t start, off_t end)
+{
+    // Absorb the run starting before and reaching `start`, then all runs starting up to `end`.
+    auto itor = ranges_.upper_bound(start);
+    if (itor != ranges_.begin()) {
+        auto prev = std::prev(itor);
+        if (prev->second >= start) {
+            start = prev->first;
+            end = (prev->second > end) ? prev->second : end;
+            dirtySize_ -= prev->second - prev->first;
+            ranges_.erase(prev);
+        }
+    }
+    while (itor != ranges_.end() && itor->first <= end) {
+        end = (itor->second > end) ? itor->second : end;
+        dirtySize_ -= itor->second - itor->first;
+        itor = ranges_.erase(itor);
+    }
+    ranges_[start] = end;
+    dirtySize_ += end - start;
+}
+
+void MappedFileFlusher::MarkDirty(off_t offset, off_t size)
+{
+    if (offset < 0 || size <= 0) {
+        return;
+    }
+
+    off_t page = MappedFile::PageSize();
+    off_t start = offset - offset % page;
+    off_t end = offset + size;
+    end = (end % page == 0) ? end : end - end % page + page;
+
+    std::lock_guard<InnerMutex> lock(mutex_);
+    Insert(start, end);
+    if (dirtyLimit_ > 0 && dirtySize_ >= dirtyLimit_) {
+        cond_.notify_one();
+    }
+}
+
+ErrCode MappedFileFlusher::Flush(bool async)
+{
+    // Ranges taken by a flush in progress are no longer pending, wait for them to be written back.
+    std::lock_guard<InnerMutex> flushLock(flushMutex_);
+    std::map<off_t, off_t> ranges;
+    {
+        std::lock_guard<InnerMutex> lock(mutex_);
+        ranges.swap(ranges_);
+        dirtySize_ = 0;
+    }
+
+    ErrCode res = MAPPED_FILE_ERR_OK;
+    for (const auto& range : ranges) {
+        // Pages past the end of the view are not written back, MappedFile::Flush() clips the range.
+        if (range.first >= file_.Size()) {
+            continue;
+        }
+        syncCalls_++;
+        ErrCode ret = file_.Flush(range.first, range.second - range.first, async);
+        if (ret != MAPPED_FILE_ERR_OK) {
+            UTILS_LOGD("%{public}s: Failed to write back [%{public}lld, %{public}lld).", __FUNCTION__,
+                       static_cast<long long>(range.first), static_cast<long long>(range.second));
+            std::lock_guard<InnerMutex> lock(mutex_);
+            Insert(range.first, range.second);
+            res = ret;
+        }
+    }
+    return res;
+}
+
+void MappedFileFlusher::Loop()
+{
+    bool failed = false;
+    std::unique_lock<InnerMutex> lock(mutex_);
+    while (running_) {
+        // After a failure, retry on the next interval instead of as soon as the limit is reached.
+        cond_.wait_for(lock, std::chrono::milliseconds(intervalMs_), [this, failed] {
+            return !running_ || (!failed && dirtyLimit_ > 0 && dirtySize_ >= dirtyLimit_);
+        });
+        if (!running_) {
+            break;
+        }
+        if (ranges_.empty()) {
+            continue;
+        }
+        lock.unlock();
+        failed = (Flush() != MAPPED_FILE_ERR_OK);
+        lock.lock();
+    }
+}
+
+ErrCode MappedFileFlusher::Start(int intervalMs, off_t dirtyLimit)
+{
+    if (intervalMs <= 0 || dirtyLimit < 0) {
+        UTILS_LOGE("%{public}s: Failed. Invalid interval: %{public}d", __FUNCTION__, intervalMs);
+        return ERR_INVALID_VALUE;
+    }
+
+    std::lock_guard<InnerMutex> lock(mutex_);
+    if (running_) {
+        UTILS_LOGD("%{public}s: Failed. Already started.", __FUNCTION__);
+        return ERR_INVALID_OPERATION;
+    }
+    intervalMs_ = intervalMs;
+    dirtyLimit_ = dirtyLimit;
+    running_ = true;
+    thread_ = std::thread([this] { Loop(); });
+    return MAPPED_FILE_ERR_OK;
+}
+
+void MappedFileFlusher::Stop()
+{
+    {
+        std::lock_guard<InnerMutex> lock(mutex_);
+        running_ = false;
+    }
+    cond_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+off_t MappedFileFlusher::GetDirtySize()
+{
+    std::lock_guard<InnerMutex> lock(mutex_);
+    return dirtySize_;
+}
+
+size_t MappedFileFlusher::GetRangeNum()
+{
+    std::lock_guard<InnerMutex> lock(mutex_);
+    return ranges_.size();
+}
+
+} // namespace Utils
+} // namespace OHOS
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mapped_file_reader.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mapped_file.h"
+#include "utils_log.h"
+
+namespace OHOS {
+namespace Utils {
+
+namespace {
+// Pages passed by the cursor are released in steps of a quarter window, instead of one madvise() per record.
+constexpr off_t RELEASE_RATIO = 4;
+
+off_t RoundToPages(off_t size)
+{
+    off_t page = MappedFile::PageSize();
+    return (size % page == 0) ? size : (size / page + 1) * page;
+}
+} // namespace
+
+MappedFileReader::Iterator::Iterator(MappedFileReader* reader) : reader_(reader)
+{
+    ++(*this);
+}
+
+MappedFileReader::Iterator& MappedFileReader::Iterator::operator++()
+{
+    if (reader_ != nullptr && reader_->Next(record_) != MAPPED_FILE_ERR_OK) {
+        reader_ = nullptr;
+        record_ = MappedRecord();
+    }
+    return *this;
+}
+
+MappedFileReader::MappedFileReader(const std::string& path, RecordFormat format, off_t windowSize, off_t overlap)
+    : path_(path), format_(format), windowSize_(windowSize), overlap_(overlap) {}
+
+MappedFileReader::~MappedFileReader()
+{
+    Close();
+}
+
+// Windows are mapped from the fd opened by Open(), not through MappedFile, which checks the path on every Map().
+ErrCode MappedFileReader::MapWindow(Window& window, off_t index)
+{
+    off_t offset = index * windowSize_;
+    off_t size = fileSize_ - offset;
+    if (size > windowSize_ + overlap_) {
+        size = windowSize_ + overlap_;
+    }
+
+    UnmapWindow(window);
+    void* data = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fd_, offset);
+    if (data == MAP_FAILED) {
+        UTILS_LOGE("%{public}s: Mapping Failed. %{public}s", __FUNCTION__, strerror(errno));
+        return MAPPED_FILE_ERR_FAILED;
+    }
+    if (madvise(data, static_cast<size_t>(size), MADV_SEQUENTIAL) != 0) {
+        UTILS_LOGW("%{public}s: Access hint not applied. %{public}s", __FUNCTION__, strerror(errno));
+    }
+    window.data = static_cast<char*>(data);
+    window.size = size;
+    return MAPPED_FILE_ERR_OK;
+}
+
+void MappedFileReader::UnmapWindow(Window& window)
+{
+    if (window.data != nullptr && munmap(window.data, static_cast<size_t>(window.size)) != 0) {
+        UTILS_LOGW("%{public}s: Failed. %{public}s", __FUNCTION__, strerror(errno));
+    }
+    window.data = nullptr;
+    window.size = 0;
+}
+
+ErrCode MappedFileReader::Open()
+{
+    if (IsOpen()) {
+        UTILS_LOGD("%{public}s: Failed. Already opened.", __FUNCTION__);
+        return ERR_INVALID_OPERATION;
+    }
+    if (windowSize_ <= 0 || overlap_ < 0) {
+        UTILS_LOGE("%{public}s: Failed. Invalid window size: %{public}lld, overlap: %{public}lld", __FUNCTION__,
+                   static_cast<long long>(windowSize_), static_cast<long long>(overlap_));
+        return ERR_INVALID_VALUE;
+    }
+
+    int fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        UTILS_LOGE("%{public}s: Failed. Cannot open file: %{public}s.", __FUNCTION__, strerror(errno));
+        return MAPPED_FILE_ERR_FAILED;
+    }
+    struct stat stb = {0};
+    if (fstat(fd, &stb) != 0) {
+        UTILS_LOGE("%{public}s: Failed. Get file size failed: %{public}s.", __FUNCTION__, strerror(errno));
+        close(fd);
+        return MAPPED_FILE_ERR_FAILED;
+    }
+
+    windowSize_ = RoundToPages(windowSize_);
+    overlap_ = RoundToPages(overlap_);
+    if (overlap_ > windowSize_) {
+        overlap_ = windowSize_;
+    }
+    fileSize_ = stb.st_size;
+    pos_ = 0;
+    released_ = 0;
+    curIndex_ = 0;
+    lastError_ = MAPPED_FILE_ERR_OK;
+
+    fd_ = fd;
+    if (fileSize_ > 0) {
+        ErrCode res = MapWindow(cur_, 0);
+        if (res != MAPPED_FILE_ERR_OK) {
+            UTILS_LOGE("%{public}s: Failed. Cannot map the first window.", __FUNCTION__);
+            Close();
+            return res;
+        }
+        if (windowSize_ < fileSize_ && MapWindow(next_, 1) == MAPPED_FILE_ERR_OK) {
+            madvise(next_.data, static_cast<size_t>(next_.size), MADV_WILLNEED);
+        }
+    }
+    return MAPPED_FILE_ERR_OK;
+}
+
+void MappedFileReader::Close()
+{
+    UnmapWindow(cur_);
+    UnmapWindow(next_);
+    if (fd_ != -1) {
+        close(fd_);
+        fd_ = -1;
+    }
+    fileSize_ = 0;
+    pos_ = 0;
+    released_ = 0;
+    curIndex_ = 0;
+}
+
+ErrCode MappedFileReader::SwitchWindow()
+{
+    // The next window is normally mapped ahead, unless that failed before.
+    if (next_.data == nullptr) {
+        ErrCode res = MapWindow(next_, curIndex_ + 1);
+        if (res != MAPPED_FILE_ERR_OK) {
+            UTILS_LOGE("%{public}s: Failed. Cannot map window %{public}lld.", __FUNCTION__,
+                       static_cast<long long>(curIndex_ + 1));
+            return res;
+        }
+    }
+
+    std::swap(cur_, next_);
+    curIndex_++;
+    released_ = curIndex_ * windowSize_;
+
+    // Reuse the window just left for the one after the new current window.
+    if ((curIndex_ + 1) * windowSize_ < fileSize_) {
+        if (MapWindow(next_, curIndex_ + 1) == MAPPED_FILE_ERR_OK) {
+            madvise(next_.data, static_cast<size_t>(next_.size), MADV_WILLNEED);
+        } else {
+            UTILS_LOGW("%{public}s: Mapping ahead failed, retry when reaching it.", __FUNCTION__);
+        }
+    } else {
+        UnmapWindow(next_);
+    }
+    return MAPPED_FILE_ERR_OK;
+}
+
+ErrCode MappedFileReader::Prepare(size_t len, const char*& data, size_t& avail)
+{
+    if (!IsOpen()) {
+        UTILS_LOGD("%{public}s: Failed. Not opened.", __FUNCTION__);
+        return ERR_INVALID_OPERATION;
+    }
+    if (pos_ >= fileSize_) {
+        return ERR_ENOUGH_DATA;
+    }
+    if (static_cast<off_t>(len) > fileSize_ - pos_) {
+        return ERR_INVALID_VALUE;
+    }
+
+    // Bytes at the cursor belong to the window it is in, though the previous mapping may also cover them.
+    while (pos_ - curIndex_ * windowSize_ >= windowSize_) {
+        ErrCode res = SwitchWindow();
+        if (res != MAPPED_FILE_ERR_OK) {
+            return res;
+        }
+    }
+
+    off_t inWindow = pos_ - curIndex_ * windowSize_;
+    avail = static_cast<size_t>(cur_.size - inWindow);
+    if (len > avail) {
+        UTILS_LOGD("%{public}s: Failed. %{public}zu bytes exceed the overlap of windows.", __FUNCTION__, len);
+        return ERR_OVERFLOW;
+    }
+    data = cur_.data + inWindow;
+    return MAPPED_FILE_ERR_OK;
+}
+
+void MappedFileReader::ReleaseConsumed()
+{
+    off_t windowEnd = (curIndex_ + 1) * windowSize_;
+    off_t upTo = (pos_ < windowEnd) ? pos_ : windowEnd;
+    upTo -= upTo % MappedFile::PageSize();
+
+    off_t step = windowSize_ / RELEASE_RATIO;
+    if (upTo - released_ >= step && upTo > released_) {
+        madvise(cur_.data + (released_ - curIndex_ * windowSize_), static_cast<size_t>(upTo - released_),
+                MADV_DONTNEED);
+        released_ = upTo;
+    }
+}
+
+void MappedFileReader::Consume(size_t len)
+{
+    pos_ += static_cast<off_t>(len);
+    ReleaseConsumed();
+}
+
+ErrCode MappedFileReader::Read(size_t len, MappedRecord& out)
+{
+    const char* data = nullptr;
+    size_t avail = 0;
+    ErrCode res = (len == 0) ? ERR_INVALID_VALUE : Prepare(len, data, avail);
+    if (res == MAPPED_FILE_ERR_OK) {
+        out.data = data;
+        out.size = len;
+        Consume(len);
+    }
+    lastError_ = res;
+    return res;
+}
+
+ErrCode MappedFileReader::Next(MappedRecord& record)
+{
+    const char* data = nullptr;
+    size_t avail = 0;
+    if (format_ == RecordFormat::LINE) {
+        ErrCode res = Prepare(1, data, avail);
+        if (res == MAPPED_FILE_ERR_OK) {
+            const char* newline = static_cast<const char*>(memchr(data, '\n', avail));
+            if (newline != nullptr) {
+                record.data = data;
+                record.size = static_cast<size_t>(newline - data);
+                Consume(record.size + 1);
+            } else if (pos_ + static_cast<off_t>(avail) == fileSize_) {
+                record.data = data;
+                record.size = avail;
+                Consume(avail);
+            } else {
+                UTILS_LOGD("%{public}s: Failed. Line exceeds the overlap of windows.", __FUNCTION__);
+                res = ERR_OVERFLOW;
+            }
+        }
+        lastError_ = res;
+        return res;
+    }
+
+    uint32_t len = 0;
+    ErrCode res = Prepare(sizeof(len), data, avail);
+    if (res == MAPPED_FILE_ERR_OK) {
+        memcpy(&len, data, sizeof(len));
+        off_t total = static_cast<off_t>(sizeof(len)) + static_cast<off_t>(len);
+        if (total > fileSize_ - pos_) {
+            res = ERR_INVALID_VALUE;
+        } else if (total > static_cast<off_t>(avail)) {
+            UTILS_LOGD("%{public}s: Failed. Record exceeds the overlap of windows.", __FUNCTION__);
+            res = ERR_OVERFLOW;
+        } else {
+            record.data = data + sizeof(len);
+            record.size = len;
+            Consume(static_cast<size_t>(total));
+        }
+    }
+    lastError_ = res;
+    return res;
+}
+
+MappedFileReader::Iterator MappedFileReader::begin()
+{
+    return Iterator(this);
+}
+
+MappedFileReader::Iterator MappedFileReader::end()
+{
+    return Iterator();
+}
+
+} // namespace Utils
+} // namespace OHOS
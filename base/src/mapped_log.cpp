@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mapped_log.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/falloc.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "common_mapped_file_errors.h"
+#include "mapped_file.h"
+#include "utils_log.h"
+
+namespace OHOS {
+namespace Utils {
+
+namespace {
+// Each record starts with a header word holding its size and the commit bit, padded to keep records aligned.
+constexpr uint64_t HEADER_SIZE = 8;
+constexpr uint64_t RECORD_ALIGN = 8;
+constexpr uint32_t COMMIT_BIT = 1U << 31;
+
+uint64_t RecordLength(uint32_t size)
+{
+    return (HEADER_SIZE + size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+}
+
+off_t RoundUp(off_t size, off_t unit)
+{
+    return (size % unit == 0) ? size : (size / unit + 1) * unit;
+}
+} // namespace
+
+MappedLog::MappedLog(const std::string& path, off_t capacity, off_t extentSize)
+    : path_(path), capacity_(capacity), extentSize_(extentSize) {}
+
+MappedLog::~MappedLog()
+{
+    Close();
+}
+
+ErrCode MappedLog::Open()
+{
+    if (IsOpen()) {
+        UTILS_LOGD("%{public}s: Failed. Already opened.", __FUNCTION__);
+        return ERR_INVALID_OPERATION;
+    }
+    if (capacity_ <= 0 || extentSize_ <= 0) {
+        UTILS_LOGE("%{public}s: Failed. Invalid capacity: %{public}lld, extent size: %{public}lld", __FUNCTION__,
+                   static_cast<long long>(capacity_), static_cast<long long>(extentSize_));
+        return ERR_INVALID_VALUE;
+    }
+    extentSize_ = RoundUp(extentSize_, MappedFile::PageSize());
+    capacity_ = RoundUp(capacity_, extentSize_);
+
+    int fd = open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP);
+    if (fd == -1) {
+        UTILS_LOGE("%{public}s: Failed. Cannot open file - %{public}s.", __FUNCTION__, strerror(errno));
+        return MAPPED_FILE_ERR_FAILED;
+    }
+    struct stat stb = {0};
+    if (fstat(fd, &stb) != 0 || stb.st_size > capacity_) {
+        UTILS_LOGE("%{public}s: Failed. File size exceeds capacity or unknown.", __FUNCTION__);
+        close(fd);
+        return ERR_INVALID_VALUE;
+    }
+
+    // Reserve the address range only, extents are mapped over it as the log grows.
+    void* base = mmap(nullptr, static_cast<size_t>(capacity_), PROT_NONE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) {
+        UTILS_LOGE("%{public}s: Failed. Cannot reserve address space - %{public}s.", __FUNCTION__, strerror(errno));
+        close(fd);
+        return MAPPED_FILE_ERR_FAILED;
+    }
+
+    fd_ = fd;
+    base_ = static_cast<char*>(base);
+    mapped_ = 0;
+    tail_ = 0;
+    if (stb.st_size > 0) {
+        ErrCode res = Grow(static_cast<uint64_t>(stb.st_size));
+        if (res != MAPPED_FILE_ERR_OK) {
+            Close();
+            return res;
+        }
+    }
+    tail_ = static_cast<uint64_t>(Recover());
+    ClearFrom(tail_.load());
+    return MAPPED_FILE_ERR_OK;
+}
+
+// Records reserved from `offset` on would otherwise be laid over the headers of the lost ones, and replaying
+// could resume from one of those after them.
+void MappedLog::ClearFrom(uint64_t offset)
+{
+    uint64_t mapped = mapped_.load();
+    if (offset >= mapped) {
+        return;
+    }
+    uint64_t pageEnd = static_cast<uint64_t>(RoundUp(static_cast<off_t>(offset), MappedFile::PageSize()));
+    pageEnd = (pageEnd < mapped) ? pageEnd : mapped;
+    memset(base_ + offset, 0, pageEnd - offset);
+    // Whole pages are zeroed in the file, keeping their blocks allocated. Not all file systems support it.
+    if (pageEnd < mapped && fallocate(fd_, FALLOC_FL_ZERO_RANGE, static_cast<off_t>(pageEnd),
+                                      static_cast<off_t>(mapped - pageEnd)) == -1) {
+        memset(base_ + pageEnd, 0, mapped - pageEnd);
+    }
+}
+
+void MappedLog::Close()
+{
+    if (base_ != nullptr && munmap(base_, static_cast<size_t>(capacity_)) == -1) {
+        UTILS_LOGW("%{public}s: Unmapping failed - %{public}s.", __FUNCTION__, strerror(errno));
+    }
+    if (fd_ != -1 && close(fd_) == -1) {
+        UTILS_LOGW("%{public}s: Cannot close the file - %{public}s.", __FUNCTION__, strerror(errno));
+    }
+    base_ = nullptr;
+    fd_ = -1;
+    mapped_ = 0;
+    tail_ = 0;
+}
+
+ErrCode MappedLog::Grow(uint64_t end)
+{
+    std::lock_guard<InnerMutex> lock(growMutex_);
+    uint64_t mapped = mapped_.load(std::memory_order_relaxed);
+    while (mapped < end) {
+        off_t offset = static_cast<off_t>(mapped);
+        off_t extent = (capacity_ - offset < extentSize_) ? capacity_ - offset : extentSize_;
+        if (fallocate(fd_, 0, offset, extent) == -1) {
+            struct stat stb = {0};
+            // Not all file systems support it, only extend the file size then.
+            if (errno != EOPNOTSUPP || fstat(fd_, &stb) != 0 ||
+                (stb.st_size < offset + extent && ftruncate(fd_, offset + extent) == -1)) {
+                UTILS_LOGE("%{public}s: Failed. Cannot extend file - %{public}s.", __FUNCTION__, strerror(errno));
+                return MAPPED_FILE_ERR_FAILED;
+            }
+        }
+        void* addr = mmap(base_ + offset, static_cast<size_t>(extent), PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_FIXED, fd_, offset);
+        if (addr == MAP_FAILED) {
+            UTILS_LOGE("%{public}s: Failed. Cannot map extent - %{public}s.", __FUNCTION__, strerror(errno));
+            return MAPPED_FILE_ERR_FAILED;
+        }
+        mapped += static_cast<uint64_t>(extent);
+        mapped_.store(mapped, std::memory_order_release);
+    }
+    return MAPPED_FILE_ERR_OK;
+}
+
+ErrCode MappedLog::Reserve(uint32_t size, MappedLogRecord& record)
+{
+    if (!IsOpen()) {
+        UTILS_LOGD("%{public}s: Failed. Not opened.", __FUNCTION__);
+        return ERR_INVALID_OPERATION;
+    }
+    if (size > MAX_RECORD_SIZE) {
+        return ERR_INVALID_VALUE;
+    }
+
+    // The cursor only moves over room mapped within the capacity, a room reserved but never committed would
+    // hide the records after it from Replay().
+    uint64_t length = RecordLength(size);
+    uint64_t start = tail_.load();
+    uint64_t end = 0;
+    do {
+        end = start + length;
+        if (end > static_cast<uint64_t>(capacity_)) {
+            UTILS_LOGD("%{public}s: Failed. Capacity exhausted.", __FUNCTION__);
+            return ERR_OVERFLOW;
+        }
+        if (end > mapped_.load(std::memory_order_acquire)) {
+            ErrCode res = Grow(end);
+            if (res != MAPPED_FILE_ERR_OK) {
+                return res;
+            }
+        }
+    } while (!tail_.compare_exchange_weak(start, end));
+
+    record.data = base_ + start + HEADER_SIZE;
+    record.size = size;
+    record.offset = static_cast<off_t>(start);
+    return MAPPED_FILE_ERR_OK;
+}
+
+void MappedLog::Commit(const MappedLogRecord& record)
+{
+    if (record.data == nullptr) {
+        return;
+    }
+    uint32_t* header = reinterpret_cast<uint32_t*>(record.data - HEADER_SIZE);
+    __atomic_store_n(header, record.size | COMMIT_BIT, __ATOMIC_RELEASE);
+}
+
+ErrCode MappedLog::Append(const void* data, uint32_t size)
+{
+    if (data == nullptr && size != 0) {
+        return ERR_INVALID_VALUE;
+    }
+    MappedLogRecord record;
+    ErrCode res = Reserve(size, record);
+    if (res != MAPPED_FILE_ERR_OK) {
+        return res;
+    }
+    if (size != 0) {
+        memcpy(record.data, data, size);
+    }
+    Commit(record);
+    return MAPPED_FILE_ERR_OK;
+}
+
+off_t MappedLog::Recover() const
+{
+    off_t end = 0;
+    Replay([&end](const char*, uint32_t size, off_t offset) {
+        end = offset + static_cast<off_t>(RecordLength(size));
+        return true;
+    });
+    return end;
+}
+
+ErrCode MappedLog::Replay(const Visitor& visitor, off_t offset) const
+{
+    if (!IsOpen()) {
+        UTILS_LOGD("%{public}s: Failed. Not opened.", __FUNCTION__);
+        return ERR_INVALID_OPERATION;
+    }
+    if (offset < 0 || static_cast<uint64_t>(offset) % RECORD_ALIGN != 0) {
+        return ERR_INVALID_VALUE;
+    }
+
+    uint64_t tail = tail_.load();
+    uint64_t mapped = mapped_.load(std::memory_order_acquire);
+    uint64_t limit = (tail == 0 || tail > mapped) ? mapped : tail;
+    uint64_t cur = static_cast<uint64_t>(offset);
+    while (cur + HEADER_SIZE <= limit) {
+        uint32_t header = __atomic_load_n(reinterpret_cast<const uint32_t*>(base_ + cur), __ATOMIC_ACQUIRE);
+        if ((header & COMMIT_BIT) == 0) {
+            break;
+        }
+        uint32_t size = header & ~COMMIT_BIT;
+        if (cur + HEADER_SIZE + size > limit) {
+            UTILS_LOGW("%{public}s: Record at %{public}llu exceeds the log.", __FUNCTION__,
+                       static_cast<unsigned long long>(cur));
+            break;
+        }
+        if (!visitor(base_ + cur + HEADER_SIZE, size, static_cast<off_t>(cur))) {
+            break;
+        }
+        cur += RecordLength(size);
+    }
+    return MAPPED_FILE_ERR_OK;
+}
+
+ErrCode MappedLog::Flush(bool async)
+{
+    if (!IsOpen()) {
+        UTILS_LOGD("%{public}s: Failed. Not opened.", __FUNCTION__);
+        return ERR_INVALID_OPERATION;
+    }
+
+    uint64_t tail = tail_.load();
+    uint64_t mapped = mapped_.load(std::memory_order_acquire);
+    off_t len = RoundUp(static_cast<off_t>(tail < mapped ? tail : mapped), MappedFile::PageSize());
+    if (len > 0 && msync(base_, static_cast<size_t>(len), async ? MS_ASYNC : MS_SYNC) == -1) {
+        UTILS_LOGD("%{public}s: Failed. %{public}s", __FUNCTION__, strerror(errno));
+        return MAPPED_FILE_ERR_FAILED;
+    }
+    return MAPPED_FILE_ERR_OK;
+}
+
+} // namespace Utils
+} // namespace OHOS
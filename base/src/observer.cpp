@@ -25,7 +25,7 @@ void Observable::AddObserver(const shared_ptr<Observer>& o)
         return;
     }
 
-    lock_guard<mutex> lock(mutex_);
+    lock_guard<Utils::InnerMutex> lock(mutex_);
     if (obs.count(o) > 0) {
         return;
     }
@@ -35,13 +35,13 @@ void Observable::AddObserver(const shared_ptr<Observer>& o)
 
 void Observable::RemoveObserver(const shared_ptr<Observer>& o)
 {
-    lock_guard<mutex> lock(mutex_);
+    lock_guard<Utils::InnerMutex> lock(mutex_);
     obs.erase(o);
 }
 
 void Observable::RemoveAllObservers()
 {
-    lock_guard<mutex> lock(mutex_);
+    lock_guard<Utils::InnerMutex> lock(mutex_);
     obs.clear();
 }
 
@@ -52,7 +52,7 @@ bool Observable::HasChanged()
 
 int Observable::GetObserversCount()
 {
-    lock_guard<mutex> lock(mutex_);
+    lock_guard<Utils::InnerMutex> lock(mutex_);
     return (int)obs.size();
 }
 
@@ -65,7 +65,7 @@ void Observable::NotifyObservers(const ObserverArg* arg)
 {
     set<shared_ptr<Observer>> arrLocal;
     {
-        lock_guard<mutex> lock(mutex_);
+        lock_guard<Utils::InnerMutex> lock(mutex_);
         if (!changed_) {
             return;
         }
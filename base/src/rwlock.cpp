@@ -15,6 +15,8 @@
 
 #include "rwlock.h"
 
+#include <algorithm>
+
 namespace OHOS {
 namespace Utils {
 
@@ -86,5 +88,179 @@ void RWLock::UnLockWrite()
     lockCount_.store(LOCK_STATUS_FREE);
 }
 
+bool RWLock::TryLockReadOnce()
+{
+    int count = lockCount_;
+    // Keep retrying only while other readers change the counter, never wait for a writer.
+    while (count != LOCK_STATUS_WRITE && !(writeFirst_ && writeWaitCount_ > 0)) {
+        if (lockCount_.compare_exchange_weak(count, count + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RWLock::TryLockRead()
+{
+    // If the thread has obtained the write lock, return directly.
+    if (std::this_thread::get_id() == writeThreadID_) {
+        return true;
+    }
+
+    return TryLockReadOnce();
+}
+
+bool RWLock::TryLockWrite()
+{
+    if (std::this_thread::get_id() == writeThreadID_) {
+        return true;
+    }
+
+    int status = LOCK_STATUS_FREE;
+    if (!lockCount_.compare_exchange_strong(status, LOCK_STATUS_WRITE)) {
+        return false;
+    }
+    writeThreadID_ = std::this_thread::get_id();
+    return true;
+}
+
+bool RWLock::LockReadFor(std::chrono::nanoseconds timeout)
+{
+    if (std::this_thread::get_id() == writeThreadID_) {
+        return true;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!TryLockReadOnce()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+bool RWLock::LockWriteFor(std::chrono::nanoseconds timeout)
+{
+    if (std::this_thread::get_id() == writeThreadID_) {
+        return true;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    ++writeWaitCount_;
+    int status = LOCK_STATUS_FREE;
+    while (!lockCount_.compare_exchange_weak(status, LOCK_STATUS_WRITE)) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            --writeWaitCount_;
+            return false;
+        }
+        status = LOCK_STATUS_FREE;
+        std::this_thread::yield();
+    }
+    --writeWaitCount_;
+    writeThreadID_ = std::this_thread::get_id();
+    return true;
+}
+
+bool RWLock::TryUpgradeToWrite()
+{
+    if (std::this_thread::get_id() == writeThreadID_) {
+        return true;
+    }
+
+    // Only the sole reader may upgrade, so the counter must go from exactly one reader to the write state.
+    int count = 1;
+    if (!lockCount_.compare_exchange_strong(count, LOCK_STATUS_WRITE)) {
+        return false;
+    }
+    writeThreadID_ = std::this_thread::get_id();
+    return true;
+}
+
+void RWLock::DowngradeToRead()
+{
+    if (std::this_thread::get_id() != writeThreadID_) {
+        return;
+    }
+
+    // Switch directly from the write state to one reader, so no writer can get in between.
+    writeThreadID_ = std::thread::id();
+    lockCount_.store(1);
+}
+
+BigReaderLock::BigReaderLock(size_t slotCount)
+    : slotCount_(slotCount), slots_(), writerPresent_(false), writeThreadID_()
+{
+    if (slotCount_ == 0) {
+        slotCount_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+    slots_.reset(new ReaderSlot[slotCount_]);
+}
+
+BigReaderLock::ReaderSlot& BigReaderLock::CurrentSlot()
+{
+    // Each thread picks a fixed slot index once, spreading threads evenly over the slots.
+    static std::atomic_uint nextSlotIndex(0);
+    thread_local unsigned int slotIndex = nextSlotIndex.fetch_add(1, std::memory_order_relaxed);
+    return slots_[slotIndex % slotCount_];
+}
+
+void BigReaderLock::LockRead()
+{
+    // If the thread has obtained the write lock, return directly.
+    if (std::this_thread::get_id() == writeThreadID_) {
+        return;
+    }
+
+    ReaderSlot& slot = CurrentSlot();
+    while (true) {
+        // Publish the reader first, then check for writers. LockWrite() does the
+        // opposite, so either the reader or the writer always sees the other one.
+        slot.count.fetch_add(1);
+        if (!writerPresent_.load()) {
+            return;
+        }
+
+        // A writer is present, back off and wait for it to finish.
+        slot.count.fetch_sub(1);
+        while (writerPresent_.load(std::memory_order_relaxed)) {}
+    }
+}
+
+void BigReaderLock::UnLockRead()
+{
+    if (std::this_thread::get_id() != writeThreadID_) {
+        CurrentSlot().count.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void BigReaderLock::LockWrite()
+{
+    // If this thread is already a thread that gets the write lock, return directly to avoid repeated locks.
+    if (std::this_thread::get_id() == writeThreadID_) {
+        return;
+    }
+
+    // Writers are mutually exclusive. Announcing the writer also stops new readers from entering.
+    for (bool present = false; !writerPresent_.compare_exchange_weak(present, true); present = false) {}
+
+    // Wait until the readers that entered before the announcement have left.
+    for (size_t i = 0; i < slotCount_; ++i) {
+        while (slots_[i].count.load() != 0) {}
+    }
+
+    writeThreadID_ = std::this_thread::get_id();
+}
+
+void BigReaderLock::UnLockWrite()
+{
+    if (std::this_thread::get_id() != writeThreadID_) {
+        return;
+    }
+
+    writeThreadID_ = std::thread::id();
+    writerPresent_.store(false);
+}
+
 } // namespace Utils
 } // namespace OHOS
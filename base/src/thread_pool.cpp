@@ -58,7 +58,7 @@ uint32_t ThreadPool::Start(int numThreads)
 void ThreadPool::Stop()
 {
     {
-        std::unique_lock<std::mutex>  lock(mutex_);
+        std::unique_lock<Utils::InnerMutex>  lock(mutex_);
         running_ = false;
         hasTaskToDo_.notify_all();
     }
@@ -73,7 +73,7 @@ void ThreadPool::AddTask(const Task &f)
     if (threads_.empty()) {
         f();
     } else {
-        std::unique_lock<std::mutex> lock(mutex_);
+        std::unique_lock<Utils::InnerMutex> lock(mutex_);
         while (Overloaded()) {
             acceptNewTask_.wait(lock);
         }
@@ -85,14 +85,14 @@ void ThreadPool::AddTask(const Task &f)
 
 size_t ThreadPool::GetCurTaskNum()
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<Utils::InnerMutex> lock(mutex_);
     return tasks_.size();
 }
 
 
 ThreadPool::Task ThreadPool::ScheduleTask()
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<Utils::InnerMutex> lock(mutex_);
     while (tasks_.empty() && running_) {
         hasTaskToDo_.wait(lock);
     }
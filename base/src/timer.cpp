@@ -19,14 +19,58 @@
 #include "common_timer_errors.h"
 #include <sys/prctl.h>
 #include <atomic>
+#include "thread_pool.h"
 #include "timer_event_handler.h" /* for INVALID_TIMER_FD */
+#include "timing_wheel.h"
 #include "utils_log.h"
 namespace OHOS {
 namespace Utils {
 
-Timer::Timer(const std::string& name, int timeoutMs) : name_(name), timeoutMs_(timeoutMs),
-    reactor_(new EventReactor())
+static constexpr uint64_t NANO_PER_MILLI = 1000000;
+static constexpr uint64_t NANO_PER_SEC = 1000000000;
+// Tick of the wheel keeping the timed events registered by duration or deadline on TimerEngine::PER_INTERVAL_FD.
+static constexpr uint64_t PRECISE_WHEEL_TICK_NS = 1000;
+// Timer IDs of TimerEngine::PER_INTERVAL_FD are (generation << ENTRY_INDEX_BITS) | index, like the ones of
+// TimingWheel. The generation starts from 1, so IDs never equal 0 or TIMER_ERR_DEAL_FAILED. The top bit tells
+// them apart: it is clear in both, and set on the IDs of the wheel returned to callers.
+static constexpr uint32_t ENTRY_INDEX_BITS = 20;
+static constexpr uint32_t ENTRY_INDEX_MASK = (1u << ENTRY_INDEX_BITS) - 1;
+static constexpr uint32_t ENTRY_GENERATION_MASK = (1u << (31 - ENTRY_INDEX_BITS)) - 1;
+static constexpr uint32_t WHEEL_ID_TAG = 1u << 31;
+
+static uint64_t GetMonotonicNs()
 {
+    timespec now {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * NANO_PER_SEC + static_cast<uint64_t>(now.tv_nsec);
+}
+
+static size_t LatencyToBucket(uint64_t latencyNs)
+{
+    const uint64_t nanoPerMicro = 1000;
+    uint64_t latencyUs = latencyNs / nanoPerMicro;
+    size_t bucket = 0;
+    while (latencyUs > 0 && bucket < TIMER_LATENCY_HISTOGRAM_BUCKETS - 1) {
+        latencyUs >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+Timer::Timer(const std::string& name, int timeoutMs) : freeEntry_(ENTRY_NIL), name_(name), timeoutMs_(timeoutMs),
+    reactor_(new EventReactor()), engine_(TimerEngine::PER_INTERVAL_FD), wheelTimerFd_(INVALID_TIMER_FD),
+    wheelDeadlineNs_(0), pool_(nullptr), latency_(std::make_shared<LatencyCounters>())
+{
+}
+
+Timer::Timer(const std::string& name, int timeoutMs, TimerEngine engine, std::chrono::nanoseconds wheelTick)
+    : Timer(name, timeoutMs)
+{
+    engine_ = engine;
+    if (engine == TimerEngine::TIMING_WHEEL) {
+        uint64_t tickNs = (wheelTick.count() > 0) ? static_cast<uint64_t>(wheelTick.count()) : NANO_PER_MILLI;
+        wheel_ = std::make_unique<TimingWheel>(tickNs, GetMonotonicNs());
+    }
 }
 
 Timer::~Timer()
@@ -40,6 +84,12 @@ uint32_t Timer::Setup()
         return TIMER_ERR_INVALID_VALUE;
     }
     reactor_->SwitchOn();
+    {
+        std::lock_guard<InnerMutex> lock(mutex_);
+        if (wheel_ != nullptr) {
+            ArmWheel();
+        }
+    }
     std::thread loop_thread([this] { this->MainLoop(); });
     thread_.swap(loop_thread);
 
@@ -55,8 +105,9 @@ void Timer::Shutdown(bool useJoin)
 
     reactor_->SwitchOff();
     if (timeoutMs_ == -1) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (intervalToTimers_.empty()) {
+        std::lock_guard<InnerMutex> lock(mutex_);
+        bool noEvent = timerFdEntries_.empty() && ((wheel_ == nullptr) || (wheel_->Size() == 0));
+        if (noEvent) {
             UTILS_LOGI("no event for epoll wait, use detach to shutdown");
 
             int tmpTimerFd = INVALID_TIMER_FD;
@@ -80,67 +131,93 @@ void Timer::Shutdown(bool useJoin)
 
 uint32_t Timer::Register(const TimerCallback& callback, uint32_t interval /* ms */, bool once)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    static std::atomic_uint32_t timerId = 1;
-    int timerFd = once ? INVALID_TIMER_FD : GetTimerFd(interval);
-    if (timerFd == INVALID_TIMER_FD) {
+    if (engine_ == TimerEngine::TIMING_WHEEL) {
+        if (interval == 0 && !once) {
+            UTILS_LOGE("invalid interval 0 ms of a periodic event");
+            return TIMER_ERR_INVALID_VALUE;
+        }
+        uint64_t periodNs = static_cast<uint64_t>(interval) * NANO_PER_MILLI;
+        return RegisterOnWheel(std::make_shared<TimerOverrunCallback>([callback](uint64_t) { callback(); }),
+            GetMonotonicNs() + periodNs, once ? 0 : periodNs, RepeatMode::SKIP_MISSED, 0);
+    }
+
+    std::lock_guard<InnerMutex> lock(mutex_);
+    int timerFd = INVALID_TIMER_FD;
+    auto shared = once ? intervalToTimerFd_.end() : intervalToTimerFd_.find(interval);
+    if (shared != intervalToTimerFd_.end()) {
+        timerFd = shared->second;
+    } else {
+        uint64_t startNs = GetMonotonicNs();
         uint32_t ret = DoRegister([this](int fd) { this->OnTimer(fd); }, interval, once, timerFd);
         if (ret != TIMER_ERR_OK) {
             UTILS_LOGE("do register interval timer %{public}d failed, return %{public}u", interval, ret);
             return TIMER_ERR_DEAL_FAILED;
         }
+        timerFdEntries_[timerFd] = {interval, once, startNs, ENTRY_NIL, ENTRY_NIL, 0, 0, ENTRY_NIL};
+        if (!once) {
+            intervalToTimerFd_[interval] = timerFd;
+        }
     }
 
-    timerId = GetValidId(timerId);
-    while (timerToEntries_.find(timerId) != timerToEntries_.end()) {
-        timerId++;
-        timerId = GetValidId(timerId);
+    TimerFdEntries& entries = timerFdEntries_[timerFd];
+    uint32_t index = AllocEntry();
+    if (index == ENTRY_NIL) {
+        UTILS_LOGE("too many timers, register timer failed");
+        if (entries.count == 0) {
+            ReleaseTimerFd(timerFd);
+        }
+        return TIMER_ERR_DEAL_FAILED;
     }
 
-    TimerEntryPtr entry(new TimerEntry());
-    entry->timerId = timerId++;
-    entry->interval = interval;
-    entry->callback = callback;
-    entry->once = once;
-    entry->timerFd = timerFd;
-
-    intervalToTimers_[interval].push_back(entry);
-    timerToEntries_[entry->timerId] = entry;
+    TimerEntry& entry = entries_[index];
+    entry.timerFd = timerFd;
+    entry.round = entries.round;
+    entry.callback = std::make_shared<TimerOverrunCallback>([callback](uint64_t) { callback(); });
+    entry.prev = entries.tail;
+    entry.next = ENTRY_NIL;
+    if (entries.tail != ENTRY_NIL) {
+        entries_[entries.tail].next = index;
+    } else {
+        entries.head = index;
+    }
+    entries.tail = index;
+    ++entries.count;
 
-    UTILS_LOGD("register timer %{public}u with %{public}u ms interval.", entry->timerId, entry->interval);
-    return entry->timerId;
+    uint32_t timerId = MakeEntryId(index);
+    UTILS_LOGD("register timer %{public}u with %{public}u ms interval.", timerId, interval);
+    return timerId;
 }
 
 void Timer::Unregister(uint32_t timerId)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (timerToEntries_.find(timerId) == timerToEntries_.end()) {
-        UTILS_LOGD("timer %{public}u does not exist", timerId);
+    std::lock_guard<InnerMutex> lock(mutex_);
+    if ((timerId & WHEEL_ID_TAG) != 0) {
+        if ((wheel_ != nullptr) && wheel_->Remove(timerId & ~WHEEL_ID_TAG)) {
+            UTILS_LOGD("deregister timer %{public}u on the timing wheel", timerId);
+            ArmWheel();
+        }
         return;
     }
 
-    auto entry = timerToEntries_[timerId];
-    UTILS_LOGD("deregister timer %{public}u with %{public}u ms interval", timerId, entry->interval);
+    uint32_t index;
+    if (!LookupEntry(timerId, index) || entries_[index].removed) {
+        UTILS_LOGD("timer %{public}u does not exist", timerId);
+        return;
+    }
 
-    auto itor = intervalToTimers_[entry->interval].begin();
-    for (; itor != intervalToTimers_[entry->interval].end(); ++itor) {
-        if ((*itor)->timerId == timerId) {
-            UTILS_LOGD("erase timer %{public}u.", timerId);
-            if ((*itor)->once) {
-                reactor_->CancelTimer((*itor)->timerFd);
-                timers_.erase((*itor)->timerFd);
-            }
-            intervalToTimers_[entry->interval].erase(itor);
-            break;
-        }
+    int timerFd = entries_[index].timerFd;
+    TimerFdEntries& entries = timerFdEntries_[timerFd];
+    UTILS_LOGD("deregister timer %{public}u with %{public}u ms interval", timerId, entries.interval);
+    if (entries.dispatching == index) {
+        entries_[index].removed = true; // OnTimer() frees it once the callback returns
+        return;
     }
 
-    if (intervalToTimers_[entry->interval].empty()) {
-        UTILS_LOGD("deregister timer interval: %{public}u.", entry->interval);
-        intervalToTimers_.erase(entry->interval);
-        DoUnregister(entry->interval);
+    RemoveEntry(index);
+    if (entries.count == 0) {
+        UTILS_LOGD("deregister timer interval: %{public}u.", entries.interval);
+        ReleaseTimerFd(timerFd);
     }
-    timerToEntries_.erase(timerId);
 }
 
 void Timer::MainLoop()
@@ -150,6 +227,7 @@ void Timer::MainLoop()
         reactor_->RunLoop(timeoutMs_);
     }
     reactor_->CleanUp();
+    ReleaseWheelTimerFd();
 }
 
 uint32_t Timer::DoRegister(const TimerListCallback& callback, uint32_t interval, bool once, int &timerFd)
@@ -160,47 +238,51 @@ uint32_t Timer::DoRegister(const TimerListCallback& callback, uint32_t interval,
         UTILS_LOGE("ScheduleTimer failed!ret:%{public}d, timerFd:%{public}d", ret, timerFd);
         return ret;
     }
-    timers_[timerFd] = interval;
     return TIMER_ERR_OK;
 }
 
-void Timer::DoUnregister(uint32_t interval)
-{
-    for (auto& itor : timers_) {
-        if (itor.second == interval) {
-            reactor_->CancelTimer(itor.first);
-        }
-    }
-}
-
 void Timer::OnTimer(int timerFd)
 {
-    uint32_t interval;
-    TimerEntryList entryList;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        interval = timers_[timerFd];
-        entryList = intervalToTimers_[interval];
+    latency_->wakeups.fetch_add(1, std::memory_order_relaxed);
+    std::unique_lock<InnerMutex> lock(mutex_);
+    auto found = timerFdEntries_.find(timerFd);
+    if (found == timerFdEntries_.end()) {
+        return;
     }
-
-    std::vector<uint32_t> onceIdsUnused;
-    for (const TimerEntryPtr& ptr : entryList) {
-        if (ptr->timerFd != timerFd) {
-            continue;
-        }
+    // The group is not erased while one of its entries is dispatching, so the reference stays valid.
+    TimerFdEntries& entries = found->second;
+    uint64_t round = ++entries.round;
+
+    // The expiry being handled is the latest one of the timerfd.
+    uint64_t nowNs = GetMonotonicNs();
+    uint64_t intervalNs = static_cast<uint64_t>(entries.interval) * NANO_PER_MILLI;
+    uint64_t expirations = 1;
+    if (!entries.once && intervalNs != 0 && nowNs >= entries.startNs + intervalNs) {
+        expirations = (nowNs - entries.startNs) / intervalNs;
+    }
+    uint64_t scheduledNs = entries.startNs + expirations * intervalNs;
+
+    // Walk the list in place. Entries are appended, so the ones registered during this walk are all at the end.
+    uint32_t index = entries.head;
+    while ((index != ENTRY_NIL) && (entries_[index].round != round)) {
+        entries.dispatching = index;
+        std::shared_ptr<TimerOverrunCallback> callback = entries_[index].callback;
+        lock.unlock();
         /* if stop, callback is forbidden */
         if (reactor_->IsLoopReady() && reactor_->IsSwitchedOn()) {
-            ptr->callback();
+            DispatchCallback(callback, scheduledNs, 0);
         }
-
-        if (!ptr->once) {
-            continue;
+        lock.lock();
+        entries.dispatching = ENTRY_NIL;
+        uint32_t next = entries_[index].next;
+        if (entries.once || entries_[index].removed) {
+            RemoveEntry(index);
         }
-        onceIdsUnused.push_back(ptr->timerId);
+        index = next;
     }
 
-    if (!onceIdsUnused.empty()) {
-        EraseUnusedTimerId(interval, onceIdsUnused);
+    if (entries.count == 0) {
+        ReleaseTimerFd(timerFd);
     }
 }
 
@@ -209,54 +291,241 @@ void Timer::DoTimerListCallback(const TimerListCallback& callback, int timerFd)
     callback(timerFd);
 }
 
-/* valid range: [1, UINT32_MAX], but not TIMER_ERR_DEAL_FAILED */
-uint32_t Timer::GetValidId(uint32_t timerId) const
+// The helpers below must be called with mutex_ held.
+uint32_t Timer::AllocEntry()
 {
-    if (timerId == TIMER_ERR_DEAL_FAILED) {
-        return timerId + 1;
+    uint32_t index = freeEntry_;
+    if (index != ENTRY_NIL) {
+        freeEntry_ = entries_[index].next;
+    } else {
+        if (entries_.size() > ENTRY_INDEX_MASK) {
+            return ENTRY_NIL;
+        }
+        index = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back();
     }
-    if (timerId == UINT32_MAX) {
-        return 1;
+    entries_[index].used = true;
+    entries_[index].removed = false;
+    return index;
+}
+
+void Timer::FreeEntry(uint32_t index)
+{
+    TimerEntry& entry = entries_[index];
+    entry.used = false;
+    entry.callback = nullptr;
+    entry.timerFd = INVALID_TIMER_FD;
+    entry.generation = (entry.generation + 1) & ENTRY_GENERATION_MASK;
+    if (entry.generation == 0) {
+        entry.generation = 1;
     }
-    return timerId;
+    entry.prev = ENTRY_NIL;
+    entry.next = freeEntry_;
+    freeEntry_ = index;
+}
+
+uint32_t Timer::MakeEntryId(uint32_t index) const
+{
+    return (entries_[index].generation << ENTRY_INDEX_BITS) | index;
 }
 
-int Timer::GetTimerFd(uint32_t interval /* ms */)
+bool Timer::LookupEntry(uint32_t timerId, uint32_t& index) const
 {
-    if (intervalToTimers_.find(interval) == intervalToTimers_.end()) {
-        return INVALID_TIMER_FD;
+    index = timerId & ENTRY_INDEX_MASK;
+    return (index < entries_.size()) && entries_[index].used && (MakeEntryId(index) == timerId);
+}
+
+// Unlinks the entry from the entries of its timerfd and frees it. The timerfd is kept.
+void Timer::RemoveEntry(uint32_t index)
+{
+    TimerEntry& entry = entries_[index];
+    TimerFdEntries& entries = timerFdEntries_[entry.timerFd];
+    if (entry.prev != ENTRY_NIL) {
+        entries_[entry.prev].next = entry.next;
+    } else {
+        entries.head = entry.next;
     }
-    auto &entryList = intervalToTimers_[interval];
-    for (const TimerEntryPtr &ptr : entryList) {
-        if (!ptr->once) {
-            return ptr->timerFd;
-        }
+    if (entry.next != ENTRY_NIL) {
+        entries_[entry.next].prev = entry.prev;
+    } else {
+        entries.tail = entry.prev;
     }
-    return INVALID_TIMER_FD;
+    --entries.count;
+    FreeEntry(index);
 }
 
-void Timer::EraseUnusedTimerId(uint32_t interval, const std::vector<uint32_t>& unusedIds)
+void Timer::ReleaseTimerFd(int timerFd)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto &entryList = intervalToTimers_[interval];
-    for (auto itor = entryList.begin(); itor != entryList.end();) {
-        uint32_t id = (*itor)->timerId;
-        if (std::find(unusedIds.begin(), unusedIds.end(), id) == unusedIds.end()) {
-            ++itor;
-            continue;
+    reactor_->CancelTimer(timerFd);
+    auto found = timerFdEntries_.find(timerFd);
+    if (found == timerFdEntries_.end()) {
+        return;
+    }
+    auto shared = intervalToTimerFd_.find(found->second.interval);
+    if ((shared != intervalToTimerFd_.end()) && (shared->second == timerFd)) {
+        intervalToTimerFd_.erase(shared);
+    }
+    timerFdEntries_.erase(found);
+}
+
+uint32_t Timer::Register(const TimerOverrunCallback& callback, std::chrono::nanoseconds interval, bool once,
+    RepeatMode mode, std::chrono::nanoseconds slack)
+{
+    if (interval.count() < 0 || slack.count() < 0) {
+        UTILS_LOGE("invalid interval %{public}lld ns or slack %{public}lld ns",
+            static_cast<long long>(interval.count()), static_cast<long long>(slack.count()));
+        return TIMER_ERR_DEAL_FAILED;
+    }
+    // A period of 0 means one-shot to the wheel.
+    if (interval.count() == 0 && !once) {
+        UTILS_LOGE("invalid interval 0 ns of a periodic event");
+        return TIMER_ERR_INVALID_VALUE;
+    }
+    uint64_t periodNs = static_cast<uint64_t>(interval.count());
+    return RegisterOnWheel(std::make_shared<TimerOverrunCallback>(callback), GetMonotonicNs() + periodNs,
+        once ? 0 : periodNs, mode, static_cast<uint64_t>(slack.count()));
+}
+
+uint32_t Timer::RegisterAt(const TimerOverrunCallback& callback, std::chrono::steady_clock::time_point deadline,
+    std::chrono::nanoseconds period, RepeatMode mode, std::chrono::nanoseconds slack)
+{
+    auto deadlineNs = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    if (deadlineNs < 0 || period.count() < 0 || slack.count() < 0) {
+        UTILS_LOGE("invalid deadline %{public}lld ns, period %{public}lld ns or slack %{public}lld ns",
+            static_cast<long long>(deadlineNs), static_cast<long long>(period.count()),
+            static_cast<long long>(slack.count()));
+        return TIMER_ERR_DEAL_FAILED;
+    }
+    return RegisterOnWheel(std::make_shared<TimerOverrunCallback>(callback), static_cast<uint64_t>(deadlineNs),
+        static_cast<uint64_t>(period.count()), mode, static_cast<uint64_t>(slack.count()));
+}
+
+uint32_t Timer::RegisterOnWheel(const std::shared_ptr<TimerOverrunCallback>& callback, uint64_t expiryNs,
+    uint64_t periodNs, RepeatMode mode, uint64_t slackNs)
+{
+    std::lock_guard<InnerMutex> lock(mutex_);
+    if (wheel_ == nullptr) {
+        wheel_ = std::make_unique<TimingWheel>(PRECISE_WHEEL_TICK_NS, GetMonotonicNs());
+    }
+    bool catchUp = (mode == RepeatMode::CATCH_UP);
+    uint32_t timerId = wheel_->Add(callback, expiryNs, periodNs, catchUp, slackNs);
+    if (timerId == TimingWheel::INVALID_ID) {
+        UTILS_LOGE("too many timers on the timing wheel, register timer failed");
+        return TIMER_ERR_DEAL_FAILED;
+    }
+    timerId |= WHEEL_ID_TAG;
+    ArmWheel();
+    UTILS_LOGD("register timer %{public}u, period %{public}llu ns.", timerId, static_cast<unsigned long long>(periodNs));
+    return timerId;
+}
+
+void Timer::OnWheelTimer()
+{
+    {
+        std::lock_guard<InnerMutex> lock(mutex_);
+        wheelDeadlineNs_ = 0; // the timerfd has fired and is disarmed now
+        latency_->wakeups.fetch_add(1, std::memory_order_relaxed);
+        wheel_->Advance(GetMonotonicNs(), expired_);
+        ArmWheel();
+    }
+
+    for (const ExpiredTimer& timer : expired_) {
+        /* if stop, callback is forbidden */
+        if (reactor_->IsLoopReady() && reactor_->IsSwitchedOn()) {
+            DispatchCallback(timer.callback, timer.scheduledNs, timer.overruns);
         }
+    }
+    expired_.clear();
+}
 
-        reactor_->CancelTimer((*itor)->timerFd);
-        timers_.erase((*itor)->timerFd);
-        itor = entryList.erase(itor);
-        timerToEntries_.erase(id);
+// Arms the single timerfd with the next deadline of the wheel. mutex_ must be held.
+void Timer::ArmWheel()
+{
+    uint64_t deadlineNs = 0;
+    if (!wheel_->GetNextEventNs(deadlineNs)) {
+        deadlineNs = 0;
+    }
+    if (deadlineNs == wheelDeadlineNs_) {
+        return;
+    }
 
-        if (entryList.empty()) {
-            intervalToTimers_.erase(interval);
-            DoUnregister(interval);
+    if (wheelTimerFd_ == INVALID_TIMER_FD) {
+        if (deadlineNs == 0) {
             return;
         }
+        uint32_t ret = reactor_->ScheduleDeadlineTimer([this](int unused) { this->OnWheelTimer(); }, wheelTimerFd_);
+        if (ret != TIMER_ERR_OK) {
+            UTILS_LOGE("schedule timing wheel timer failed, return %{public}u", ret);
+            wheelTimerFd_ = INVALID_TIMER_FD;
+            return;
+        }
+    }
+
+    timespec deadline {static_cast<time_t>(deadlineNs / NANO_PER_SEC), static_cast<long>(deadlineNs % NANO_PER_SEC)};
+    if (reactor_->SetTimerDeadline(wheelTimerFd_, deadline) == TIMER_ERR_OK) {
+        wheelDeadlineNs_ = deadlineNs;
+    }
+}
+
+void Timer::DispatchCallback(const std::shared_ptr<TimerOverrunCallback>& callback, uint64_t scheduledNs,
+    uint64_t overruns)
+{
+    auto run = [latency = latency_, callback, scheduledNs, overruns]() {
+        uint64_t nowNs = GetMonotonicNs();
+        uint64_t latencyNs = (nowNs > scheduledNs) ? (nowNs - scheduledNs) : 0;
+        latency->callbacks.fetch_add(1, std::memory_order_relaxed);
+        latency->totalLatencyNs.fetch_add(latencyNs, std::memory_order_relaxed);
+        latency->histogram[LatencyToBucket(latencyNs)].fetch_add(1, std::memory_order_relaxed);
+        uint64_t maxLatency = latency->maxLatencyNs.load(std::memory_order_relaxed);
+        while (latencyNs > maxLatency && !latency->maxLatencyNs.compare_exchange_weak(maxLatency, latencyNs)) {}
+        (*callback)(overruns);
+    };
+
+    ThreadPool* pool = pool_.load(std::memory_order_acquire);
+    if (pool == nullptr) {
+        run();
+        return;
+    }
+    pool->AddTask(run);
+}
+
+void Timer::SetCallbackThreadPool(ThreadPool* pool)
+{
+    pool_.store(pool, std::memory_order_release);
+}
+
+TimerLatencyStats Timer::GetLatencyStats() const
+{
+    TimerLatencyStats stats;
+    stats.callbacks = latency_->callbacks.load(std::memory_order_relaxed);
+    stats.wakeups = latency_->wakeups.load(std::memory_order_relaxed);
+    stats.totalLatencyNs = latency_->totalLatencyNs.load(std::memory_order_relaxed);
+    stats.maxLatencyNs = latency_->maxLatencyNs.load(std::memory_order_relaxed);
+    for (auto& bucket : latency_->histogram) {
+        stats.latencyHistogram.push_back(bucket.load(std::memory_order_relaxed));
+    }
+    return stats;
+}
+
+void Timer::ResetLatencyStats()
+{
+    latency_->callbacks.store(0, std::memory_order_relaxed);
+    latency_->wakeups.store(0, std::memory_order_relaxed);
+    latency_->totalLatencyNs.store(0, std::memory_order_relaxed);
+    latency_->maxLatencyNs.store(0, std::memory_order_relaxed);
+    for (auto& bucket : latency_->histogram) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Timer::ReleaseWheelTimerFd()
+{
+    std::lock_guard<InnerMutex> lock(mutex_);
+    if (wheelTimerFd_ != INVALID_TIMER_FD) {
+        reactor_->CancelTimer(wheelTimerFd_);
+        wheelTimerFd_ = INVALID_TIMER_FD;
     }
+    wheelDeadlineNs_ = 0;
 }
 
 } // namespace Utils
@@ -32,12 +32,23 @@ constexpr int MILLI_TO_NANO = NANO_TO_BASE / MILLI_TO_BASE;
 TimerEventHandler::TimerEventHandler(EventReactor* p, uint32_t timeout /* ms */, bool once)
     : EventHandler(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC), p),
       once_(once),
+      deadline_(false),
       interval_(timeout),
       callback_(),
       initInfo_()
 {
 }
 
+TimerEventHandler::TimerEventHandler(EventReactor* p)
+    : EventHandler(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC), p),
+      once_(true),
+      deadline_(true),
+      interval_(0),
+      callback_(),
+      initInfo_()
+{
+}
+
 TimerEventHandler::~TimerEventHandler()
 {
     close(GetHandle());
@@ -51,6 +62,12 @@ uint32_t TimerEventHandler::Initialize()
         return TIMER_ERR_INVALID_VALUE;
     }
 
+    if (deadline_) {
+        SetReadCallback([this] { this->TimeOut(); });
+        EnableRead();
+        return TIMER_ERR_OK;
+    }
+
     struct itimerspec newValue = {{0, 0}, {0, 0}};
     timespec now{0, 0};
     if (clock_gettime(CLOCK_MONOTONIC, &now) == -1) {
@@ -99,6 +116,16 @@ void TimerEventHandler::Uninitialize()
     DisableAll();
 }
 
+uint32_t TimerEventHandler::SetDeadline(const timespec& deadline)
+{
+    struct itimerspec newValue = {{0, 0}, deadline};
+    if (timerfd_settime(GetHandle(), TFD_TIMER_ABSTIME, &newValue, nullptr) == -1) {
+        UTILS_LOGE("Failed in timerFd_settime, errno=%{public}d", errno);
+        return TIMER_ERR_DEAL_FAILED;
+    }
+    return TIMER_ERR_OK;
+}
+
 void TimerEventHandler::TimeOut()
 {
     if (GetHandle() == INVALID_TIMER_FD) {
@@ -109,6 +136,10 @@ void TimerEventHandler::TimeOut()
     int errnoRead = 0;
     ssize_t n = ::read(GetHandle(), &expirations, sizeof(expirations));
     errnoRead = errno;
+    if (deadline_ && n != sizeof(expirations) && errnoRead == EAGAIN) {
+        // The deadline was moved after it had expired, nothing is due yet.
+        return;
+    }
     if (n != sizeof(expirations)) {
         struct itimerspec current = {
             .it_interval = {.tv_sec = -1, .tv_nsec = -1},
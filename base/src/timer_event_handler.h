@@ -33,6 +33,8 @@ class TimerEventHandler : public EventHandler {
 
 public:
     TimerEventHandler(EventReactor* p, uint32_t timeout, bool once);
+    // Creates a deadline timer, which stays disarmed until SetDeadline() is called.
+    explicit TimerEventHandler(EventReactor* p);
     ~TimerEventHandler() override;
 
     TimerEventHandler(const TimerEventHandler&) = delete;
@@ -43,6 +45,9 @@ public:
     uint32_t Initialize();
     void Uninitialize();
 
+    // Arms a deadline timer to fire once at an absolute CLOCK_MONOTONIC time. {0, 0} disarms it.
+    uint32_t SetDeadline(const timespec& deadline);
+
     void SetTimerCallback(const TimerCallback& callback) { callback_ = callback; }
 
     uint32_t GetInterval() const { return interval_; }
@@ -61,6 +66,7 @@ private:
     };
 
     bool           once_;
+    bool           deadline_;
     uint32_t       interval_;
     TimerCallback  callback_;
     TimerInitInfo  initInfo_;
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timing_wheel.h"
+
+namespace OHOS {
+namespace Utils {
+
+namespace {
+// Index of the first set bit at or after position `from`, wrapping around. The bitmap must be non-zero.
+uint32_t FirstSetFrom(uint64_t bitmap, uint32_t from)
+{
+    const uint32_t bits = 64;
+    uint64_t rotated = (from == 0) ? bitmap : ((bitmap >> from) | (bitmap << (bits - from)));
+    return static_cast<uint32_t>(__builtin_ctzll(rotated));
+}
+
+// Largest power of two not above slackNs, 0 if there is no slack.
+uint64_t SlackGranularity(uint64_t slackNs)
+{
+    const uint32_t bits = 63;
+    return (slackNs == 0) ? 0 : (1ULL << (bits - static_cast<uint32_t>(__builtin_clzll(slackNs))));
+}
+} // namespace
+
+TimingWheel::TimingWheel(uint64_t tickNs, uint64_t nowNs)
+    : tickNs_(tickNs == 0 ? 1 : tickNs), curTick_(0), size_(0), freeHead_(NIL), nodes_(), heads_(), occupied_()
+{
+    curTick_ = nowNs / tickNs_;
+    for (auto& head : heads_) {
+        head = NIL;
+    }
+}
+
+bool TimingWheel::Lookup(uint32_t timerId, uint32_t& index) const
+{
+    index = timerId & INDEX_MASK;
+    return (index < nodes_.size()) && nodes_[index].used && (MakeId(index) == timerId);
+}
+
+uint64_t TimingWheel::ExpiryTick(const Node& node) const
+{
+    uint64_t fireNs = node.expiryNs;
+    uint64_t granularity = SlackGranularity(node.slackNs);
+    if (granularity > 1 && fireNs % granularity != 0 && fireNs <= UINT64_MAX - granularity) {
+        fireNs += granularity - fireNs % granularity;
+    }
+    // Round up, a timer never fires before its expiry.
+    return fireNs / tickNs_ + ((fireNs % tickNs_ == 0) ? 0 : 1);
+}
+
+void TimingWheel::Link(uint32_t index)
+{
+    uint64_t tick = ExpiryTick(nodes_[index]);
+    // Overdue timers fire on the next tick.
+    tick = (tick > curTick_) ? tick : curTick_ + 1;
+    uint32_t level = 0;
+    uint64_t position = tick;
+    // Pick the lowest level on which the expiry lies less than one revolution ahead.
+    while (level < WHEEL_LEVELS - 1 &&
+        ((tick >> (SLOT_BITS * level)) - (curTick_ >> (SLOT_BITS * level))) >= SLOTS_PER_LEVEL) {
+        ++level;
+    }
+    position = tick >> (SLOT_BITS * level);
+    uint64_t current = curTick_ >> (SLOT_BITS * level);
+    if (position - current >= SLOTS_PER_LEVEL) {
+        // Beyond the range of the wheel, park it in the farthest slot. It is placed again when cascaded.
+        position = current + SLOTS_PER_LEVEL - 1;
+    }
+
+    uint32_t slot = static_cast<uint32_t>(position & SLOT_MASK);
+    uint32_t bucket = level * SLOTS_PER_LEVEL + slot;
+    Node& node = nodes_[index];
+    node.bucket = bucket;
+    node.prev = NIL;
+    node.next = heads_[bucket];
+    if (node.next != NIL) {
+        nodes_[node.next].prev = index;
+    }
+    heads_[bucket] = index;
+    occupied_[level] |= (1ULL << slot);
+}
+
+void TimingWheel::Unlink(uint32_t index)
+{
+    Node& node = nodes_[index];
+    if (node.bucket == NIL) {
+        return;
+    }
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[node.bucket] = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    }
+    if (heads_[node.bucket] == NIL) {
+        occupied_[node.bucket / SLOTS_PER_LEVEL] &= ~(1ULL << (node.bucket % SLOTS_PER_LEVEL));
+    }
+    node.prev = NIL;
+    node.next = NIL;
+    node.bucket = NIL;
+}
+
+uint32_t TimingWheel::DetachBucket(uint32_t bucket)
+{
+    uint32_t head = heads_[bucket];
+    heads_[bucket] = NIL;
+    occupied_[bucket / SLOTS_PER_LEVEL] &= ~(1ULL << (bucket % SLOTS_PER_LEVEL));
+    for (uint32_t index = head; index != NIL; index = nodes_[index].next) {
+        nodes_[index].bucket = NIL;
+    }
+    return head;
+}
+
+void TimingWheel::Free(uint32_t index)
+{
+    Node& node = nodes_[index];
+    node.used = false;
+    node.callback = nullptr;
+    node.generation = (node.generation + 1) & GENERATION_MASK;
+    if (node.generation == 0) {
+        node.generation = 1;
+    }
+    node.next = freeHead_;
+    freeHead_ = index;
+    --size_;
+}
+
+uint32_t TimingWheel::Add(const Callback& callback, uint64_t expiryNs, uint64_t periodNs, bool catchUp,
+    uint64_t slackNs)
+{
+    uint32_t index = freeHead_;
+    if (index != NIL) {
+        freeHead_ = nodes_[index].next;
+    } else {
+        if (nodes_.size() > INDEX_MASK) {
+            return INVALID_ID;
+        }
+        index = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+
+    Node& node = nodes_[index];
+    node.used = true;
+    node.expiryNs = expiryNs;
+    node.periodNs = periodNs;
+    node.catchUp = catchUp;
+    node.slackNs = slackNs;
+    node.callback = callback;
+    Link(index);
+    ++size_;
+    return MakeId(index);
+}
+
+bool TimingWheel::Remove(uint32_t timerId)
+{
+    uint32_t index;
+    if (!Lookup(timerId, index)) {
+        return false;
+    }
+    Unlink(index);
+    Free(index);
+    return true;
+}
+
+bool TimingWheel::Contains(uint32_t timerId) const
+{
+    uint32_t index;
+    return Lookup(timerId, index);
+}
+
+bool TimingWheel::NextEventTick(uint64_t& tick) const
+{
+    bool found = false;
+    for (uint32_t level = 0; level < WHEEL_LEVELS; ++level) {
+        if (occupied_[level] == 0) {
+            continue;
+        }
+        uint32_t shift = SLOT_BITS * level;
+        uint64_t current = curTick_ >> shift;
+        // Slots are always at least one position ahead of the current one.
+        uint32_t from = static_cast<uint32_t>((current + 1) & SLOT_MASK);
+        uint64_t distance = FirstSetFrom(occupied_[level], from) + 1;
+        uint64_t eventTick = (current + distance) << shift;
+        if (!found || eventTick < tick) {
+            tick = eventTick;
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool TimingWheel::GetNextEventNs(uint64_t& eventNs) const
+{
+    uint64_t tick;
+    if (!NextEventTick(tick)) {
+        return false;
+    }
+    eventNs = tick * tickNs_;
+    return true;
+}
+
+void TimingWheel::Step(uint64_t tick, uint64_t nowNs, std::vector<ExpiredTimer>& expired)
+{
+    curTick_ = tick;
+    uint32_t head = DetachBucket(static_cast<uint32_t>(tick & SLOT_MASK));
+    for (uint32_t level = WHEEL_LEVELS - 1; level > 0; --level) {
+        uint32_t shift = SLOT_BITS * level;
+        if ((tick & ((1ULL << shift) - 1)) != 0) {
+            continue;
+        }
+        // Cascade the slot which starts at this tick. Timers due now join the expired ones.
+        uint32_t bucket = level * SLOTS_PER_LEVEL + static_cast<uint32_t>((tick >> shift) & SLOT_MASK);
+        for (uint32_t index = DetachBucket(bucket); index != NIL;) {
+            uint32_t next = nodes_[index].next;
+            if (ExpiryTick(nodes_[index]) <= tick) {
+                nodes_[index].next = head;
+                head = index;
+            } else {
+                Link(index);
+            }
+            index = next;
+        }
+    }
+
+    for (uint32_t index = head; index != NIL;) {
+        Node& node = nodes_[index];
+        uint32_t next = node.next;
+        if (node.periodNs == 0) {
+            expired.push_back({MakeId(index), node.callback, node.expiryNs, 0});
+            Free(index);
+        } else {
+            uint64_t due = (nowNs >= node.expiryNs) ? (nowNs - node.expiryNs) / node.periodNs + 1 : 1;
+            if (node.catchUp) {
+                // Bounded, so that a long stall of a short period does not queue a callback per period.
+                uint64_t runs = (due < MAX_CATCH_UP) ? due : MAX_CATCH_UP;
+                for (uint64_t i = 0; i < runs; ++i) {
+                    expired.push_back({MakeId(index), node.callback, node.expiryNs + i * node.periodNs, due - 1 - i});
+                }
+            } else {
+                expired.push_back({MakeId(index), node.callback, node.expiryNs, due - 1});
+            }
+            node.expiryNs += due * node.periodNs;
+            Link(index);
+        }
+        index = next;
+    }
+}
+
+void TimingWheel::Advance(uint64_t nowNs, std::vector<ExpiredTimer>& expired)
+{
+    uint64_t target = nowNs / tickNs_;
+    uint64_t tick;
+    while (NextEventTick(tick) && tick <= target) {
+        Step(tick, nowNs, expired);
+    }
+    if (target > curTick_) {
+        curTick_ = target;
+    }
+}
+
+} // namespace Utils
+} // namespace OHOS
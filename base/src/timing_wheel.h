@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTILS_TIMING_WHEEL_H
+#define UTILS_TIMING_WHEEL_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace OHOS {
+namespace Utils {
+
+struct ExpiredTimer {
+    uint32_t timerId;
+    std::shared_ptr<std::function<void(uint64_t)>> callback;
+    uint64_t scheduledNs;  // Expiry the timer was scheduled for.
+    uint64_t overruns;  // Expiries of a periodic timer which are also due, see TimingWheel::Add().
+};
+
+/*
+ * Hierarchical timing wheel. Time is split into ticks of tickNs nanoseconds
+ * of CLOCK_MONOTONIC. Each of the WHEEL_LEVELS levels has 64 slots, and a slot
+ * of level L covers 64^L ticks. A timer is kept in the lowest level whose
+ * range reaches its expiry, and is moved down (cascaded) when the wheel
+ * reaches the start of its slot. Every level keeps a bitmap of non-empty
+ * slots, so the next tick that needs work is found without walking empty
+ * slots, and the wheel can jump over idle periods.
+ *
+ * Timers live in a slot map and are linked into slots by index. Ids carry a
+ * generation, so a stale id never matches a reused entry. Add, Remove and the
+ * per-timer expiry work are O(1).
+ *
+ * Not thread-safe. The owner serializes all calls.
+ */
+class TimingWheel {
+public:
+    using Callback = std::shared_ptr<std::function<void(uint64_t)>>;
+
+    TimingWheel(uint64_t tickNs, uint64_t nowNs);
+
+    // Returns the timer ID, or INVALID_ID if the wheel is full. IDs leave the top bit clear, for the owner
+    // to tag them. periodNs == 0 means one-shot.
+    // Periodic timers keep their expiries on the grid expiryNs + k * periodNs. When several expiries are
+    // due at once, a catch-up timer is reported once for each of them, up to MAX_CATCH_UP, otherwise it is
+    // reported once with the number of the skipped ones as overruns. Beyond MAX_CATCH_UP, the rest are
+    // skipped and counted in the overruns of the last report.
+    // A timer with slack may fire up to slackNs after its expiry. Its firing time is rounded up to a multiple of
+    // the largest power of two nanoseconds not above slackNs, so that nearby timers fire in the same tick.
+    uint32_t Add(const Callback& callback, uint64_t expiryNs, uint64_t periodNs, bool catchUp = false,
+        uint64_t slackNs = 0);
+    bool Remove(uint32_t timerId);
+    bool Contains(uint32_t timerId) const;
+
+    // Moves the wheel to nowNs. Due timers are appended to expired; one-shot ones are removed
+    // and periodic ones are scheduled again.
+    void Advance(uint64_t nowNs, std::vector<ExpiredTimer>& expired);
+
+    // Obtains the time at which Advance() next has work to do. Returns false if the wheel is empty.
+    bool GetNextEventNs(uint64_t& eventNs) const;
+
+    size_t Size() const
+    {
+        return size_;
+    }
+
+    static constexpr uint32_t INVALID_ID = 0;
+    static constexpr uint64_t MAX_CATCH_UP = 64;
+
+private:
+    static constexpr uint32_t SLOT_BITS = 6;
+    static constexpr uint32_t SLOTS_PER_LEVEL = 1u << SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = SLOTS_PER_LEVEL - 1;
+    static constexpr uint32_t WHEEL_LEVELS = 6;
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << (31 - INDEX_BITS)) - 1;
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        uint32_t generation = 1;
+        uint32_t prev = NIL;
+        uint32_t next = NIL;  // Also links the free list.
+        uint32_t bucket = NIL;  // level * SLOTS_PER_LEVEL + slot, NIL if not linked.
+        bool used = false;
+        bool catchUp = false;
+        uint64_t expiryNs = 0;
+        uint64_t periodNs = 0;
+        uint64_t slackNs = 0;
+        Callback callback;
+    };
+
+    uint32_t MakeId(uint32_t index) const
+    {
+        return (nodes_[index].generation << INDEX_BITS) | index;
+    }
+
+    bool Lookup(uint32_t timerId, uint32_t& index) const;
+    uint64_t ExpiryTick(const Node& node) const;
+    void Link(uint32_t index);
+    void Unlink(uint32_t index);
+    uint32_t DetachBucket(uint32_t bucket);
+    void Free(uint32_t index);
+    bool NextEventTick(uint64_t& tick) const;
+    void Step(uint64_t tick, uint64_t nowNs, std::vector<ExpiredTimer>& expired);
+
+    uint64_t tickNs_;
+    uint64_t curTick_;  // Last tick which has been processed.
+    size_t size_;
+    uint32_t freeHead_;
+    std::vector<Node> nodes_;
+    uint32_t heads_[WHEEL_LEVELS * SLOTS_PER_LEVEL];
+    uint64_t occupied_[WHEEL_LEVELS];
+};
+
+} // namespace Utils
+} // namespace OHOS
+#endif
@@ -28,12 +28,15 @@
 #include <algorithm>
 #include <list>
 #include <map>
+#include <vector>
 #include <functional>
 #include <iostream>
 #include "common_timer_errors.h"
 #include "common_event_sys_errors.h"
 #include "io_event_handler.h"
 #include "io_event_reactor.h"
+#include "io_event_reactor_group.h"
+#include <sys/eventfd.h>
 #include <sys/time.h>
 #include "benchmark_log.h"
 #include "benchmark_assert.h"
@@ -673,6 +676,223 @@ BENCHMARK_F(BenchmarkEventTest, testEvent006)(benchmark::State& state)
     BENCHMARK_LOGD("EventTest testEvent006 end.");
 }
 
+// Every fd stays readable: its callback consumes the eventfd and writes it again, so each loop handles
+// events as fast as it can, and the throughput is only bound by the number of loops.
+static void RunReactorGroupThroughput(benchmark::State& state, size_t loopNum)
+{
+    const int fdNum = 64;
+    const uint64_t eventsPerIteration = 2000;
+    IOEventReactorGroup group(loopNum);
+    AssertEqual(group.SetUp(), EVENT_SYS_ERR_OK, "group.SetUp() did not equal EVENT_SYS_ERR_OK as expected.", state);
+
+    std::atomic<uint64_t> events(0);
+    std::vector<int> fds;
+    std::vector<std::unique_ptr<IOEventHandler>> handlers;
+    for (int i = 0; i < fdNum; i++) {
+        int fd = eventfd(1, EFD_NONBLOCK | EFD_CLOEXEC);
+        AssertUnequal(fd, INVALID_FD, "fd was not different from INVALID_FD as expected.", state);
+        fds.push_back(fd);
+        handlers.push_back(std::make_unique<IOEventHandler>(fd, Events::EVENT_READ, [fd, &events] {
+            uint64_t value = 0;
+            if (read(fd, &value, sizeof(value)) == sizeof(value)) {
+                events.fetch_add(1, std::memory_order_relaxed);
+                write(fd, &value, sizeof(value));
+            }
+        }));
+        AssertEqual(group.AddHandler(handlers.back().get()), EVENT_SYS_ERR_OK,
+            "group.AddHandler() did not equal EVENT_SYS_ERR_OK as expected.", state);
+    }
+    AssertEqual(group.Start(), EVENT_SYS_ERR_OK, "group.Start() did not equal EVENT_SYS_ERR_OK as expected.", state);
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t startEvents = events.load();
+    while (state.KeepRunning()) {
+        uint64_t target = events.load() + eventsPerIteration;
+        while (events.load() < target) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50)); // 50: poll the progress of the loops
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    state.counters["eventsPerSec"] = (events.load() - startEvents) / elapsed.count();
+
+    group.Stop();
+    for (int i = 0; i < fdNum; i++) {
+        group.RemoveHandler(handlers[i].get());
+        close(fds[i]);
+    }
+}
+
+/*
+ * @tc.name: testIOEventReactorGroup001
+ * @tc.desc: event throughput of a reactor group with one loop.
+ */
+BENCHMARK_F(BenchmarkEventTest, testIOEventReactorGroup001)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("EventTest testIOEventReactorGroup001 start.");
+    RunReactorGroupThroughput(state, 1); // 1: loops
+    BENCHMARK_LOGD("EventTest testIOEventReactorGroup001 end.");
+}
+
+/*
+ * @tc.name: testIOEventReactorGroup002
+ * @tc.desc: event throughput of a reactor group with two loops.
+ */
+BENCHMARK_F(BenchmarkEventTest, testIOEventReactorGroup002)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("EventTest testIOEventReactorGroup002 start.");
+    RunReactorGroupThroughput(state, 2); // 2: loops
+    BENCHMARK_LOGD("EventTest testIOEventReactorGroup002 end.");
+}
+
+/*
+ * @tc.name: testIOEventReactorGroup003
+ * @tc.desc: event throughput of a reactor group with four loops.
+ */
+BENCHMARK_F(BenchmarkEventTest, testIOEventReactorGroup003)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("EventTest testIOEventReactorGroup003 start.");
+    RunReactorGroupThroughput(state, 4); // 4: loops
+    BENCHMARK_LOGD("EventTest testIOEventReactorGroup003 end.");
+}
+
+/*
+ * @tc.name: testIOEventEpoll001
+ * @tc.desc: syscalls per loop iteration when callbacks toggle the write interest of their fd, as a writer
+ * draining its buffer does.
+ */
+BENCHMARK_F(BenchmarkEventTest, testIOEventEpoll001)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("EventTest testIOEventEpoll001 start.");
+    const int fdNum = 64;
+    const uint64_t eventsPerIteration = 2000;
+    std::unique_ptr<IOEventReactor> reactor = std::make_unique<IOEventReactor>();
+    AssertEqual(reactor->SetUp(), EVENT_SYS_ERR_OK,
+        "reactor->SetUp() did not equal EVENT_SYS_ERR_OK as expected.", state);
+    reactor->EnableHandling();
+
+    std::atomic<uint64_t> events(0);
+    std::vector<std::unique_ptr<IOEventHandler>> handlers;
+    for (int i = 0; i < fdNum; i++) {
+        int fd = eventfd(1, EFD_NONBLOCK | EFD_CLOEXEC);
+        AssertUnequal(fd, INVALID_FD, "fd was not different from INVALID_FD as expected.", state);
+        handlers.push_back(std::make_unique<IOEventHandler>(fd, Events::EVENT_READ));
+        IOEventHandler* handler = handlers.back().get();
+        handler->SetCallback([&reactor, &events, handler] {
+            handler->EnableWrite();
+            reactor->UpdateHandler(handler);
+            handler->DisableWrite();
+            reactor->UpdateHandler(handler);
+            events.fetch_add(1, std::memory_order_relaxed);
+        });
+        AssertEqual(reactor->AddHandler(handler), EVENT_SYS_ERR_OK,
+            "reactor->AddHandler() did not equal EVENT_SYS_ERR_OK as expected.", state);
+    }
+    std::thread loopThread([&reactor] { reactor->Run(-1); });
+
+    IOEventSyscallStats before = reactor->GetSyscallStats();
+    uint64_t startEvents = events.load();
+    while (state.KeepRunning()) {
+        uint64_t target = events.load() + eventsPerIteration;
+        while (events.load() < target) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50)); // 50: poll the progress of the loop
+        }
+    }
+    IOEventSyscallStats after = reactor->GetSyscallStats();
+    double waits = after.waitCalls - before.waitCalls;
+    state.counters["syscallsPerIteration"] = (waits + after.ctlCalls - before.ctlCalls) / waits;
+    state.counters["ctlPerEvent"] = static_cast<double>(after.ctlCalls - before.ctlCalls) /
+        (events.load() - startEvents);
+    state.counters["eventCapacity"] = after.eventCapacity;
+
+    reactor->Terminate();
+    loopThread.join();
+    for (auto& handler : handlers) {
+        reactor->RemoveHandler(handler.get());
+        close(handler->GetFd());
+    }
+    BENCHMARK_LOGD("EventTest testIOEventEpoll001 end.");
+}
+
+// Every callback drains its fd, toggles its write interest and makes the fd readable again, so all fds stay busy.
+static void RunBackendPingPong(benchmark::State& state, IOEventBackendType type)
+{
+    const int fdNum = 256;
+    const uint64_t eventsPerIteration = 2000;
+    std::unique_ptr<IOEventReactor> reactor = std::make_unique<IOEventReactor>();
+    AssertEqual(reactor->SetUp(type), EVENT_SYS_ERR_OK,
+        "reactor->SetUp() did not equal EVENT_SYS_ERR_OK as expected.", state);
+    if (reactor->GetBackendType() != type) {
+        state.SkipWithError("Backend is not available.");
+        return;
+    }
+    reactor->EnableHandling();
+
+    std::atomic<uint64_t> events(0);
+    std::vector<std::unique_ptr<IOEventHandler>> handlers;
+    for (int i = 0; i < fdNum; i++) {
+        int fd = eventfd(1, EFD_NONBLOCK | EFD_CLOEXEC);
+        AssertUnequal(fd, INVALID_FD, "fd was not different from INVALID_FD as expected.", state);
+        handlers.push_back(std::make_unique<IOEventHandler>(fd, Events::EVENT_READ));
+        IOEventHandler* handler = handlers.back().get();
+        handler->SetCallback([&reactor, &events, handler] {
+            uint64_t value = 0;
+            read(handler->GetFd(), &value, sizeof(value));
+            handler->EnableWrite();
+            reactor->UpdateHandler(handler);
+            handler->DisableWrite();
+            reactor->UpdateHandler(handler);
+            write(handler->GetFd(), &value, sizeof(value));
+            events.fetch_add(1, std::memory_order_relaxed);
+        });
+        AssertEqual(reactor->AddHandler(handler), EVENT_SYS_ERR_OK,
+            "reactor->AddHandler() did not equal EVENT_SYS_ERR_OK as expected.", state);
+    }
+    std::thread loopThread([&reactor] { reactor->Run(-1); });
+
+    IOEventSyscallStats before = reactor->GetSyscallStats();
+    uint64_t startEvents = events.load();
+    while (state.KeepRunning()) {
+        uint64_t target = events.load() + eventsPerIteration;
+        while (events.load() < target) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50)); // 50: poll the progress of the loop
+        }
+    }
+    IOEventSyscallStats after = reactor->GetSyscallStats();
+    double handled = events.load() - startEvents;
+    double waits = after.waitCalls - before.waitCalls;
+    state.counters["backendSyscallsPerEvent"] = (waits + after.ctlCalls - before.ctlCalls) / handled;
+    state.counters["eventsPerWait"] = handled / waits;
+
+    reactor->Terminate();
+    loopThread.join();
+    for (auto& handler : handlers) {
+        reactor->RemoveHandler(handler.get());
+        close(handler->GetFd());
+    }
+}
+
+/*
+ * @tc.name: testIOEventBackend001
+ * @tc.desc: backend syscalls per event of epoll, with many busy fds.
+ */
+BENCHMARK_F(BenchmarkEventTest, testIOEventBackend001)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("EventTest testIOEventBackend001 start.");
+    RunBackendPingPong(state, IOEventBackendType::EPOLL);
+    BENCHMARK_LOGD("EventTest testIOEventBackend001 end.");
+}
+
+/*
+ * @tc.name: testIOEventBackend002
+ * @tc.desc: backend syscalls per event of io_uring, with many busy fds.
+ */
+BENCHMARK_F(BenchmarkEventTest, testIOEventBackend002)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("EventTest testIOEventBackend002 start.");
+    RunBackendPingPong(state, IOEventBackendType::IO_URING);
+    BENCHMARK_LOGD("EventTest testIOEventBackend002 end.");
+}
+
 // Try to substitue underlying implementation of OHOS::UTILS::TIMER
 class TimerEventHandler {
 public:
@@ -22,6 +22,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include "file_ex.h"
+#include "mapped_file.h"
 #include "benchmark_log.h"
 #include "benchmark_assert.h"
 using namespace std;
@@ -34,6 +35,8 @@ static constexpr char FILE_PATH[] = "./tmp1.txt";
 static constexpr char NULL_STR[] = "";
 static constexpr int MAX_FILE_LENGTH = 1 * 1024 * 1024;
 static constexpr int EXCEEDS_MAXIMUM_LENGTH = 32 * 1024 * 1024 + 1;
+static constexpr char LARGE_FILE_PATH[] = "./tmp_large.txt";
+static constexpr int LARGE_FILE_LENGTH = 100 * 1024 * 1024;
 
 class BenchmarkFileTest : public benchmark::Fixture {
 public:
@@ -59,6 +62,37 @@ protected:
     const int32_t iterations = 1000;
 };
 
+// Files of 100 MB are created once per repetition, and scanned a few times only.
+class BenchmarkLargeFileTest : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State& state) override
+    {
+        string content(LARGE_FILE_LENGTH, 'a');
+        content.replace(LARGE_FILE_LENGTH / 2, sizeof(MIDDLE_STR) - 1, MIDDLE_STR); // 2: half of the file
+        ofstream out(LARGE_FILE_PATH, ios_base::out | ios_base::trunc);
+        out << content;
+    }
+
+    void TearDown(const ::benchmark::State& state) override
+    {
+        unlink(LARGE_FILE_PATH);
+    }
+
+    BenchmarkLargeFileTest()
+    {
+        Iterations(iterations);
+        Repetitions(repetitions);
+        ReportAggregatesOnly();
+    }
+
+    ~BenchmarkLargeFileTest() override = default;
+
+protected:
+    static constexpr char MIDDLE_STR[] = "Middle of the file";
+    const int32_t repetitions = 3;
+    const int32_t iterations = 10;
+};
+
 bool CreateTestFile(const std::string& path, const std::string& content)
 {
     ofstream out(path, ios_base::out | ios_base::trunc);
@@ -988,6 +1022,66 @@ BENCHMARK_F(BenchmarkFileTest, testCountStrInFile005)(benchmark::State& state)
     }
     BENCHMARK_LOGD("FileTest testCountStrInFile005 end.");
 }
+
+/*
+ * @tc.name: testLoadRegionFromFile001
+ * @tc.desc: Map a file of 100 MB and read a byte of each page, without copying it.
+ */
+BENCHMARK_F(BenchmarkLargeFileTest, testLoadRegionFromFile001)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("FileTest testLoadRegionFromFile001 start.");
+    const long page = sysconf(_SC_PAGESIZE);
+    while (state.KeepRunning()) {
+        sptr<Utils::MappedRegion> region;
+        AssertTrue(LoadRegionFromFile(LARGE_FILE_PATH, region),
+            "LoadRegionFromFile(LARGE_FILE_PATH, region) did not equal true as expected.", state);
+        long sum = 0;
+        for (off_t offset = 0; offset < region->Size(); offset += page) {
+            sum += region->Begin()[offset];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * LARGE_FILE_LENGTH);
+    BENCHMARK_LOGD("FileTest testLoadRegionFromFile001 end.");
+}
+
+/*
+ * @tc.name: testStringExistsInFile008
+ * @tc.desc: Search the middle of a file of 100 MB, case sensitive and not.
+ */
+BENCHMARK_F(BenchmarkLargeFileTest, testStringExistsInFile008)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("FileTest testStringExistsInFile008 start.");
+    string str1 = "Middle of the file";
+    string str2 = "MIDDLE OF THE FILE";
+    while (state.KeepRunning()) {
+        AssertTrue(StringExistsInFile(LARGE_FILE_PATH, str1, true),
+            "StringExistsInFile(LARGE_FILE_PATH, str1, true) did not equal true as expected.", state);
+        AssertTrue(StringExistsInFile(LARGE_FILE_PATH, str2, false),
+            "StringExistsInFile(LARGE_FILE_PATH, str2, false) did not equal true as expected.", state);
+    }
+    state.SetBytesProcessed(state.iterations() * LARGE_FILE_LENGTH);
+    BENCHMARK_LOGD("FileTest testStringExistsInFile008 end.");
+}
+
+/*
+ * @tc.name: testCountStrInFile006
+ * @tc.desc: Count in the whole of a file of 100 MB, case sensitive and not.
+ */
+BENCHMARK_F(BenchmarkLargeFileTest, testCountStrInFile006)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("FileTest testCountStrInFile006 start.");
+    string str1 = "of the";
+    string str2 = "OF THE";
+    while (state.KeepRunning()) {
+        AssertEqual(CountStrInFile(LARGE_FILE_PATH, str1, true), 1,
+            "CountStrInFile(LARGE_FILE_PATH, str1, true) did not equal 1 as expected.", state);
+        AssertEqual(CountStrInFile(LARGE_FILE_PATH, str2, false), 1,
+            "CountStrInFile(LARGE_FILE_PATH, str2, false) did not equal 1 as expected.", state);
+    }
+    state.SetBytesProcessed(state.iterations() * LARGE_FILE_LENGTH * 2); // 2: files scanned per iteration
+    BENCHMARK_LOGD("FileTest testCountStrInFile006 end.");
+}
 }  // namespace
 }  // namespace OHOS
 // Run the benchmark
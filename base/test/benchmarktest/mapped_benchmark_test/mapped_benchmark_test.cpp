@@ -17,12 +17,14 @@
 #include "mapped_file.h"
 #include <fstream>
 #include <iostream>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include "common_mapped_file_errors.h"
 #include "directory_ex.h"
 #include "errors.h"
 #include "file_ex.h"
+#include "mapped_file_reader.h"
 #include "benchmark_log.h"
 #include "benchmark_assert.h"
 using namespace OHOS::Utils;
@@ -1803,6 +1805,120 @@ BENCHMARK_F(BenchmarkMappedFileTest, testMoveConstructor001)(benchmark::State& s
     }
     BENCHMARK_LOGD("MappedFileTest testMoveConstructor001 end.");
 }
+
+long PageFaults()
+{
+    struct rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt + usage.ru_majflt;
+}
+
+// Scans a file window by window with TurnNext(), reporting page faults per scan and the scan throughput.
+void ScanWithTurnNext(benchmark::State& state, const std::string& name, MapAdvice advice, bool prefetch)
+{
+    const off_t windowPages = 16;
+    const off_t filePages = 256;
+    std::string filename = name;
+    std::string content(MappedFile::PageSize() * filePages, 'S');
+    CreateFile(filename, content, state);
+
+    long faults = 0;
+    int64_t scanned = 0;
+    while (state.KeepRunning()) {
+        long before = PageFaults();
+        MappedFile mf(filename, MapMode::READ_ONLY, 0, MappedFile::PageSize() * windowPages);
+        mf.SetPrefetch(prefetch);
+        AssertEqual(mf.Advise(advice), MAPPED_FILE_ERR_OK,
+            "mf.Advise(advice) did not equal MAPPED_FILE_ERR_OK as expected.", state);
+        AssertEqual(mf.Map(), MAPPED_FILE_ERR_OK, "mf.Map() did not equal MAPPED_FILE_ERR_OK as expected.", state);
+
+        uint64_t sum = 0;
+        do {
+            // Touch one byte of each page, as a scan over the records would.
+            for (char* cur = mf.Begin(); cur <= mf.End(); cur += MappedFile::PageSize()) {
+                sum += static_cast<unsigned char>(*cur);
+            }
+            scanned += mf.Size();
+        } while (mf.TurnNext() == MAPPED_FILE_ERR_OK);
+        benchmark::DoNotOptimize(sum);
+        faults += PageFaults() - before;
+    }
+    state.SetBytesProcessed(scanned);
+    state.counters["faultsPerScan"] = static_cast<double>(faults) / state.iterations();
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testScanWithAdvice001
+ * @tc.desc: Scan a file with TurnNext() and no access hint.
+ */
+BENCHMARK_F(BenchmarkMappedFileTest, testScanWithAdvice001)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("MappedFileTest testScanWithAdvice001 start.");
+    ScanWithTurnNext(state, "test_scan_advice_1.txt", MapAdvice::NORMAL, false);
+    BENCHMARK_LOGD("MappedFileTest testScanWithAdvice001 end.");
+}
+
+/*
+ * @tc.name: testScanWithAdvice002
+ * @tc.desc: Scan a file with TurnNext(), hinting sequential access and prefetching the next window.
+ */
+BENCHMARK_F(BenchmarkMappedFileTest, testScanWithAdvice002)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("MappedFileTest testScanWithAdvice002 start.");
+    ScanWithTurnNext(state, "test_scan_advice_2.txt", MapAdvice::SEQUENTIAL, true);
+    BENCHMARK_LOGD("MappedFileTest testScanWithAdvice002 end.");
+}
+
+/*
+ * @tc.name: testScanWithAdvice003
+ * @tc.desc: Scan a file with TurnNext(), hinting random access.
+ */
+BENCHMARK_F(BenchmarkMappedFileTest, testScanWithAdvice003)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("MappedFileTest testScanWithAdvice003 start.");
+    ScanWithTurnNext(state, "test_scan_advice_3.txt", MapAdvice::RANDOM, false);
+    BENCHMARK_LOGD("MappedFileTest testScanWithAdvice003 end.");
+}
+
+/*
+ * @tc.name: testReaderScan001
+ * @tc.desc: Count the lines of a file with MappedFileReader, windows being mapped ahead of the cursor.
+ */
+BENCHMARK_F(BenchmarkMappedFileTest, testReaderScan001)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("MappedFileTest testReaderScan001 start.");
+    const off_t windowPages = 16;
+    const size_t lineLen = 99;
+    const size_t lineNum = 10000;
+    std::string filename = "test_reader_scan.txt";
+    std::string content;
+    for (size_t i = 0; i < lineNum; i++) {
+        content.append(lineLen, 'R').append("\n");
+    }
+    CreateFile(filename, content, state);
+
+    int64_t scanned = 0;
+    long faults = 0;
+    while (state.KeepRunning()) {
+        long before = PageFaults();
+        MappedFileReader reader(filename, RecordFormat::LINE, MappedFile::PageSize() * windowPages);
+        AssertEqual(reader.Open(), MAPPED_FILE_ERR_OK,
+            "reader.Open() did not equal MAPPED_FILE_ERR_OK as expected.", state);
+        size_t lines = 0;
+        for (const MappedRecord& line : reader) {
+            benchmark::DoNotOptimize(line.data);
+            lines++;
+        }
+        AssertEqual(lines, lineNum, "lines did not equal lineNum as expected.", state);
+        scanned += reader.FileSize();
+        faults += PageFaults() - before;
+    }
+    state.SetBytesProcessed(scanned);
+    state.counters["faultsPerScan"] = static_cast<double>(faults) / state.iterations();
+    RemoveTestFile(filename);
+    BENCHMARK_LOGD("MappedFileTest testReaderScan001 end.");
+}
 }  // namespace
 }  // namespace OHOS
 // Run the benchmark
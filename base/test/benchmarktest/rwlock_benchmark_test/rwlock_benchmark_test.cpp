@@ -16,6 +16,7 @@
 #include <benchmark/benchmark.h>
 #include <thread>
 #include <string>
+#include <vector>
 #include "rwlock.h"
 #include "benchmark_log.h"
 #include "benchmark_assert.h"
@@ -231,6 +232,63 @@ BENCHMARK_F(BenchmarkRWLockTest, testUniqueReadGuardScope001)(benchmark::State&
     }
     BENCHMARK_LOGD("RWLockTest testUniqueReadGuardScope001 end.");
 }
+
+const int READER_THREAD_NUM = 8;
+const int READ_LOOPS_PER_THREAD = 1000;
+
+// Runs READER_THREAD_NUM threads that repeatedly take and release the read lock.
+template <typename RWLockable>
+void RunConcurrentReaders(RWLockable& lock, const int& shared, benchmark::State& state)
+{
+    vector<thread> readers;
+    vector<int> sums(READER_THREAD_NUM, 0);
+    for (int i = 0; i < READER_THREAD_NUM; ++i) {
+        readers.emplace_back([&lock, &shared, &sums, i]() {
+            for (int j = 0; j < READ_LOOPS_PER_THREAD; ++j) {
+                OHOS::Utils::UniqueReadGuard<RWLockable> guard(lock);
+                sums[i] += shared;
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    for (int sum : sums) {
+        AssertEqual(sum, shared * READ_LOOPS_PER_THREAD, "sum did not equal expected value.", state);
+    }
+}
+
+/*
+ * @tc.name: testConcurrentReadRWLock001
+ * @tc.desc: Measures read lock throughput of RWLock with several reader threads and no writer.
+ * All readers update the same lock counter. Compare with testConcurrentReadBigReaderLock001.
+ */
+BENCHMARK_F(BenchmarkRWLockTest, testConcurrentReadRWLock001)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("RWLockTest testConcurrentReadRWLock001 start.");
+    OHOS::Utils::RWLock lock;
+    const int shared = 1;
+    while (state.KeepRunning()) {
+        RunConcurrentReaders(lock, shared, state);
+    }
+    BENCHMARK_LOGD("RWLockTest testConcurrentReadRWLock001 end.");
+}
+
+/*
+ * @tc.name: testConcurrentReadBigReaderLock001
+ * @tc.desc: Measures read lock throughput of BigReaderLock with several reader threads and no writer.
+ * Readers update per-slot counters, so the result is expected to scale with the number of cores.
+ */
+BENCHMARK_F(BenchmarkRWLockTest, testConcurrentReadBigReaderLock001)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("RWLockTest testConcurrentReadBigReaderLock001 start.");
+    OHOS::Utils::BigReaderLock lock;
+    const int shared = 1;
+    while (state.KeepRunning()) {
+        RunConcurrentReaders(lock, shared, state);
+    }
+    BENCHMARK_LOGD("RWLockTest testConcurrentReadBigReaderLock001 end.");
+}
 }  // namespace
 }  // namespace OHOS
 // Run the benchmark
@@ -16,11 +16,13 @@
 #include <benchmark/benchmark.h>
 #include "timer.h"
 #include "common_timer_errors.h"
+#include "thread_pool.h"
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include <stdatomic.h>
 #include <sys/time.h>
+#include <vector>
 #include "benchmark_log.h"
 #include "benchmark_assert.h"
 using namespace std;
@@ -354,6 +356,158 @@ BENCHMARK_F(BenchmarkTimerTest, testTimer011)(benchmark::State& state)
     BENCHMARK_LOGD("TimerTest testTimer011 end.");
 }
 
+/*
+ * @tc.name: testTimingWheel001
+ * @tc.desc: 100k concurrent periodic timers on the timing wheel engine, all of them registered,
+ * fired and unregistered through a single timerfd.
+ */
+BENCHMARK_F(BenchmarkTimerTest, testTimingWheel001)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("TimerTest testTimingWheel001 start.");
+    const int timerCount = 100000;
+    const uint32_t maxInterval = 100;
+    std::vector<uint32_t> timerIds(timerCount);
+    while (state.KeepRunning()) {
+        g_data1 = 0;
+        Utils::Timer timer("test_timer", 1000, Utils::Timer::TimerEngine::TIMING_WHEEL);
+        uint32_t ret = timer.Setup();
+        AssertEqual(Utils::TIMER_ERR_OK, ret, "Utils::TIMER_ERR_OK did not equal ret as expected.", state);
+        for (int i = 0; i < timerCount; ++i) {
+            timerIds[i] = timer.Register(TimeOutCallback1, static_cast<uint32_t>(i) % maxInterval + 1);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(maxInterval + 10)); // 10: margin for scheduling
+        for (uint32_t timerId : timerIds) {
+            timer.Unregister(timerId);
+        }
+        timer.Shutdown();
+        AssertGreaterThanOrEqual(g_data1, timerCount,
+            "g_data1 was not greater than or equal to timerCount as expected.", state);
+    }
+    BENCHMARK_LOGD("TimerTest testTimingWheel001 end.");
+}
+
+void RunLatencyWithSlowCallback(benchmark::State& state, ThreadPool* pool)
+{
+    const int fastTimerCount = 100;
+    const uint32_t fastInterval = 5;
+    const uint32_t slowInterval = 50;
+    const int timeoutMs = 100;
+    while (state.KeepRunning()) {
+        Utils::Timer timer("test_timer", timeoutMs, Utils::Timer::TimerEngine::TIMING_WHEEL);
+        timer.SetCallbackThreadPool(pool);
+        uint32_t ret = timer.Setup();
+        AssertEqual(Utils::TIMER_ERR_OK, ret, "Utils::TIMER_ERR_OK did not equal ret as expected.", state);
+        timer.Register([]() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); }, slowInterval);
+        for (int i = 0; i < fastTimerCount; ++i) {
+            timer.Register(TimeOutCallback1, fastInterval);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(slowInterval * 4)); // 4: let the slow one run 4 times
+        timer.Shutdown();
+
+        Utils::TimerLatencyStats stats = timer.GetLatencyStats();
+        AssertGreaterThan(stats.callbacks, 0u, "stats.callbacks was not greater than 0 as expected.", state);
+        const double nanoPerMicro = 1000.0;
+        state.counters["meanLatencyUs"] = stats.totalLatencyNs / nanoPerMicro / stats.callbacks;
+        state.counters["maxLatencyUs"] = stats.maxLatencyNs / nanoPerMicro;
+    }
+}
+
+/*
+ * @tc.name: testTimerLatency001
+ * @tc.desc: Latency of 100 fast periodic callbacks sharing the timer thread with a slow one.
+ */
+BENCHMARK_F(BenchmarkTimerTest, testTimerLatency001)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("TimerTest testTimerLatency001 start.");
+    RunLatencyWithSlowCallback(state, nullptr);
+    BENCHMARK_LOGD("TimerTest testTimerLatency001 end.");
+}
+
+/*
+ * @tc.name: testTimerLatency002
+ * @tc.desc: Same load as testTimerLatency001, with the callbacks dispatched to a thread pool.
+ */
+BENCHMARK_F(BenchmarkTimerTest, testTimerLatency002)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("TimerTest testTimerLatency002 start.");
+    ThreadPool pool("timer_pool");
+    pool.Start(4); // 4: threads to run the callbacks
+    RunLatencyWithSlowCallback(state, &pool);
+    pool.Stop();
+    BENCHMARK_LOGD("TimerTest testTimerLatency002 end.");
+}
+
+double MeasureHousekeepingWakeupsPerSec(std::chrono::nanoseconds slack, benchmark::State& state)
+{
+    const int timerCount = 2000;
+    const int intervalSpread = 100;
+    const int minIntervalMs = 50;
+    const int runMs = 300;
+    const int timeoutMs = 100;
+    Utils::Timer timer("test_timer", timeoutMs, Utils::Timer::TimerEngine::TIMING_WHEEL);
+    uint32_t ret = timer.Setup();
+    AssertEqual(Utils::TIMER_ERR_OK, ret, "Utils::TIMER_ERR_OK did not equal ret as expected.", state);
+    for (int i = 0; i < timerCount; ++i) {
+        timer.Register([](uint64_t) { g_data1 += 1; }, std::chrono::milliseconds(minIntervalMs + i % intervalSpread),
+            false, Utils::Timer::RepeatMode::SKIP_MISSED, slack);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(runMs));
+    timer.Shutdown();
+    const double msPerSec = 1000.0;
+    return timer.GetLatencyStats().wakeups * msPerSec / runMs;
+}
+
+/*
+ * @tc.name: testTimerSlack001
+ * @tc.desc: Wakeups per second of the timer thread for 2000 periodic housekeeping timers, with and without
+ * 20 ms of slack.
+ */
+BENCHMARK_F(BenchmarkTimerTest, testTimerSlack001)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("TimerTest testTimerSlack001 start.");
+    while (state.KeepRunning()) {
+        double precise = MeasureHousekeepingWakeupsPerSec(std::chrono::nanoseconds::zero(), state);
+        double coalesced = MeasureHousekeepingWakeupsPerSec(std::chrono::milliseconds(20), state);
+        AssertLessThan(coalesced, precise, "coalesced was not less than precise as expected.", state);
+        const double percent = 100.0;
+        state.counters["wakeupsPerSec"] = precise;
+        state.counters["wakeupsPerSecWithSlack"] = coalesced;
+        state.counters["reductionPercent"] = (precise - coalesced) * percent / precise;
+    }
+    BENCHMARK_LOGD("TimerTest testTimerSlack001 end.");
+}
+
+/*
+ * @tc.name: testTimerSlotMap001
+ * @tc.desc: 10k timers sharing one interval on the per-interval timerfd engine, registered, fired and
+ * unregistered in reverse order.
+ */
+BENCHMARK_F(BenchmarkTimerTest, testTimerSlotMap001)(benchmark::State& state)
+{
+    BENCHMARK_LOGD("TimerTest testTimerSlotMap001 start.");
+    const int timerCount = 10000;
+    const uint32_t interval = 10;
+    const int timeoutMs = 100;
+    std::vector<uint32_t> timerIds(timerCount);
+    while (state.KeepRunning()) {
+        g_data1 = 0;
+        Utils::Timer timer("test_timer", timeoutMs);
+        uint32_t ret = timer.Setup();
+        AssertEqual(Utils::TIMER_ERR_OK, ret, "Utils::TIMER_ERR_OK did not equal ret as expected.", state);
+        for (int i = 0; i < timerCount; ++i) {
+            timerIds[i] = timer.Register(TimeOutCallback1, interval);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval * 2)); // 2: let it fire at least once
+        for (auto it = timerIds.rbegin(); it != timerIds.rend(); ++it) {
+            timer.Unregister(*it);
+        }
+        timer.Shutdown();
+        AssertGreaterThanOrEqual(g_data1, timerCount,
+            "g_data1 was not greater than or equal to timerCount as expected.", state);
+    }
+    BENCHMARK_LOGD("TimerTest testTimerSlotMap001 end.");
+}
+
 /*
  * @tc.name: testTimer012
  * @tc.desc: Test double setup.
@@ -16,8 +16,12 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <sys/wait.h>
 #include <gtest/gtest.h>
 #include "directory_ex.h"
 #include "securec.h"
@@ -25,6 +29,8 @@
 #include "parcel.h"
 #include "refbase.h"
 #include "ashmem.h"
+#include "ashmem_pool.h"
+#include "ashmem_ring_buffer.h"
 
 using namespace testing::ext;
 using namespace std;
@@ -368,5 +374,409 @@ HWTEST_F(UtilsAshmemTest, test_ashmem_InvalidOperation_006, TestSize.Level0)
     ashmem->CloseAshmem();
     EXPECT_FALSE(ret);
 }
+
+/**
+ * @tc.name: test_ashmem_MapOptions_001
+ * @tc.desc: map ashmem with options and check the granted ones
+ * @tc.type: FUNC
+ */
+HWTEST_F(UtilsAshmemTest, test_ashmem_MapOptions_001, TestSize.Level0)
+{
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem(MEMORY_NAME.c_str(), MEMORY_SIZE);
+    ASSERT_TRUE(ashmem != nullptr);
+
+    int options = Ashmem::MAP_OPTION_POPULATE | Ashmem::MAP_OPTION_HUGE_PAGE | Ashmem::MAP_OPTION_LOCKED;
+    bool ret = ashmem->MapAshmem(PROT_READ | PROT_WRITE, options);
+    ASSERT_TRUE(ret);
+
+    // Options not granted do not fail the mapping, and only asked ones can be granted.
+    int granted = ashmem->GetGrantedMapOptions();
+    EXPECT_EQ(granted & ~options, 0);
+    EXPECT_NE(granted & Ashmem::MAP_OPTION_POPULATE, 0);
+    // A region smaller than a huge page can not be mapped by one, even though the kernel takes the advice.
+    EXPECT_EQ(granted & Ashmem::MAP_OPTION_HUGE_PAGE, 0);
+
+    ret = ashmem->WriteToAshmem(MEMORY_CONTENT.c_str(), sizeof(MEMORY_CONTENT), 0);
+    EXPECT_TRUE(ret);
+    auto readData = ashmem->ReadFromAshmem(sizeof(MEMORY_CONTENT), 0);
+    ASSERT_TRUE(readData != nullptr);
+    const char *readContent = reinterpret_cast<const char *>(readData);
+    EXPECT_EQ(memcmp(MEMORY_CONTENT.c_str(), readContent, sizeof(MEMORY_CONTENT)), 0);
+
+    ashmem->UnmapAshmem();
+    EXPECT_EQ(ashmem->GetGrantedMapOptions(), 0);
+
+    // Mapping without options grants none.
+    ret = ashmem->MapReadOnlyAshmem();
+    ASSERT_TRUE(ret);
+    EXPECT_EQ(ashmem->GetGrantedMapOptions(), 0);
+
+    ashmem->UnmapAshmem();
+    ashmem->CloseAshmem();
+}
+
+/**
+ * @tc.name: test_ashmem_Pool_001
+ * @tc.desc: allocate fixed size blocks from a pool, reusing its regions
+ * @tc.type: FUNC
+ */
+HWTEST_F(UtilsAshmemTest, test_ashmem_Pool_001, TestSize.Level0)
+{
+    const int32_t blockNum = 4;
+    AshmemPool pool(MEMORY_NAME.c_str(), MEMORY_SIZE * blockNum, MEMORY_SIZE, 2); // 2: regions at most
+    EXPECT_EQ(pool.GetRegionNum(), 0);
+    AshmemBlock block;
+    EXPECT_FALSE(pool.Allocate(MEMORY_SIZE + 1, block));
+    EXPECT_FALSE(pool.Allocate(0, block));
+
+    // Blocks of two regions, then no more.
+    std::vector<AshmemBlock> blocks(blockNum * 2); // 2: regions at most
+    for (AshmemBlock &cur : blocks) {
+        ASSERT_TRUE(pool.Allocate(MEMORY_CONTENT.size(), cur));
+        EXPECT_EQ(memcpy_s(cur.data, cur.length, MEMORY_CONTENT.c_str(), MEMORY_CONTENT.size()), EOK);
+    }
+    EXPECT_EQ(pool.GetRegionNum(), 2); // 2: regions at most
+    EXPECT_EQ(pool.GetUsedSize(), MEMORY_SIZE * blockNum * 2); // 2: regions at most
+    EXPECT_NE(blocks[0].regionId, blocks[blockNum].regionId);
+    EXPECT_EQ(blocks[1].offset, MEMORY_SIZE);
+    EXPECT_FALSE(pool.Allocate(1, block));
+
+    // The block written is read from its region.
+    sptr<Ashmem> region = pool.GetRegion(blocks[1].regionId);
+    ASSERT_TRUE(region != nullptr);
+    auto readData = region->ReadFromAshmem(MEMORY_CONTENT.size(), blocks[1].offset);
+    ASSERT_TRUE(readData != nullptr);
+    EXPECT_EQ(memcmp(readData, MEMORY_CONTENT.c_str(), MEMORY_CONTENT.size()), 0);
+
+    // A block freed is allocated again, and only once.
+    EXPECT_TRUE(pool.Free(blocks[1]));
+    EXPECT_FALSE(pool.Free(blocks[1]));
+    ASSERT_TRUE(pool.Allocate(1, block));
+    EXPECT_EQ(block.regionId, blocks[1].regionId);
+    EXPECT_EQ(block.offset, blocks[1].offset);
+    EXPECT_EQ(pool.GetRegionNum(), 2); // 2: regions at most
+
+    // Only regions with all blocks freed are trimmed.
+    for (int32_t index = blockNum; index < blockNum * 2; index++) { // 2: regions at most
+        EXPECT_TRUE(pool.Free(blocks[index]));
+    }
+    EXPECT_EQ(pool.Trim(), 1);
+    EXPECT_EQ(pool.GetRegionNum(), 1);
+    EXPECT_EQ(pool.GetUsedSize(), MEMORY_SIZE * blockNum);
+}
+
+/**
+ * @tc.name: test_ashmem_Pool_002
+ * @tc.desc: allocate blocks of any size from a pool, merging them when freed
+ * @tc.type: FUNC
+ */
+HWTEST_F(UtilsAshmemTest, test_ashmem_Pool_002, TestSize.Level0)
+{
+    AshmemPool pool(MEMORY_NAME.c_str(), MEMORY_SIZE, 0, 1);
+    AshmemBlock first;
+    AshmemBlock second;
+    AshmemBlock third;
+    ASSERT_TRUE(pool.Allocate(1, first));
+    ASSERT_TRUE(pool.Allocate(AshmemPool::BLOCK_ALIGN + 1, second));
+    ASSERT_TRUE(pool.Allocate(MEMORY_SIZE - AshmemPool::BLOCK_ALIGN * 3, third)); // 3: aligned size of the others
+    EXPECT_EQ(second.offset, AshmemPool::BLOCK_ALIGN);
+    EXPECT_EQ(third.offset, AshmemPool::BLOCK_ALIGN * 3); // 3: aligned size of the others
+    EXPECT_EQ(pool.GetUsedSize(), MEMORY_SIZE);
+
+    AshmemBlock block;
+    EXPECT_FALSE(pool.Allocate(1, block));
+
+    // The two first blocks freed are merged, and fit a larger one.
+    EXPECT_TRUE(pool.Free(second));
+    EXPECT_TRUE(pool.Free(first));
+    ASSERT_TRUE(pool.Allocate(AshmemPool::BLOCK_ALIGN * 3, block)); // 3: aligned size of the others
+    EXPECT_EQ(block.offset, 0);
+    EXPECT_FALSE(pool.Free(second));
+}
+
+/**
+ * @tc.name: test_ashmem_Pool_003
+ * @tc.desc: marshal a block of a pool through a parcel, and resolve it in a pool attaching its region
+ * @tc.type: FUNC
+ */
+HWTEST_F(UtilsAshmemTest, test_ashmem_Pool_003, TestSize.Level0)
+{
+    AshmemPool pool(MEMORY_NAME.c_str(), MEMORY_SIZE * 2); // 2: blocks of the region
+    AshmemBlock block;
+    ASSERT_TRUE(pool.Allocate(MEMORY_SIZE, block));
+    ASSERT_TRUE(pool.Allocate(MEMORY_CONTENT.size(), block));
+    EXPECT_EQ(memcpy_s(block.data, block.length, MEMORY_CONTENT.c_str(), MEMORY_CONTENT.size()), EOK);
+
+    Parcel parcel(nullptr);
+    EXPECT_TRUE(block.Marshalling(parcel));
+    AshmemBlock res;
+    EXPECT_TRUE(AshmemBlock::Unmarshalling(parcel, res));
+    EXPECT_EQ(res.poolId, pool.GetPoolId());
+    EXPECT_EQ(res.regionId, block.regionId);
+    EXPECT_EQ(res.offset, block.offset);
+    EXPECT_EQ(res.length, block.length);
+    EXPECT_EQ(res.data, nullptr);
+    EXPECT_FALSE(AshmemBlock::Unmarshalling(parcel, res));
+
+    // The region is received as by another process, with its own descriptor, and attached with its ids.
+    AshmemPool peer(MEMORY_NAME.c_str());
+    EXPECT_NE(peer.GetPoolId(), pool.GetPoolId());
+    EXPECT_FALSE(peer.Resolve(res));
+    sptr<Ashmem> region = pool.GetRegion(block.regionId);
+    ASSERT_TRUE(region != nullptr);
+    sptr<Ashmem> received = new Ashmem(dup(region->GetAshmemFd()), region->GetAshmemSize());
+    EXPECT_FALSE(peer.AttachRegion(pool.GetPoolId(), -1, received));
+    EXPECT_FALSE(peer.AttachRegion(peer.GetPoolId(), block.regionId, received));
+    ASSERT_TRUE(peer.AttachRegion(pool.GetPoolId(), block.regionId, received));
+    EXPECT_FALSE(peer.AttachRegion(pool.GetPoolId(), block.regionId, received));
+    EXPECT_EQ(peer.GetRegion(block.regionId), nullptr);
+
+    // The block is resolved in the attached region, and cannot be freed by the peer.
+    ASSERT_TRUE(peer.Resolve(res));
+    EXPECT_NE(res.data, block.data);
+    EXPECT_EQ(memcmp(res.data, MEMORY_CONTENT.c_str(), MEMORY_CONTENT.size()), 0);
+    EXPECT_FALSE(peer.Free(res));
+    res.offset = MEMORY_SIZE * 2; // 2: blocks of the region, past its end
+    EXPECT_FALSE(peer.Resolve(res));
+
+    // Attached regions are not trimmed, but detached.
+    EXPECT_EQ(peer.Trim(), 0);
+    EXPECT_TRUE(peer.DetachRegion(pool.GetPoolId(), block.regionId));
+    EXPECT_FALSE(peer.DetachRegion(pool.GetPoolId(), block.regionId));
+    EXPECT_EQ(peer.GetRegionNum(), 0);
+}
+
+/**
+ * @tc.name: test_ashmem_Pool_004
+ * @tc.desc: attach the regions of the same id of two pools to a pool allocating blocks of its own
+ * @tc.type: FUNC
+ */
+HWTEST_F(UtilsAshmemTest, test_ashmem_Pool_004, TestSize.Level0)
+{
+    // 1. Each pool allocates a block in its region 0, holding its own content
+    const int poolNum = 3; // 3: the receiver and two senders
+    std::vector<std::unique_ptr<AshmemPool>> pools;
+    std::vector<AshmemBlock> blocks(poolNum);
+    for (int i = 0; i < poolNum; i++) {
+        pools.push_back(std::make_unique<AshmemPool>(MEMORY_NAME.c_str(), MEMORY_SIZE));
+        ASSERT_TRUE(pools[i]->Allocate(sizeof(int), blocks[i]));
+        EXPECT_EQ(blocks[i].regionId, 0);
+        *static_cast<int *>(blocks[i].data) = i;
+    }
+
+    // 2. The receiver attaches region 0 of both senders, its own region 0 being kept
+    AshmemPool &receiver = *pools[0];
+    for (int i = 1; i < poolNum; i++) {
+        sptr<Ashmem> region = pools[i]->GetRegion(0);
+        ASSERT_TRUE(region != nullptr);
+        sptr<Ashmem> received = new Ashmem(dup(region->GetAshmemFd()), region->GetAshmemSize());
+        ASSERT_TRUE(receiver.AttachRegion(pools[i]->GetPoolId(), 0, received));
+    }
+    EXPECT_EQ(receiver.GetRegionNum(), poolNum);
+
+    // 3. Each block, passed through a parcel, is resolved in the region of its pool
+    for (int i = 0; i < poolNum; i++) {
+        Parcel parcel(nullptr);
+        ASSERT_TRUE(blocks[i].Marshalling(parcel));
+        AshmemBlock res;
+        ASSERT_TRUE(AshmemBlock::Unmarshalling(parcel, res));
+        ASSERT_TRUE(receiver.Resolve(res));
+        EXPECT_EQ(*static_cast<int *>(res.data), i);
+    }
+
+    // 4. The receiver still allocates from its own regions, and frees its blocks only
+    AshmemBlock block;
+    ASSERT_TRUE(receiver.Allocate(sizeof(int), block));
+    EXPECT_EQ(block.regionId, 0);
+    EXPECT_EQ(block.poolId, receiver.GetPoolId());
+    EXPECT_FALSE(receiver.Free(blocks[1]));
+    EXPECT_TRUE(receiver.Free(blocks[0]));
+    EXPECT_TRUE(receiver.Free(block));
+    EXPECT_TRUE(receiver.DetachRegion(pools[1]->GetPoolId(), 0));
+    EXPECT_FALSE(receiver.Resolve(blocks[1]));
+    EXPECT_TRUE(receiver.Resolve(blocks[2]));
+}
+
+/**
+ * @tc.name: test_ashmem_RingBuffer_001
+ * @tc.desc: write and read records of a ring buffer, wrapping around its end
+ * @tc.type: FUNC
+ */
+HWTEST_F(UtilsAshmemTest, test_ashmem_RingBuffer_001, TestSize.Level0)
+{
+    sptr<AshmemRingBuffer> ring = AshmemRingBuffer::Create(MEMORY_NAME.c_str(), MEMORY_SIZE);
+    EXPECT_EQ(ring, nullptr);
+    ring = AshmemRingBuffer::Create(MEMORY_NAME.c_str(), AshmemRingBuffer::MIN_CAPACITY);
+    ASSERT_NE(ring, nullptr);
+    EXPECT_FALSE(ring->Write(MEMORY_CONTENT.c_str(), ring->GetMaxRecordSize() + 1));
+
+    const void *data = nullptr;
+    uint32_t size = 0;
+    EXPECT_FALSE(ring->Peek(data, size));
+    // 3: records filling the buffer but its last 16 bytes, the next one does not fit before its end
+    const uint32_t length = AshmemRingBuffer::MIN_CAPACITY / 3 / 8 * 8; // 8: records are aligned to 8 bytes
+    std::vector<char> record(length - AshmemRingBuffer::RECORD_HEADER_SIZE, 'a');
+    for (int i = 0; i < 3; i++) { // 3: records written
+        EXPECT_TRUE(ring->Write(record.data(), record.size()));
+    }
+    EXPECT_EQ(ring->GetUsedSize(), length * 3); // 3: records written
+    EXPECT_FALSE(ring->Write(record.data(), ring->GetMaxRecordSize()));
+
+    std::vector<char> buffer(length);
+    EXPECT_FALSE(ring->Read(buffer.data(), 1, size));
+    EXPECT_EQ(size, record.size());
+    EXPECT_TRUE(ring->Read(buffer.data(), buffer.size(), size));
+    EXPECT_EQ(memcmp(buffer.data(), record.data(), size), 0);
+    EXPECT_TRUE(ring->Read(buffer.data(), buffer.size(), size));
+
+    // It wraps around, padding the end of the buffer.
+    EXPECT_TRUE(ring->Write(MEMORY_CONTENT.c_str(), MEMORY_CONTENT.size() + 1));
+    EXPECT_TRUE(ring->Peek(data, size));
+    EXPECT_EQ(size, record.size());
+    ring->Pop();
+    ASSERT_TRUE(ring->Peek(data, size));
+    EXPECT_STREQ(static_cast<const char *>(data), MEMORY_CONTENT.c_str());
+    EXPECT_EQ(data, ring->GetAshmem()->ReadFromAshmem(size, ring->GetAshmem()->GetAshmemSize() -
+        AshmemRingBuffer::MIN_CAPACITY + AshmemRingBuffer::RECORD_HEADER_SIZE));
+    ring->Pop();
+    EXPECT_EQ(ring->GetUsedSize(), 0);
+
+    // A region mapped read-only is refused, and kept mapped as it was.
+    int32_t regionSize = ring->GetAshmem()->GetAshmemSize();
+    sptr<Ashmem> readOnly = new Ashmem(dup(ring->GetAshmem()->GetAshmemFd()), regionSize);
+    ASSERT_TRUE(readOnly->MapReadOnlyAshmem());
+    const char *mapped = readOnly->GetReadView(regionSize, 0).data;
+    EXPECT_EQ(AshmemRingBuffer::Attach(readOnly), nullptr);
+    EXPECT_EQ(readOnly->GetReadView(regionSize, 0).data, mapped);
+}
+
+/**
+ * @tc.name: test_ashmem_RingBuffer_002
+ * @tc.desc: stream records from another process attached to a ring buffer
+ * @tc.type: FUNC
+ */
+HWTEST_F(UtilsAshmemTest, test_ashmem_RingBuffer_002, TestSize.Level0)
+{
+    sptr<AshmemRingBuffer> ring = AshmemRingBuffer::Create(MEMORY_NAME.c_str(), AshmemRingBuffer::MIN_CAPACITY);
+    ASSERT_NE(ring, nullptr);
+    const int count = 10000;
+    const int64_t timeoutMs = 5000; // 5000: wait for the peer, which may fail, with a limit
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        sptr<Ashmem> ashmem = new Ashmem(dup(ring->GetAshmem()->GetAshmemFd()), ring->GetAshmem()->GetAshmemSize());
+        sptr<AshmemRingBuffer> producer = AshmemRingBuffer::Attach(ashmem);
+        bool res = producer != nullptr;
+        for (int i = 0; res && i < count; i++) {
+            res = producer->Write(&i, sizeof(i), timeoutMs);
+        }
+        _exit(res ? 0 : 1);
+    }
+
+    int value = -1;
+    uint32_t size = 0;
+    for (int i = 0; i < count; i++) {
+        ASSERT_TRUE(ring->Read(&value, sizeof(value), size, timeoutMs));
+        ASSERT_EQ(value, i);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_FALSE(ring->Read(&value, sizeof(value), size, 10)); // 10: wait briefly for no record
+}
+
+/**
+ * @tc.name: test_ashmem_RingBuffer_003
+ * @tc.desc: write records of a ring buffer from multiple producers
+ * @tc.type: FUNC
+ */
+HWTEST_F(UtilsAshmemTest, test_ashmem_RingBuffer_003, TestSize.Level0)
+{
+    sptr<AshmemRingBuffer> ring = AshmemRingBuffer::Create(MEMORY_NAME.c_str(), AshmemRingBuffer::MIN_CAPACITY,
+                                                           true);
+    ASSERT_NE(ring, nullptr);
+    EXPECT_TRUE(ring->IsMultiProducer());
+    const int producers = 4;
+    const int count = 10000;
+    std::vector<std::thread> threads;
+    for (int id = 0; id < producers; id++) {
+        threads.emplace_back([ring, id] {
+            // The size varies, so that records wrap around at different places.
+            int record[8] = {id}; // 8: largest number of ints written
+            for (int i = 0; i < count; i++) {
+                record[1] = i;
+                ring->Write(record, sizeof(int) * (2 + i % 7), -1); // 2, 7: sizes from 2 to 8 ints
+            }
+        });
+    }
+
+    std::vector<int> next(producers, 0);
+    int record[8] = {0}; // 8: largest number of ints written
+    uint32_t size = 0;
+    for (int i = 0; i < producers * count; i++) {
+        ASSERT_TRUE(ring->Read(record, sizeof(record), size, -1));
+        ASSERT_EQ(size, sizeof(int) * (2 + record[1] % 7)); // 2, 7: sizes from 2 to 8 ints
+        ASSERT_EQ(record[1], next[record[0]]++);
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(ring->GetUsedSize(), 0);
+}
+
+/**
+ * @tc.name: test_ashmem_View_001
+ * @tc.desc: serialize data in place through a write view and read it back
+ * @tc.type: FUNC
+ */
+HWTEST_F(UtilsAshmemTest, test_ashmem_View_001, TestSize.Level0)
+{
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem(MEMORY_NAME.c_str(), MEMORY_SIZE);
+    ASSERT_NE(ashmem, nullptr);
+    EXPECT_FALSE(ashmem->GetWriteView(MEMORY_SIZE, 0).IsValid());
+    ASSERT_TRUE(ashmem->MapReadAndWriteAshmem());
+
+    EXPECT_FALSE(ashmem->GetWriteView(MEMORY_SIZE, 1).IsValid());
+    EXPECT_FALSE(ashmem->GetReadView(-1, 0).IsValid());
+    AshmemWriteView view = ashmem->GetWriteView(MEMORY_SIZE / 2, MEMORY_SIZE / 2); // 2: the second half
+    ASSERT_TRUE(view.IsValid());
+    EXPECT_EQ(view.offset, MEMORY_SIZE / 2); // 2: the second half
+    int written = sprintf_s(view.data, view.size, "%s", MEMORY_CONTENT.c_str());
+    ASSERT_GT(written, 0);
+    EXPECT_TRUE(ashmem->CommitWrite(view, written + 1));
+    EXPECT_FALSE(ashmem->CommitWrite(view, view.size + 1));
+
+    AshmemReadView res = ashmem->GetReadView(written + 1, MEMORY_SIZE / 2); // 2: the second half
+    ASSERT_TRUE(res.IsValid());
+    EXPECT_EQ(res.data, view.data);
+    EXPECT_STREQ(res.data, MEMORY_CONTENT.c_str());
+    EXPECT_EQ(std::string(res.begin(), res.end() - 1), MEMORY_CONTENT);
+
+    ashmem->UnmapAshmem();
+    ashmem->CloseAshmem();
+}
+
+/**
+ * @tc.name: test_ashmem_View_002
+ * @tc.desc: views checked against the protection and the current mapping
+ * @tc.type: FUNC
+ */
+HWTEST_F(UtilsAshmemTest, test_ashmem_View_002, TestSize.Level0)
+{
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem(MEMORY_NAME.c_str(), MEMORY_SIZE);
+    ASSERT_NE(ashmem, nullptr);
+    ASSERT_TRUE(ashmem->MapReadAndWriteAshmem());
+    AshmemWriteView view = ashmem->GetWriteView(MEMORY_SIZE, 0);
+    ASSERT_TRUE(view.IsValid());
+
+    ashmem->UnmapAshmem();
+    EXPECT_FALSE(ashmem->CommitWrite(view, 0));
+    ASSERT_TRUE(ashmem->MapReadOnlyAshmem());
+    EXPECT_FALSE(ashmem->GetWriteView(MEMORY_SIZE, 0).IsValid());
+    EXPECT_TRUE(ashmem->GetReadView(MEMORY_SIZE, 0).IsValid());
+
+    ashmem->UnmapAshmem();
+    ashmem->CloseAshmem();
+}
 }  // namespace
 }  // namespace OHOS
\ No newline at end of file
@@ -16,9 +16,12 @@
 #include <gtest/gtest.h>
 #include <sys/types.h>
 #include <sys/timerfd.h>
+#include <sys/resource.h>
+#include <fcntl.h>
 #include <sys/prctl.h>
 #include <sys/time.h>
 #include "unistd.h"
+#include <climits>
 #include <cstdint>
 #include <cstring>
 #include <string>
@@ -35,6 +38,8 @@
 #include "common_event_sys_errors.h"
 #include "io_event_handler.h"
 #include "io_event_reactor.h"
+#include "io_event_reactor_group.h"
+#include <sys/eventfd.h>
 
 using namespace testing::ext;
 using namespace OHOS::Utils;
@@ -542,6 +547,626 @@ HWTEST_F(UtilsEventTest, testEvent006, TestSize.Level0)
     loopThread.join();
 }
 
+static bool WaitFor(const std::function<bool()>& done)
+{
+    const int maxWaits = 1000;
+    for (int i = 0; i < maxWaits && !done(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return done();
+}
+
+/*
+ * @tc.name: testIOEventReactorGroup001
+ * @tc.desc: test fd assignment of the least-loaded policy, handling on the loop threads and cross-loop posting.
+ */
+HWTEST_F(UtilsEventTest, testIOEventReactorGroup001, TestSize.Level0)
+{
+    const size_t loopNum = 2;
+    const int fdNum = 4;
+    IOEventReactorGroup group(loopNum, IOEventReactorGroup::AssignPolicy::LEAST_LOADED);
+    ASSERT_EQ(group.SetUp(), EVENT_SYS_ERR_OK);
+    ASSERT_EQ(group.Start(), EVENT_SYS_ERR_OK);
+
+    // 1. Obtain the thread of each loop by posting to it
+    std::thread::id loopThreads[loopNum];
+    std::atomic<size_t> posted(0);
+    for (size_t i = 0; i < loopNum; i++) {
+        ASSERT_EQ(group.Post(i, [&loopThreads, &posted, i] {
+            loopThreads[i] = std::this_thread::get_id();
+            posted++;
+        }), EVENT_SYS_ERR_OK);
+    }
+    ASSERT_TRUE(WaitFor([&posted] { return posted == loopNum; }));
+    EXPECT_NE(loopThreads[0], loopThreads[1]);
+
+    // 2. Add handlers, fds are spread evenly
+    int fds[fdNum];
+    std::thread::id handledThreads[fdNum];
+    std::atomic<int> handled(0);
+    std::atomic<bool> crossPost(false);
+    std::atomic<bool> crossed(false);
+    std::thread::id crossedThread;
+    std::unique_ptr<IOEventHandler> handlers[fdNum];
+    for (int i = 0; i < fdNum; i++) {
+        fds[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        ASSERT_NE(fds[i], -1);
+        handlers[i] = std::make_unique<IOEventHandler>(fds[i], Events::EVENT_READ, [&, i] {
+            uint64_t value = 0;
+            EXPECT_EQ(read(fds[i], &value, sizeof(value)), static_cast<ssize_t>(sizeof(value)));
+            handledThreads[i] = std::this_thread::get_id();
+            handled++;
+            if (crossPost) {
+                group.Post(1, [&] {
+                    crossedThread = std::this_thread::get_id();
+                    crossed = true;
+                });
+            }
+        });
+        ASSERT_EQ(group.AddHandler(handlers[i].get()), EVENT_SYS_ERR_OK);
+        EXPECT_EQ(group.GetLoopIndex(fds[i]), i % static_cast<int>(loopNum));
+    }
+    EXPECT_EQ(group.GetLoopLoad(0), 2u);
+    EXPECT_EQ(group.GetLoopLoad(1), 2u);
+
+    // 3. Another handler of the same fd joins the loop of the fd
+    IOEventHandler extra(fds[0], Events::EVENT_READ, [] {});
+    ASSERT_EQ(group.AddHandler(&extra), EVENT_SYS_ERR_OK);
+    EXPECT_EQ(group.GetLoopIndex(fds[0]), 0);
+    EXPECT_EQ(group.GetLoopLoad(0), 2u);
+
+    // 4. Events are handled on the thread of the loop watching the fd
+    uint64_t one = 1;
+    for (int i = 0; i < fdNum; i++) {
+        ASSERT_EQ(write(fds[i], &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    }
+    ASSERT_TRUE(WaitFor([&handled] { return handled >= fdNum; }));
+    for (int i = 0; i < fdNum; i++) {
+        EXPECT_EQ(handledThreads[i], loopThreads[group.GetLoopIndex(fds[i])]);
+    }
+
+    // 5. A callback on one loop posts to another
+    crossPost = true;
+    ASSERT_EQ(write(fds[0], &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    ASSERT_TRUE(WaitFor([&crossed] { return crossed.load(); }));
+    EXPECT_EQ(crossedThread, loopThreads[1]);
+
+    // 6. Remove all handlers
+    EXPECT_EQ(group.RemoveHandler(&extra), EVENT_SYS_ERR_OK);
+    for (int i = 0; i < fdNum; i++) {
+        EXPECT_EQ(group.RemoveHandler(handlers[i].get()), EVENT_SYS_ERR_OK);
+        EXPECT_EQ(group.GetLoopIndex(fds[i]), -1);
+    }
+    EXPECT_EQ(group.GetLoopLoad(0), 0u);
+    EXPECT_EQ(group.GetLoopLoad(1), 0u);
+    group.Stop();
+    for (int i = 0; i < fdNum; i++) {
+        close(fds[i]);
+    }
+}
+
+/*
+ * @tc.name: testIOEventReactorGroup002
+ * @tc.desc: test fd-hash assignment and invalid operations of IOEventReactorGroup.
+ */
+HWTEST_F(UtilsEventTest, testIOEventReactorGroup002, TestSize.Level0)
+{
+    const size_t loopNum = 3;
+    IOEventReactorGroup group(loopNum);
+    EXPECT_EQ(group.GetLoopNum(), loopNum);
+    ASSERT_EQ(group.SetUp(), EVENT_SYS_ERR_OK);
+    ASSERT_EQ(group.Start(), EVENT_SYS_ERR_OK);
+    EXPECT_EQ(group.Start(), EVENT_SYS_ERR_ALREADY_STARTED);
+
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    ASSERT_NE(fd, -1);
+    IOEventHandler handler(fd, Events::EVENT_READ, [] {});
+    EXPECT_EQ(group.UpdateHandler(&handler), EVENT_SYS_ERR_OK);
+    EXPECT_EQ(group.GetLoopIndex(fd), fd % static_cast<int>(loopNum));
+    EXPECT_TRUE(handler.IsActive());
+    handler.EnableWrite();
+    EXPECT_EQ(group.UpdateHandler(&handler), EVENT_SYS_ERR_OK);
+    EXPECT_EQ(group.RemoveHandler(&handler), EVENT_SYS_ERR_OK);
+    EXPECT_EQ(group.RemoveHandler(&handler), EVENT_SYS_ERR_NOT_FOUND);
+
+    IOEventHandler badHandler;
+    EXPECT_EQ(group.AddHandler(nullptr), EVENT_SYS_ERR_NOT_FOUND);
+    EXPECT_EQ(group.AddHandler(&badHandler), EVENT_SYS_ERR_BADF);
+    EXPECT_EQ(group.Post(loopNum, [] {}), EVENT_SYS_ERR_NOT_FOUND);
+    EXPECT_EQ(group.GetReactor(loopNum), nullptr);
+    EXPECT_NE(group.GetReactor(0), nullptr);
+
+    group.Stop();
+    close(fd);
+}
+
+/*
+ * @tc.name: testIOEventReactorGroup003
+ * @tc.desc: test RemoveHandler() from another thread while the callback of the handler calls into the group.
+ */
+HWTEST_F(UtilsEventTest, testIOEventReactorGroup003, TestSize.Level0)
+{
+    IOEventReactorGroup group(1);
+    ASSERT_EQ(group.SetUp(), EVENT_SYS_ERR_OK);
+    ASSERT_EQ(group.Start(), EVENT_SYS_ERR_OK);
+
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    ASSERT_NE(fd, -1);
+    std::atomic<bool> entered(false);
+    std::atomic<bool> removing(false);
+    std::atomic<bool> removed(false);
+    std::atomic<ErrCode> updateRes(EVENT_SYS_ERR_FAILED);
+    IOEventHandler handler(fd, Events::EVENT_READ, [&] {
+        uint64_t value = 0;
+        read(fd, &value, sizeof(value));
+        entered = true;
+        WaitFor([&removing] { return removing.load(); });
+        // 10: let the other thread block in RemoveHandler() on this running callback
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        handler.EnableWrite();
+        updateRes = group.UpdateHandler(&handler);
+    });
+    ASSERT_EQ(group.AddHandler(&handler), EVENT_SYS_ERR_OK);
+
+    // 1. Remove the handler while its callback is running, which updates it through the group
+    std::thread remover([&] {
+        WaitFor([&entered] { return entered.load(); });
+        removing = true;
+        EXPECT_EQ(group.RemoveHandler(&handler), EVENT_SYS_ERR_OK);
+        removed = true;
+    });
+    uint64_t one = 1;
+    ASSERT_EQ(write(fd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    EXPECT_TRUE(WaitFor([&removed] { return removed.load(); }));
+    remover.join();
+    EXPECT_EQ(updateRes, EVENT_SYS_ERR_OK);
+
+    // 2. The fd is no longer assigned
+    EXPECT_EQ(group.GetLoopIndex(fd), -1);
+    EXPECT_EQ(group.GetLoopLoad(0), 0u);
+    group.Stop();
+    close(fd);
+}
+
+/*
+ * @tc.name: testIOEventReactor003
+ * @tc.desc: test handlers removed or released during dispatch. A handler released by an earlier callback is
+ * not invoked, and RemoveHandler() from another thread returns after the running callback of the handler.
+ */
+HWTEST_F(UtilsEventTest, testIOEventReactor003, TestSize.Level0)
+{
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    ASSERT_NE(fd, -1);
+    std::unique_ptr<IOEventReactor> reactor = std::make_unique<IOEventReactor>();
+    ASSERT_EQ(reactor->SetUp(), EVENT_SYS_ERR_OK);
+    reactor->EnableHandling();
+
+    // 1. handler2 is dispatched first, it removes and releases handler1
+    std::atomic<int> calls1(0);
+    std::atomic<int> calls2(0);
+    std::unique_ptr<IOEventHandler> handler1 = std::make_unique<IOEventHandler>(fd, Events::EVENT_READ,
+        [&calls1] { calls1++; });
+    std::unique_ptr<IOEventHandler> handler2;
+    handler2 = std::make_unique<IOEventHandler>(fd, Events::EVENT_READ, [&] {
+        calls2++;
+        if (handler1 != nullptr) {
+            EXPECT_EQ(reactor->RemoveHandler(handler1.get()), EVENT_SYS_ERR_OK);
+            handler1.reset();
+        }
+        uint64_t value = 0;
+        read(fd, &value, sizeof(value));
+    });
+    ASSERT_EQ(reactor->AddHandler(handler1.get()), EVENT_SYS_ERR_OK);
+    ASSERT_EQ(reactor->AddHandler(handler2.get()), EVENT_SYS_ERR_OK);
+    std::thread loopThread([&reactor] { reactor->Run(-1); });
+
+    uint64_t one = 1;
+    ASSERT_EQ(write(fd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    ASSERT_TRUE(WaitFor([&calls2] { return calls2 >= 1; }));
+    EXPECT_EQ(calls1, 0);
+
+    // 2. RemoveHandler() waits for the running callback
+    std::atomic<bool> entered(false);
+    std::atomic<bool> finished(false);
+    IOEventHandler slow(fd, Events::EVENT_READ, [&] {
+        entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // 20: keep the callback running
+        finished = true;
+    });
+    ASSERT_EQ(reactor->AddHandler(&slow), EVENT_SYS_ERR_OK);
+    ASSERT_EQ(write(fd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    ASSERT_TRUE(WaitFor([&entered] { return entered.load(); }));
+    EXPECT_EQ(reactor->RemoveHandler(&slow), EVENT_SYS_ERR_OK);
+    EXPECT_TRUE(finished);
+
+    reactor->Terminate();
+    ASSERT_EQ(write(fd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    loopThread.join();
+    EXPECT_EQ(reactor->RemoveHandler(handler2.get()), EVENT_SYS_ERR_OK);
+    close(fd);
+}
+
+/*
+ * @tc.name: testIOEventReactor004
+ * @tc.desc: test interest changes made by callbacks are merged before the next poll, and the event array grows
+ * with the ready fds and shrinks back when idle.
+ */
+HWTEST_F(UtilsEventTest, testIOEventReactor004, TestSize.Level0)
+{
+    const int fdNum = 32;
+    const uint32_t initCapacity = 8;
+    std::unique_ptr<IOEventReactor> reactor = std::make_unique<IOEventReactor>();
+    ASSERT_EQ(reactor->SetUp(), EVENT_SYS_ERR_OK);
+    reactor->EnableHandling();
+
+    // 1. Each callback enables and disables writing, the interest of its fd ends up unchanged
+    int fds[fdNum];
+    std::unique_ptr<IOEventHandler> handlers[fdNum];
+    std::atomic<int> handled(0);
+    for (int i = 0; i < fdNum; i++) {
+        fds[i] = eventfd(1, EFD_NONBLOCK | EFD_CLOEXEC);
+        ASSERT_NE(fds[i], -1);
+        handlers[i] = std::make_unique<IOEventHandler>(fds[i], Events::EVENT_READ);
+        IOEventHandler* handler = handlers[i].get();
+        handler->SetCallback([&reactor, &handled, handler] {
+            uint64_t value = 0;
+            read(handler->GetFd(), &value, sizeof(value));
+            handler->EnableWrite();
+            reactor->UpdateHandler(handler);
+            handler->DisableWrite();
+            reactor->UpdateHandler(handler);
+            handled++;
+        });
+        ASSERT_EQ(reactor->AddHandler(handler), EVENT_SYS_ERR_OK);
+    }
+    IOEventSyscallStats before = reactor->GetSyscallStats();
+    EXPECT_EQ(before.ctlCalls, static_cast<uint64_t>(fdNum + 1)); // 1: the wakeup eventfd of the reactor
+    EXPECT_EQ(before.eventCapacity, initCapacity);
+
+    std::thread loopThread([&reactor] { reactor->Run(1); });
+    ASSERT_TRUE(WaitFor([&handled] { return handled == fdNum; }));
+    IOEventSyscallStats after = reactor->GetSyscallStats();
+    EXPECT_EQ(after.ctlCalls, before.ctlCalls);
+    EXPECT_GE(after.mergedChanges, static_cast<uint64_t>(fdNum));
+    EXPECT_GT(after.eventCapacity, initCapacity);
+
+    // 2. Idle polls shrink the event array
+    EXPECT_TRUE(WaitFor([&reactor, initCapacity] {
+        return reactor->GetSyscallStats().eventCapacity == initCapacity;
+    }));
+
+    reactor->Terminate();
+    loopThread.join();
+    for (int i = 0; i < fdNum; i++) {
+        EXPECT_EQ(reactor->RemoveHandler(handlers[i].get()), EVENT_SYS_ERR_OK);
+        close(fds[i]);
+    }
+}
+
+/*
+ * @tc.name: testIOEventReactor005
+ * @tc.desc: test the io_uring backend, or epoll where it is not available. Events are dispatched, interest
+ * changes made by callbacks cost no syscall of their own, and removed handlers are not invoked any more.
+ */
+HWTEST_F(UtilsEventTest, testIOEventReactor005, TestSize.Level0)
+{
+    const int fdNum = 16;
+    std::unique_ptr<IOEventReactor> reactor = std::make_unique<IOEventReactor>();
+    ASSERT_EQ(reactor->SetUp(IOEventBackendType::IO_URING), EVENT_SYS_ERR_OK);
+    bool uring = reactor->GetBackendType() == IOEventBackendType::IO_URING;
+    reactor->EnableHandling();
+
+    // 1. Each callback drains its fd and toggles writing
+    int fds[fdNum];
+    std::unique_ptr<IOEventHandler> handlers[fdNum];
+    std::atomic<int> handled(0);
+    for (int i = 0; i < fdNum; i++) {
+        fds[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        ASSERT_NE(fds[i], -1);
+        handlers[i] = std::make_unique<IOEventHandler>(fds[i], Events::EVENT_READ);
+        IOEventHandler* handler = handlers[i].get();
+        handler->SetCallback([&reactor, &handled, handler] {
+            uint64_t value = 0;
+            read(handler->GetFd(), &value, sizeof(value));
+            handler->EnableWrite();
+            reactor->UpdateHandler(handler);
+            handler->DisableWrite();
+            reactor->UpdateHandler(handler);
+            handled++;
+        });
+        ASSERT_EQ(reactor->AddHandler(handler), EVENT_SYS_ERR_OK);
+    }
+    // 2. The backend can not be changed with handlers added
+    EXPECT_EQ(reactor->SetUp(uring ? IOEventBackendType::EPOLL : IOEventBackendType::IO_URING),
+        EVENT_SYS_ERR_ALREADY_STARTED);
+
+    std::thread loopThread([&reactor] { reactor->Run(1); });
+    uint64_t one = 1;
+    IOEventSyscallStats before = reactor->GetSyscallStats();
+    for (int round = 1; round <= 2; round++) { // 2: readiness is reported again after being drained
+        for (int i = 0; i < fdNum; i++) {
+            ASSERT_EQ(write(fds[i], &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+        }
+        ASSERT_TRUE(WaitFor([&handled, round, fdNum] { return handled == round * fdNum; }));
+    }
+    if (uring) {
+        EXPECT_EQ(reactor->GetSyscallStats().ctlCalls, before.ctlCalls);
+    }
+
+    // 3. Removed handlers are not invoked
+    for (int i = 0; i < fdNum; i++) {
+        EXPECT_EQ(reactor->RemoveHandler(handlers[i].get()), EVENT_SYS_ERR_OK);
+        ASSERT_EQ(write(fds[i], &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // 20: leave the loop time to poll
+    EXPECT_EQ(handled, 2 * fdNum); // 2: rounds
+
+    reactor->Terminate();
+    loopThread.join();
+    for (int i = 0; i < fdNum; i++) {
+        close(fds[i]);
+    }
+}
+
+/*
+ * @tc.name: testIOEventReactor006
+ * @tc.desc: test edge-triggered, one-shot and exclusive modes. An undrained fd is reported once in ET mode, and
+ * once until re-armed by UpdateHandler() in one-shot mode on both backends. Exclusive mode is refused on io_uring.
+ */
+HWTEST_F(UtilsEventTest, testIOEventReactor006, TestSize.Level0)
+{
+    uint64_t one = 1;
+    for (IOEventBackendType type : {IOEventBackendType::EPOLL, IOEventBackendType::IO_URING}) {
+        std::unique_ptr<IOEventReactor> reactor = std::make_unique<IOEventReactor>();
+        ASSERT_EQ(reactor->SetUp(type), EVENT_SYS_ERR_OK);
+        reactor->EnableHandling();
+        int etFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        int oneshotFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        ASSERT_NE(etFd, -1);
+        ASSERT_NE(oneshotFd, -1);
+
+        // 1. Callbacks leave the fds readable
+        std::atomic<int> etCalls(0);
+        std::atomic<int> oneshotCalls(0);
+        IOEventHandler etHandler(etFd, Events::EVENT_READ | Events::EVENT_ET, [&etCalls] { etCalls++; });
+        IOEventHandler oneshotHandler(oneshotFd, Events::EVENT_READ | Events::EVENT_ONESHOT,
+            [&oneshotCalls] { oneshotCalls++; });
+        ASSERT_EQ(reactor->AddHandler(&etHandler), EVENT_SYS_ERR_OK);
+        ASSERT_EQ(reactor->AddHandler(&oneshotHandler), EVENT_SYS_ERR_OK);
+        std::thread loopThread([&reactor] { reactor->Run(1); });
+        ASSERT_EQ(write(etFd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+        ASSERT_EQ(write(oneshotFd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+        ASSERT_TRUE(WaitFor([&] { return etCalls == 1 && oneshotCalls == 1; }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // 20: leave the loop time to poll
+        EXPECT_EQ(etCalls, 1);
+        EXPECT_EQ(oneshotCalls, 1);
+
+        // 2. New data is reported in ET mode, the one-shot fd waits for being re-armed
+        ASSERT_EQ(write(etFd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+        ASSERT_EQ(write(oneshotFd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+        ASSERT_TRUE(WaitFor([&etCalls] { return etCalls == 2; }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // 20: leave the loop time to poll
+        EXPECT_EQ(oneshotCalls, 1);
+        EXPECT_EQ(reactor->UpdateHandler(&oneshotHandler), EVENT_SYS_ERR_OK);
+        ASSERT_TRUE(WaitFor([&oneshotCalls] { return oneshotCalls == 2; }));
+
+        reactor->Terminate();
+        loopThread.join();
+        EXPECT_EQ(reactor->RemoveHandler(&etHandler), EVENT_SYS_ERR_OK);
+        EXPECT_EQ(reactor->RemoveHandler(&oneshotHandler), EVENT_SYS_ERR_OK);
+        close(etFd);
+        close(oneshotFd);
+    }
+
+    // 3. An exclusive fd is shared by two reactors, and its events can be changed
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    ASSERT_NE(fd, -1);
+    std::atomic<int> calls(0);
+    std::unique_ptr<IOEventReactor> reactors[2]; // 2: reactors sharing the fd
+    std::unique_ptr<IOEventHandler> handlers[2]; // 2: reactors sharing the fd
+    std::thread loopThreads[2]; // 2: reactors sharing the fd
+    for (int i = 0; i < 2; i++) { // 2: reactors sharing the fd
+        reactors[i] = std::make_unique<IOEventReactor>();
+        ASSERT_EQ(reactors[i]->SetUp(), EVENT_SYS_ERR_OK);
+        reactors[i]->EnableHandling();
+        handlers[i] = std::make_unique<IOEventHandler>(fd, Events::EVENT_READ | Events::EVENT_EXCLUSIVE,
+            [&calls, fd] {
+                uint64_t value = 0;
+                if (read(fd, &value, sizeof(value)) == sizeof(value)) {
+                    calls++;
+                }
+            });
+        ASSERT_EQ(reactors[i]->AddHandler(handlers[i].get()), EVENT_SYS_ERR_OK);
+        handlers[i]->EnableWrite();
+        EXPECT_EQ(reactors[i]->UpdateHandler(handlers[i].get()), EVENT_SYS_ERR_OK);
+        handlers[i]->DisableWrite();
+        EXPECT_EQ(reactors[i]->UpdateHandler(handlers[i].get()), EVENT_SYS_ERR_OK);
+        IOEventReactor* reactor = reactors[i].get();
+        loopThreads[i] = std::thread([reactor] { reactor->Run(1); });
+    }
+    ASSERT_EQ(write(fd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    EXPECT_TRUE(WaitFor([&calls] { return calls == 1; }));
+    for (int i = 0; i < 2; i++) { // 2: reactors sharing the fd
+        reactors[i]->Terminate();
+        loopThreads[i].join();
+        EXPECT_EQ(reactors[i]->RemoveHandler(handlers[i].get()), EVENT_SYS_ERR_OK);
+    }
+
+    // 4. Exclusive mode has no counterpart for the polls of io_uring
+    std::unique_ptr<IOEventReactor> reactor = std::make_unique<IOEventReactor>();
+    ASSERT_EQ(reactor->SetUp(IOEventBackendType::IO_URING), EVENT_SYS_ERR_OK);
+    if (reactor->GetBackendType() == IOEventBackendType::IO_URING) {
+        IOEventHandler handler(fd, Events::EVENT_READ | Events::EVENT_EXCLUSIVE);
+        EXPECT_EQ(reactor->AddHandler(&handler), EVENT_SYS_ERR_FAILED);
+        EXPECT_EQ(reactor->RemoveHandler(&handler), EVENT_SYS_ERR_OK);
+    }
+    close(fd);
+}
+
+/*
+ * @tc.name: testIOEventReactor007
+ * @tc.desc: test the loop parks instead of spinning while handling is disabled or no handler is added, tasks
+ * posted from other threads run on the loop thread in order, and Terminate() ends an infinite wait at once.
+ */
+HWTEST_F(UtilsEventTest, testIOEventReactor007, TestSize.Level0)
+{
+    const int taskNum = 100;
+    std::unique_ptr<IOEventReactor> reactor = std::make_unique<IOEventReactor>();
+    ASSERT_EQ(reactor->SetUp(), EVENT_SYS_ERR_OK);
+    std::thread::id loopId;
+    std::atomic<int64_t> cpuNs(-1);
+    std::thread loopThread([&reactor, &loopId, &cpuNs] {
+        loopId = std::this_thread::get_id();
+        reactor->Run(-1);
+        struct timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        cpuNs = static_cast<int64_t>(ts.tv_sec) * NANO_TO_BASE + ts.tv_nsec;
+    });
+
+    // 1. Tasks run while handling is disabled, and after it is enabled
+    std::vector<int> order;
+    std::atomic<bool> onLoop(true);
+    for (int i = 0; i < taskNum; i++) {
+        if (i == taskNum / 2) { // 2: enable handling half way
+            std::this_thread::sleep_for(std::chrono::milliseconds(50)); // 50: stay disabled for a while
+            reactor->EnableHandling();
+        }
+        EXPECT_EQ(reactor->Post([&order, &onLoop, &loopId, i] {
+            onLoop = onLoop && (std::this_thread::get_id() == loopId);
+            order.push_back(i);
+        }), EVENT_SYS_ERR_OK);
+    }
+    std::atomic<bool> done(false);
+    EXPECT_EQ(reactor->Post([&done] { done = true; }), EVENT_SYS_ERR_OK);
+    ASSERT_TRUE(WaitFor([&done] { return done.load(); }));
+    EXPECT_TRUE(onLoop);
+    ASSERT_EQ(order.size(), static_cast<size_t>(taskNum));
+    for (int i = 0; i < taskNum; i++) {
+        EXPECT_EQ(order[i], i);
+    }
+    EXPECT_EQ(reactor->Post(nullptr), EVENT_SYS_ERR_FAILED);
+
+    // 2. Idle with no handler added, then Terminate() wakes the loop up
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // 50: stay idle for a while
+    reactor->Terminate();
+    loopThread.join();
+    // The loop slept for more than 100ms, spinning would have used about as much CPU.
+    EXPECT_GE(cpuNs, 0);
+    EXPECT_LT(cpuNs, 20 * MILLI_TO_NANO); // 20: ms of CPU time
+}
+
+/*
+ * @tc.name: testIOEventReactor008
+ * @tc.desc: test the fd limit follows RLIMIT_NOFILE and can be configured, handlers of high fds are dispatched
+ * along with low ones, and a handler released while added is removed from the reactor.
+ */
+HWTEST_F(UtilsEventTest, testIOEventReactor008, TestSize.Level0)
+{
+    struct rlimit limit;
+    ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &limit), 0);
+    std::unique_ptr<IOEventReactor> reactor = std::make_unique<IOEventReactor>();
+    ASSERT_EQ(reactor->SetUp(), EVENT_SYS_ERR_OK);
+    reactor->EnableHandling();
+    if (limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur <= INT_MAX) {
+        EXPECT_EQ(reactor->GetFdLimit(), static_cast<int>(limit.rlim_cur));
+    }
+    EXPECT_EQ(reactor->SetFdLimit(0), EVENT_SYS_ERR_FAILED);
+    if (limit.rlim_max != RLIM_INFINITY && limit.rlim_max < INT_MAX) {
+        EXPECT_EQ(reactor->SetFdLimit(static_cast<int>(limit.rlim_max) + 1), EVENT_SYS_ERR_FAILED);
+    }
+
+    // 1. A high fd, in a chunk of the fd table far from the low one
+    int lowFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    ASSERT_NE(lowFd, -1);
+    int highFd = fcntl(lowFd, F_DUPFD_CLOEXEC, reactor->GetFdLimit() - 1);
+    ASSERT_NE(highFd, -1);
+    std::atomic<int> lowCalls(0);
+    std::atomic<int> highCalls(0);
+    IOEventHandler lowHandler(lowFd, Events::EVENT_READ, [&lowCalls, lowFd] {
+        uint64_t value = 0;
+        read(lowFd, &value, sizeof(value));
+        lowCalls++;
+    });
+    IOEventHandler highHandler(highFd, Events::EVENT_READ, [&highCalls] { highCalls++; });
+    ASSERT_EQ(reactor->SetFdLimit(highFd), EVENT_SYS_ERR_OK);
+    EXPECT_EQ(reactor->AddHandler(&highHandler), EVENT_SYS_ERR_BADF);
+    ASSERT_EQ(reactor->SetFdLimit(highFd + 1), EVENT_SYS_ERR_OK);
+    ASSERT_EQ(reactor->AddHandler(&lowHandler), EVENT_SYS_ERR_OK);
+    ASSERT_EQ(reactor->AddHandler(&highHandler), EVENT_SYS_ERR_OK);
+    std::thread loopThread([&reactor] { reactor->Run(-1); });
+    uint64_t one = 1;
+    ASSERT_EQ(write(lowFd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    ASSERT_TRUE(WaitFor([&lowCalls, &highCalls] { return lowCalls >= 1 && highCalls >= 1; }));
+
+    // 2. Releasing a handler removes it, the others of the fd are still dispatched
+    EXPECT_EQ(reactor->RemoveHandler(&highHandler), EVENT_SYS_ERR_OK);
+    std::atomic<int> releasedCalls(0);
+    std::unique_ptr<IOEventHandler> released = std::make_unique<IOEventHandler>(lowFd, Events::EVENT_READ,
+        [&releasedCalls] { releasedCalls++; });
+    ASSERT_EQ(reactor->AddHandler(released.get()), EVENT_SYS_ERR_OK);
+    released.reset();
+    EXPECT_EQ(reactor->FindHandler(&lowHandler), EVENT_SYS_ERR_OK);
+    int calls = lowCalls;
+    ASSERT_EQ(write(lowFd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+    ASSERT_TRUE(WaitFor([&lowCalls, calls] { return lowCalls > calls; }));
+    EXPECT_EQ(releasedCalls, 0);
+
+    reactor->Terminate();
+    loopThread.join();
+    EXPECT_EQ(reactor->RemoveHandler(&lowHandler), EVENT_SYS_ERR_OK);
+    close(highFd);
+    close(lowFd);
+}
+
+/*
+ * @tc.name: testIOEventReactor009
+ * @tc.desc: test a handler added from another thread while a callback removes the last handler of the same fd.
+ * The change queued by the callback is not applied after the addition, the fd stays watched on both backends.
+ */
+HWTEST_F(UtilsEventTest, testIOEventReactor009, TestSize.Level0)
+{
+    uint64_t one = 1;
+    for (IOEventBackendType type : {IOEventBackendType::EPOLL, IOEventBackendType::IO_URING}) {
+        std::unique_ptr<IOEventReactor> reactor = std::make_unique<IOEventReactor>();
+        ASSERT_EQ(reactor->SetUp(type), EVENT_SYS_ERR_OK);
+        reactor->EnableHandling();
+        int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        ASSERT_NE(fd, -1);
+
+        // 1. The callback removes its own handler, then waits for the other one to be added
+        std::atomic<bool> removed(false);
+        std::atomic<bool> added(false);
+        std::atomic<int> calls(0);
+        IOEventHandler first(fd, Events::EVENT_READ, [&] {
+            uint64_t value = 0;
+            read(fd, &value, sizeof(value));
+            EXPECT_EQ(reactor->RemoveHandler(&first), EVENT_SYS_ERR_OK);
+            removed = true;
+            WaitFor([&added] { return added.load(); });
+        });
+        IOEventHandler second(fd, Events::EVENT_READ, [&calls, fd] {
+            uint64_t value = 0;
+            read(fd, &value, sizeof(value));
+            calls++;
+        });
+        ASSERT_EQ(reactor->AddHandler(&first), EVENT_SYS_ERR_OK);
+        std::thread loopThread([&reactor] { reactor->Run(-1); });
+        ASSERT_EQ(write(fd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+        ASSERT_TRUE(WaitFor([&removed] { return removed.load(); }));
+        EXPECT_EQ(reactor->AddHandler(&second), EVENT_SYS_ERR_OK);
+        added = true;
+
+        // 2. The added handler is dispatched
+        ASSERT_EQ(write(fd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+        EXPECT_TRUE(WaitFor([&calls] { return calls >= 1; }));
+
+        reactor->Terminate();
+        loopThread.join();
+        EXPECT_EQ(reactor->RemoveHandler(&second), EVENT_SYS_ERR_OK);
+        close(fd);
+    }
+}
+
 // Try to substitue underlying implementation of OHOS::UTILS::TIMER
 class TimerEventHandler {
 public:
@@ -22,6 +22,7 @@
 #include <fcntl.h>
 
 #include "file_ex.h"
+#include "mapped_file.h"
 
 using namespace testing::ext;
 using namespace std;
@@ -574,6 +575,51 @@ HWTEST_F(UtilsFileTest, testSaveBufferToFile003, TestSize.Level0)
     EXPECT_EQ(loadResult, content + std::string(newContent.begin(), newContent.end()));
 }
 
+/*
+ * @tc.name: testLoadRegionFromFile001
+ * @tc.desc: Test mapping a file, an empty file and a file not existing
+ */
+HWTEST_F(UtilsFileTest, testLoadRegionFromFile001, TestSize.Level0)
+{
+    sptr<Utils::MappedRegion> region;
+    string filename = FILE_PATH;
+    string content = CONTENT_STR;
+    CreateTestFile(filename, content);
+    EXPECT_TRUE(LoadRegionFromFile(filename, region));
+    ASSERT_NE(region, nullptr);
+    RemoveTestFile(filename);
+    EXPECT_EQ(string(region->Begin(), region->Size()), content);
+
+    CreateTestFile(filename, "");
+    EXPECT_TRUE(LoadRegionFromFile(filename, region));
+    EXPECT_EQ(region, nullptr);
+    RemoveTestFile(filename);
+
+    EXPECT_FALSE(LoadRegionFromFile(filename, region));
+}
+
+/*
+ * @tc.name: testLoadRegionFromFd001
+ * @tc.desc: Test mapping the file of a fd, from its start
+ */
+HWTEST_F(UtilsFileTest, testLoadRegionFromFd001, TestSize.Level0)
+{
+    sptr<Utils::MappedRegion> region;
+    EXPECT_FALSE(LoadRegionFromFd(-1, region));
+
+    string filename = FILE_PATH;
+    string content = CONTENT_STR;
+    CreateTestFile(filename, content);
+    int fd = open(filename.c_str(), O_RDONLY);
+    ASSERT_GT(fd, 0);
+    lseek(fd, 1, SEEK_SET);
+    RemoveTestFile(filename);
+    EXPECT_TRUE(LoadRegionFromFd(fd, region));
+    close(fd);
+    ASSERT_NE(region, nullptr);
+    EXPECT_EQ(string(region->Begin(), region->Size()), content);
+}
+
 /*
  * @tc.name: testStringExistsInFile001
  * @tc.desc: singleton template
@@ -695,6 +741,22 @@ HWTEST_F(UtilsFileTest, testStringExistsInFile007, TestSize.Level0)
     RemoveTestFile(filename);
 }
 
+/*
+ * @tc.name: testStringExistsInFile008
+ * @tc.desc: Test searching a file larger than the length loaded at most
+ */
+HWTEST_F(UtilsFileTest, testStringExistsInFile008, TestSize.Level1)
+{
+    string filename = FILE_PATH;
+    string content(MAX_FILE_LENGTH + 1, 't');
+    content.append("Tail");
+    CreateTestFile(filename, content);
+    EXPECT_TRUE(StringExistsInFile(filename, "Tail", true));
+    EXPECT_TRUE(StringExistsInFile(filename, "TAIL", false));
+    EXPECT_FALSE(StringExistsInFile(filename, "TAIL", true));
+    RemoveTestFile(filename);
+}
+
 /*
  * @tc.name: testFileExist001
  * @tc.desc: singleton template
@@ -786,5 +848,20 @@ HWTEST_F(UtilsFileTest, testCountStrInFile005, TestSize.Level0)
     EXPECT_EQ(CountStrInFile(filename, str1, false), 3);
     RemoveTestFile(filename);
 }
+
+/*
+ * @tc.name: testCountStrInFile006
+ * @tc.desc: Test counting in a file larger than the length loaded at most
+ */
+HWTEST_F(UtilsFileTest, testCountStrInFile006, TestSize.Level1)
+{
+    string filename = FILE_PATH;
+    string content(MAX_FILE_LENGTH + 1, 'a');
+    content.append("xYz-XyZ");
+    CreateTestFile(filename, content);
+    EXPECT_EQ(CountStrInFile(filename, "xyz", true), 0);
+    EXPECT_EQ(CountStrInFile(filename, "xyz", false), 2);
+    RemoveTestFile(filename);
+}
 }  // namespace
 }  // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "lock_profiler.h"
+
+using namespace testing::ext;
+using namespace std;
+
+namespace OHOS {
+namespace {
+
+class UtilsLockProfilerTest : public testing::Test {
+public:
+    void SetUp() override
+    {
+        Utils::LockProfiler::Reset();
+    }
+};
+
+bool FindInfo(const string& name, Utils::LockContentionInfo& found)
+{
+    for (const auto& info : Utils::LockProfiler::GetReport()) {
+        if (info.name == name) {
+            found = info;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * @tc.name: testProfiledMutex001
+ * @tc.desc: Uncontended lock operations are counted, and no wait is recorded.
+ */
+HWTEST_F(UtilsLockProfilerTest, testProfiledMutex001, TestSize.Level0)
+{
+    Utils::ProfiledMutex mutex("testProfiledMutex001");
+    const int loops = 10;
+    for (int i = 0; i < loops; ++i) {
+        lock_guard<Utils::ProfiledMutex> lock(mutex);
+    }
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+
+    Utils::LockContentionInfo info;
+    ASSERT_TRUE(FindInfo("testProfiledMutex001", info));
+    EXPECT_EQ(info.acquisitions, static_cast<uint64_t>(loops + 1));
+    EXPECT_EQ(info.contentions, 0u);
+    EXPECT_EQ(info.totalWaitNs, 0u);
+    EXPECT_EQ(info.waitHistogram.size(), Utils::LOCK_WAIT_HISTOGRAM_BUCKETS);
+    EXPECT_TRUE(info.holderSites.empty());
+}
+
+/*
+ * @tc.name: testProfiledMutex002
+ * @tc.desc: A contended lock records the wait time, a histogram entry and the call site of the holder.
+ * Locks with the same name share statistics, and the report is ranked by total wait time.
+ */
+HWTEST_F(UtilsLockProfilerTest, testProfiledMutex002, TestSize.Level0)
+{
+    Utils::ProfiledMutex hot("testProfiledMutex002.hot");
+    Utils::ProfiledMutex sameName("testProfiledMutex002.hot");
+    Utils::ProfiledMutex cold("testProfiledMutex002.cold");
+    lock_guard<Utils::ProfiledMutex> coldLock(cold);
+
+    hot.lock();
+    atomic_bool started(false);
+    thread waiter([&]() {
+        started = true;
+        lock_guard<Utils::ProfiledMutex> lock(hot);
+    });
+    while (!started) {}
+    this_thread::sleep_for(chrono::milliseconds(20)); // 20: keep holding the lock while the waiter blocks
+    hot.unlock();
+    waiter.join();
+    {
+        lock_guard<Utils::ProfiledMutex> lock(sameName);
+    }
+
+    Utils::LockContentionInfo info;
+    ASSERT_TRUE(FindInfo("testProfiledMutex002.hot", info));
+    EXPECT_EQ(info.acquisitions, 3u);
+    EXPECT_EQ(info.contentions, 1u);
+    EXPECT_GT(info.totalWaitNs, 0u);
+    EXPECT_EQ(info.maxWaitNs, info.totalWaitNs);
+    uint64_t histogramTotal = 0;
+    for (auto count : info.waitHistogram) {
+        histogramTotal += count;
+    }
+    EXPECT_EQ(histogramTotal, 1u);
+    ASSERT_EQ(info.holderSites.size(), 1u);
+    EXPECT_NE(info.holderSites[0].first, nullptr);
+    EXPECT_EQ(info.holderSites[0].second, 1u);
+
+    auto report = Utils::LockProfiler::GetReport();
+    ASSERT_FALSE(report.empty());
+    EXPECT_EQ(report.front().name, "testProfiledMutex002.hot");
+    EXPECT_NE(Utils::LockProfiler::DumpReport().find("testProfiledMutex002.hot"), string::npos);
+
+    Utils::LockProfiler::Reset();
+    ASSERT_TRUE(FindInfo("testProfiledMutex002.hot", info));
+    EXPECT_EQ(info.acquisitions, 0u);
+    EXPECT_EQ(info.contentions, 0u);
+    EXPECT_TRUE(info.holderSites.empty());
+}
+
+/*
+ * @tc.name: testProfiledMutex003
+ * @tc.desc: ProfiledMutex works with the inner condition variable type.
+ */
+HWTEST_F(UtilsLockProfilerTest, testProfiledMutex003, TestSize.Level0)
+{
+    Utils::ProfiledMutex mutex("testProfiledMutex003");
+    condition_variable_any cv;
+    bool ready = false;
+
+    thread notifier([&]() {
+        lock_guard<Utils::ProfiledMutex> lock(mutex);
+        ready = true;
+        cv.notify_one();
+    });
+    {
+        unique_lock<Utils::ProfiledMutex> lock(mutex);
+        cv.wait(lock, [&ready] { return ready; });
+    }
+    notifier.join();
+    EXPECT_TRUE(ready);
+}
+}  // namespace
+}  // namespace OHOS
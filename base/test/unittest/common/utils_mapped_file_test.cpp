@@ -14,15 +14,24 @@
  */
 #include "mapped_file.h"
 
+#include <csignal>
+#include <cstring>
 #include <fstream>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include "common_mapped_file_errors.h"
 #include "directory_ex.h"
 #include "errors.h"
 #include "file_ex.h"
+#include "mapped_file_flusher.h"
+#include "mapped_file_reader.h"
+#include "mapped_log.h"
 
 using namespace testing::ext;
 using namespace OHOS::Utils;
@@ -1253,7 +1262,7 @@ HWTEST_F(UtilsMappedFileTest, testAutoAdjustedMode001, TestSize.Level0)
     ReCreateFile(filename, content);
 
     // 2. map file
-    MapMode mode = static_cast<MapMode>(1) | static_cast<MapMode>(16) |
+    MapMode mode = static_cast<MapMode>(1) | static_cast<MapMode>(128) |
                    MapMode::PRIVATE | MapMode::READ_ONLY; // bits out of the scope will be ignored.
     MappedFile mf(filename, mode);
     ASSERT_EQ(mf.Map(), MAPPED_FILE_ERR_OK);
@@ -1530,5 +1539,783 @@ HWTEST_F(UtilsMappedFileTest, testMoveMappedFile004, TestSize.Level0)
     TestTwoFileWrite(mf, filename, filename1, content1);
 }
 
+/*
+ * @tc.name: testAdvise001
+ * @tc.desc: Test access hints given before and after mapping, on the whole region and on sub-ranges.
+ */
+HWTEST_F(UtilsMappedFileTest, testAdvise001, TestSize.Level0)
+{
+    // 1. create a new file of 4 pages
+    std::string filename = "test_advise_1.txt";
+    std::string content(MappedFile::PageSize() * 4LL, 'A'); // 4: pages of the file
+    ReCreateFile(filename, content);
+
+    // 2. hints kept by the object can be given before mapping, one-shot hints can not
+    MappedFile mf(filename);
+    EXPECT_EQ(mf.Advise(MapAdvice::SEQUENTIAL), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(mf.GetAdvice(), MapAdvice::SEQUENTIAL);
+    EXPECT_EQ(mf.Advise(MapAdvice::WILLNEED), ERR_INVALID_OPERATION);
+    EXPECT_EQ(mf.Advise(MapAdvice::DONTNEED, 0, 1), ERR_INVALID_OPERATION);
+
+    // 3. map file, the kept hint is applied and still reported
+    ASSERT_EQ(mf.Map(), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(mf.GetAdvice(), MapAdvice::SEQUENTIAL);
+
+    // 4. one-shot hints act on the mapping but are not kept
+    EXPECT_EQ(mf.Advise(MapAdvice::WILLNEED), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(mf.GetAdvice(), MapAdvice::SEQUENTIAL);
+    EXPECT_EQ(mf.Advise(MapAdvice::RANDOM), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(mf.GetAdvice(), MapAdvice::RANDOM);
+
+    // 5. sub-ranges not starting at a page boundary are extended to it
+    EXPECT_EQ(mf.Advise(MapAdvice::WILLNEED, MappedFile::PageSize() + 1, MappedFile::PageSize()), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(mf.Advise(MapAdvice::DONTNEED, MappedFile::PageSize() * 3LL, MappedFile::DEFAULT_LENGTH), // 3: last page
+              MAPPED_FILE_ERR_OK);
+
+    // 6. invalid ranges are refused
+    EXPECT_EQ(mf.Advise(MapAdvice::WILLNEED, -1, 1), ERR_INVALID_VALUE);
+    EXPECT_EQ(mf.Advise(MapAdvice::WILLNEED, mf.Size(), 1), ERR_INVALID_VALUE);
+    EXPECT_EQ(mf.Advise(MapAdvice::WILLNEED, 0, 0), ERR_INVALID_VALUE);
+
+    // 7. contents dropped by DONTNEED are read again from the file
+    std::string readout(mf.Begin(), mf.Size());
+    EXPECT_EQ(readout, content);
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testPrefetch001
+ * @tc.desc: Test TurnNext() prefetching the next window.
+ */
+HWTEST_F(UtilsMappedFileTest, testPrefetch001, TestSize.Level0)
+{
+    // 1. create a new file of 8 pages, each page filled with its index
+    std::string filename = "test_prefetch_1.txt";
+    std::string content;
+    for (char page = '0'; page < '8'; page++) {
+        content.append(MappedFile::PageSize(), page);
+    }
+    ReCreateFile(filename, content);
+
+    // 2. prefetch can not be issued before normalized
+    MappedFile mf(filename, MapMode::READ_ONLY, 0, MappedFile::PageSize() * 2LL); // 2: pages of a window
+    EXPECT_EQ(mf.PrefetchNext(), ERR_INVALID_OPERATION);
+
+    // 3. map file with prefetch enabled
+    mf.SetPrefetch(true);
+    EXPECT_TRUE(mf.IsPrefetchEnabled());
+    ASSERT_EQ(mf.Advise(MapAdvice::SEQUENTIAL), MAPPED_FILE_ERR_OK);
+    ASSERT_EQ(mf.Map(), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(mf.PrefetchNext(), MAPPED_FILE_ERR_OK);
+
+    // 4. turn through the file and check the contents of each window
+    off_t windows = 1;
+    EXPECT_EQ(*mf.Begin(), '0');
+    while (mf.TurnNext() == MAPPED_FILE_ERR_OK) {
+        EXPECT_EQ(*mf.Begin(), '0' + windows * 2); // 2: pages of a window
+        EXPECT_EQ(*mf.End(), '0' + windows * 2 + 1);
+        EXPECT_EQ(mf.GetAdvice(), MapAdvice::SEQUENTIAL);
+        windows++;
+    }
+    EXPECT_EQ(windows, 4); // 4: windows of the file
+
+    // 5. prefetch beyond the end of file does no harm
+    EXPECT_EQ(mf.PrefetchNext(), MAPPED_FILE_ERR_OK);
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testReader001
+ * @tc.desc: Test reading lines across windows with MappedFileReader.
+ */
+HWTEST_F(UtilsMappedFileTest, testReader001, TestSize.Level0)
+{
+    // 1. create a file of lines with growing lengths, which spans many windows of one page
+    std::string filename = "test_reader_1.txt";
+    std::vector<std::string> lines;
+    std::string content;
+    for (int i = 0; content.size() < static_cast<size_t>(MappedFile::PageSize() * 8LL); i++) { // 8: pages
+        lines.push_back(std::string(i % 300, 'a' + i % 26)); // 300: longest line, 26: letters
+        content.append(lines.back()).append("\n");
+    }
+    lines.push_back("last line without newline");
+    content.append(lines.back());
+    ReCreateFile(filename, content);
+
+    // 2. open reader with windows and overlap of one page
+    MappedFileReader reader(filename, RecordFormat::LINE, 1, 1);
+    MappedRecord record;
+    EXPECT_EQ(reader.Next(record), ERR_INVALID_OPERATION);
+    ASSERT_EQ(reader.Open(), MAPPED_FILE_ERR_OK);
+    EXPECT_TRUE(reader.IsOpen());
+    EXPECT_EQ(reader.GetWindowSize(), MappedFile::PageSize());
+    EXPECT_EQ(reader.GetOverlap(), MappedFile::PageSize());
+    EXPECT_EQ(reader.FileSize(), static_cast<off_t>(content.size()));
+    EXPECT_EQ(reader.Open(), ERR_INVALID_OPERATION);
+
+    // 3. iterate all lines, including those crossing window boundaries
+    size_t index = 0;
+    for (const MappedRecord& line : reader) {
+        ASSERT_LT(index, lines.size());
+        EXPECT_EQ(std::string(line.data, line.size), lines[index]);
+        index++;
+    }
+    EXPECT_EQ(index, lines.size());
+    EXPECT_EQ(reader.LastError(), ERR_ENOUGH_DATA);
+    EXPECT_EQ(reader.Position(), reader.FileSize());
+
+    // 4. reading after close fails, reopening starts from the beginning
+    reader.Close();
+    EXPECT_FALSE(reader.IsOpen());
+    ASSERT_EQ(reader.Open(), MAPPED_FILE_ERR_OK);
+    ASSERT_EQ(reader.Next(record), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(std::string(record.data, record.size), lines[0]);
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testReader002
+ * @tc.desc: Test reading length-prefixed records and their failures with MappedFileReader.
+ */
+HWTEST_F(UtilsMappedFileTest, testReader002, TestSize.Level0)
+{
+    // 1. create a file of length-prefixed records, the last one longer than the overlap and truncated
+    std::string filename = "test_reader_2.txt";
+    std::string content;
+    const uint32_t recordNum = 100;
+    for (uint32_t i = 0; i < recordNum; i++) {
+        std::string payload(i * 7 % 200, 'A' + i % 26); // 7, 200: spread the lengths, 26: letters
+        uint32_t len = payload.size();
+        content.append(reinterpret_cast<const char*>(&len), sizeof(len)).append(payload);
+    }
+    off_t longStart = content.size();
+    uint32_t longLen = MappedFile::PageSize() * 2LL; // 2: twice the overlap
+    content.append(reinterpret_cast<const char*>(&longLen), sizeof(longLen)).append(longLen, 'L');
+    off_t truncatedStart = content.size();
+    uint32_t truncatedLen = 10; // 10: longer than what remains
+    content.append(reinterpret_cast<const char*>(&truncatedLen), sizeof(truncatedLen)).append("short");
+    ReCreateFile(filename, "");
+    ASSERT_TRUE(SaveStringToFile(filename, content, 0, true)); // content has NUL bytes, write it as a whole
+
+    // 2. read all regular records
+    MappedFileReader reader(filename, RecordFormat::LENGTH_PREFIXED, MappedFile::PageSize(), MappedFile::PageSize());
+    ASSERT_EQ(reader.Open(), MAPPED_FILE_ERR_OK);
+    MappedRecord record;
+    for (uint32_t i = 0; i < recordNum; i++) {
+        ASSERT_EQ(reader.Next(record), MAPPED_FILE_ERR_OK);
+        EXPECT_EQ(std::string(record.data, record.size), std::string(i * 7 % 200, 'A' + i % 26));
+    }
+
+    // 3. a record longer than the overlap fails and keeps the cursor
+    EXPECT_EQ(reader.Next(record), ERR_OVERFLOW);
+    EXPECT_EQ(reader.Position(), longStart);
+
+    // 4. skip it with raw reads, which are limited by the overlap as well
+    MappedRecord raw;
+    EXPECT_EQ(reader.Read(sizeof(uint32_t) + longLen, raw), ERR_OVERFLOW);
+    ASSERT_EQ(reader.Read(sizeof(uint32_t) + longLen / 2, raw), MAPPED_FILE_ERR_OK); // 2: read it in two halves
+    ASSERT_EQ(reader.Read(longLen / 2, raw), MAPPED_FILE_ERR_OK); // 2: read it in two halves
+    EXPECT_EQ(std::string(raw.data, raw.size), std::string(longLen / 2, 'L')); // 2: the second half
+    EXPECT_EQ(reader.Position(), truncatedStart);
+
+    // 5. the truncated record is refused, then the end is reached
+    EXPECT_EQ(reader.Next(record), ERR_INVALID_VALUE);
+    ASSERT_EQ(reader.Read(content.size() - truncatedStart, raw), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(reader.Next(record), ERR_ENOUGH_DATA);
+    EXPECT_EQ(reader.Read(1, raw), ERR_ENOUGH_DATA);
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testReader003
+ * @tc.desc: Test MappedFileReader with an empty file and a missing file.
+ */
+HWTEST_F(UtilsMappedFileTest, testReader003, TestSize.Level0)
+{
+    // 1. an empty file is opened and ends at once
+    std::string filename = "test_reader_3.txt";
+    ReCreateFile(filename, "");
+    MappedFileReader reader(filename);
+    ASSERT_EQ(reader.Open(), MAPPED_FILE_ERR_OK);
+    EXPECT_TRUE(reader.begin() == reader.end());
+    EXPECT_EQ(reader.LastError(), ERR_ENOUGH_DATA);
+    RemoveTestFile(filename);
+
+    // 2. a missing file can not be opened
+    MappedFileReader missing(filename);
+    EXPECT_EQ(missing.Open(), MAPPED_FILE_ERR_FAILED);
+    EXPECT_FALSE(missing.IsOpen());
+
+    // 3. invalid window sizes are refused
+    MappedFileReader invalid(filename, RecordFormat::LINE, 0);
+    EXPECT_EQ(invalid.Open(), ERR_INVALID_VALUE);
+}
+
+/*
+ * @tc.name: testMapOptions001
+ * @tc.desc: Test mapping with populate, huge page and locked options and the granted mode.
+ */
+HWTEST_F(UtilsMappedFileTest, testMapOptions001, TestSize.Level0)
+{
+    // 1. create a new file of 4 pages
+    std::string filename = "test_map_options_1.txt";
+    std::string content(MappedFile::PageSize() * 4LL, 'O'); // 4: pages of the file
+    ReCreateFile(filename, content);
+
+    // 2. map file with all options
+    MapMode options = MapMode::POPULATE | MapMode::HUGE_PAGE | MapMode::LOCKED;
+    MappedFile mf(filename, MapMode::READ_ONLY | options);
+    ASSERT_EQ(mf.Map(), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(mf.GetMode(), MapMode::READ_ONLY | options);
+
+    // 3. options not granted do not fail the mapping, and only asked ones can be granted
+    MapMode granted = mf.GetGrantedMode();
+    EXPECT_EQ(granted & ~options, MapMode::READ_ONLY);
+    EXPECT_EQ(granted & MapMode::POPULATE, MapMode::POPULATE);
+    // 4 pages can not be mapped by a huge page, even though the kernel takes the advice
+    EXPECT_EQ(granted & MapMode::HUGE_PAGE, MapMode::DEFAULT);
+    std::string readout(mf.Begin(), mf.Size());
+    EXPECT_EQ(readout, content);
+
+    // 4. the granted mode is cleared by unmapping
+    ASSERT_EQ(mf.Unmap(), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(mf.GetGrantedMode(), MapMode::DEFAULT);
+
+    // 5. mapping without options grants none
+    ASSERT_TRUE(mf.ChangeMode(MapMode::READ_ONLY));
+    ASSERT_EQ(mf.Map(), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(mf.GetGrantedMode(), MapMode::READ_ONLY);
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testFlush001
+ * @tc.desc: Test writing back ranges of a mapped file synchronously and asynchronously.
+ */
+HWTEST_F(UtilsMappedFileTest, testFlush001, TestSize.Level0)
+{
+    // 1. create a new file of 4 pages
+    std::string filename = "test_flush_1.txt";
+    std::string content(MappedFile::PageSize() * 4LL, 'F'); // 4: pages of the file
+    ReCreateFile(filename, content);
+
+    // 2. flushing fails before mapping
+    MappedFile mf(filename);
+    EXPECT_EQ(mf.Flush(), ERR_INVALID_OPERATION);
+    ASSERT_EQ(mf.Map(), MAPPED_FILE_ERR_OK);
+
+    // 3. write and flush a range not starting at a page boundary
+    off_t offset = MappedFile::PageSize() + 10; // 10: inside the second page
+    mf.Begin()[offset] = 'W';
+    EXPECT_EQ(mf.Flush(offset, 1), MAPPED_FILE_ERR_OK);
+
+    // 4. write and schedule write-back of the whole view
+    mf.Begin()[0] = 'A';
+    EXPECT_EQ(mf.Flush(0, MappedFile::DEFAULT_LENGTH, true), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(mf.Flush(), MAPPED_FILE_ERR_OK);
+
+    std::string res;
+    LoadStringFromFile(filename, res);
+    content[offset] = 'W';
+    content[0] = 'A';
+    EXPECT_EQ(res, content);
+
+    // 5. invalid ranges are refused
+    EXPECT_EQ(mf.Flush(-1, 1), ERR_INVALID_VALUE);
+    EXPECT_EQ(mf.Flush(mf.Size(), 1), ERR_INVALID_VALUE);
+    EXPECT_EQ(mf.Flush(0, 0), ERR_INVALID_VALUE);
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testFlusher001
+ * @tc.desc: Test MappedFileFlusher coalescing dirty ranges.
+ */
+HWTEST_F(UtilsMappedFileTest, testFlusher001, TestSize.Level0)
+{
+    // 1. create and map a new file of 16 pages
+    std::string filename = "test_flusher_1.txt";
+    off_t page = MappedFile::PageSize();
+    std::string content(page * 16LL, '.'); // 16: pages of the file
+    ReCreateFile(filename, content);
+    MappedFile mf(filename);
+    ASSERT_EQ(mf.Map(), MAPPED_FILE_ERR_OK);
+
+    // 2. writes within one page, to adjacent pages and overlapping ranges are merged
+    MappedFileFlusher flusher(mf);
+    std::vector<off_t> writes = {
+        10, 20, page + 1, page * 2 + 5, // pages 0 to 2 as one run
+        page * 5 + 100,                 // page 5 alone
+        page * 8 - 1, page * 8,         // pages 7 and 8, then widened below
+        page * 9 + 1,
+    };
+    for (off_t offset : writes) {
+        mf.Begin()[offset] = 'D';
+        content[offset] = 'D';
+        flusher.MarkDirty(offset, 1);
+    }
+    flusher.MarkDirty(page * 7, page * 3); // 7, 3: pages 7 to 9 together
+    flusher.MarkDirty(-1, 1);
+    flusher.MarkDirty(0, 0);
+    EXPECT_EQ(flusher.GetRangeNum(), 3u); // 3: runs of dirty pages
+    EXPECT_EQ(flusher.GetDirtySize(), page * 7LL); // 7: dirty pages
+
+    // 3. one msync() per run
+    EXPECT_EQ(flusher.Flush(), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(flusher.GetSyncCalls(), 3u); // 3: runs of dirty pages
+    EXPECT_EQ(flusher.GetRangeNum(), 0u);
+    EXPECT_EQ(flusher.GetDirtySize(), 0);
+
+    std::string res;
+    LoadStringFromFile(filename, res);
+    EXPECT_EQ(res, content);
+
+    // 4. nothing pending, nothing synced
+    EXPECT_EQ(flusher.Flush(), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(flusher.GetSyncCalls(), 3u); // 3: calls of the last flush
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testFlusher002
+ * @tc.desc: Test MappedFileFlusher writing back in its thread.
+ */
+HWTEST_F(UtilsMappedFileTest, testFlusher002, TestSize.Level0)
+{
+    // 1. create and map a new file of 16 pages
+    std::string filename = "test_flusher_2.txt";
+    off_t page = MappedFile::PageSize();
+    std::string content(page * 16LL, '.'); // 16: pages of the file
+    ReCreateFile(filename, content);
+    MappedFile mf(filename);
+    ASSERT_EQ(mf.Map(), MAPPED_FILE_ERR_OK);
+
+    // 2. invalid params are refused, and it can only be started once
+    MappedFileFlusher flusher(mf);
+    EXPECT_EQ(flusher.Start(0), ERR_INVALID_VALUE);
+    EXPECT_EQ(flusher.Start(60000, page * 4LL), MAPPED_FILE_ERR_OK); // 60000: never reached, 4: limit in pages
+    EXPECT_EQ(flusher.Start(), ERR_INVALID_OPERATION);
+
+    // 3. reaching the dirty limit wakes the thread before the interval
+    for (off_t index = 0; index < 4; index++) { // 4: pages to reach the limit
+        mf.Begin()[index * page * 2] = 'T'; // 2: one page out of two, no run merged
+        flusher.MarkDirty(index * page * 2, 1);
+    }
+    for (int i = 0; i < 1000 && flusher.GetSyncCalls() < 4u; i++) { // 1000: wait up to 1s, 4: runs
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(flusher.GetSyncCalls(), 4u); // 4: runs
+    EXPECT_EQ(flusher.GetDirtySize(), 0);
+
+    // 4. stopping leaves the pending ranges for the next flush
+    flusher.Stop();
+    flusher.MarkDirty(page, 1);
+    EXPECT_EQ(flusher.GetRangeNum(), 1u);
+    EXPECT_EQ(flusher.Flush(true), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(flusher.GetSyncCalls(), 5u); // 5: one more run
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testFlusher003
+ * @tc.desc: Test MappedFileFlusher waiting for the ranges another flush is writing back.
+ */
+HWTEST_F(UtilsMappedFileTest, testFlusher003, TestSize.Level0)
+{
+    // 1. create and map a new file of 512 pages
+    std::string filename = "test_flusher_3.txt";
+    off_t page = MappedFile::PageSize();
+    const off_t pages = 512; // 512: pages of the file
+    std::string content(page * pages, '.');
+    ReCreateFile(filename, content);
+    MappedFile mf(filename);
+    ASSERT_EQ(mf.Map(), MAPPED_FILE_ERR_OK);
+
+    // 2. dirty one page out of two, no run merged
+    MappedFileFlusher flusher(mf);
+    const uint64_t runs = pages / 2; // 2: one page out of two
+    for (off_t index = 0; index < pages; index += 2) { // 2: one page out of two
+        mf.Begin()[index * page] = 'F';
+        flusher.MarkDirty(index * page, 1);
+    }
+    EXPECT_EQ(flusher.GetRangeNum(), runs);
+
+    // 3. a flush called while another is writing back returns after all runs are written
+    std::thread flushing([&flusher] { EXPECT_EQ(flusher.Flush(), MAPPED_FILE_ERR_OK); });
+    while (flusher.GetSyncCalls() == 0u) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(flusher.Flush(), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(flusher.GetSyncCalls(), runs);
+    flushing.join();
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testMappedLog001
+ * @tc.desc: Test appending to and replaying a MappedLog, and recovering its end when opened again.
+ */
+HWTEST_F(UtilsMappedFileTest, testMappedLog001, TestSize.Level0)
+{
+    // 1. open a log on an empty file
+    std::string filename = "test_log_1.log";
+    ReCreateFile(filename, "");
+    off_t page = MappedFile::PageSize();
+    std::vector<std::string> records = {"first", "", "third record", std::string(page * 2LL, 'L')}; // 2: spans extents
+    {
+        MappedLog log(filename, page * 16LL, page); // 16: pages of capacity
+        ASSERT_EQ(log.Open(), MAPPED_FILE_ERR_OK);
+        EXPECT_EQ(log.Open(), ERR_INVALID_OPERATION);
+        EXPECT_EQ(log.Tail(), 0);
+        EXPECT_EQ(log.MappedSize(), 0);
+        char* base = log.Base();
+
+        // 2. append records, growing the mapping without moving it
+        for (const std::string& record : records) {
+            EXPECT_EQ(log.Append(record.data(), record.size()), MAPPED_FILE_ERR_OK);
+        }
+        EXPECT_EQ(log.Base(), base);
+        EXPECT_GE(log.MappedSize(), log.Tail());
+        EXPECT_EQ(log.MappedSize() % page, 0);
+
+        // 3. records are replayed in place and in order
+        size_t index = 0;
+        EXPECT_EQ(log.Replay([&](const char* data, uint32_t size, off_t) {
+            EXPECT_GE(data, base);
+            EXPECT_EQ(std::string(data, size), records[index++]);
+            return true;
+        }), MAPPED_FILE_ERR_OK);
+        EXPECT_EQ(index, records.size());
+        EXPECT_EQ(log.Flush(), MAPPED_FILE_ERR_OK);
+    }
+
+    // 4. opened again, appending restarts after the last record
+    MappedLog log(filename, page * 16LL, page); // 16: pages of capacity
+    ASSERT_EQ(log.Open(), MAPPED_FILE_ERR_OK);
+    off_t tail = log.Tail();
+    EXPECT_GT(tail, 0);
+    std::string last = "appended after reopening";
+    EXPECT_EQ(log.Append(last.data(), last.size()), MAPPED_FILE_ERR_OK);
+
+    // 5. replay from the offset of a record
+    std::vector<std::string> replayed;
+    EXPECT_EQ(log.Replay([&replayed](const char* data, uint32_t size, off_t) {
+        replayed.emplace_back(data, size);
+        return true;
+    }, tail), MAPPED_FILE_ERR_OK);
+    ASSERT_EQ(replayed.size(), 1u);
+    EXPECT_EQ(replayed[0], last);
+    EXPECT_EQ(log.Replay([](const char*, uint32_t, off_t) { return true; }, 1), ERR_INVALID_VALUE);
+
+    log.Close();
+    EXPECT_FALSE(log.IsOpen());
+    EXPECT_EQ(log.Append(last.data(), last.size()), ERR_INVALID_OPERATION);
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testMappedLog002
+ * @tc.desc: Test appending to a MappedLog from several threads.
+ */
+HWTEST_F(UtilsMappedFileTest, testMappedLog002, TestSize.Level0)
+{
+    // 1. open a log growing one page at a time
+    std::string filename = "test_log_2.log";
+    ReCreateFile(filename, "");
+    off_t page = MappedFile::PageSize();
+    MappedLog log(filename, page * 64LL, page); // 64: pages of capacity
+    ASSERT_EQ(log.Open(), MAPPED_FILE_ERR_OK);
+    char* base = log.Base();
+
+    // 2. append concurrently, each record holding its thread and sequence
+    constexpr uint32_t threadNum = 4;
+    constexpr uint32_t recordNum = 1000;
+    std::vector<std::thread> threads;
+    for (uint32_t id = 0; id < threadNum; id++) {
+        threads.emplace_back([&log, id]() {
+            for (uint32_t seq = 0; seq < recordNum; seq++) {
+                uint32_t record[2] = {id, seq}; // 2: thread and sequence
+                EXPECT_EQ(log.Append(record, sizeof(record)), MAPPED_FILE_ERR_OK);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(log.Base(), base);
+
+    // 3. all records are committed, each thread's in order
+    std::vector<uint32_t> next(threadNum, 0);
+    uint32_t count = 0;
+    log.Replay([&](const char* data, uint32_t size, off_t) {
+        uint32_t record[2] = {0}; // 2: thread and sequence
+        EXPECT_EQ(size, sizeof(record));
+        memcpy(record, data, sizeof(record));
+        EXPECT_LT(record[0], threadNum);
+        EXPECT_EQ(record[1], next[record[0]]++);
+        count++;
+        return true;
+    });
+    EXPECT_EQ(count, threadNum * recordNum);
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testMappedLog003
+ * @tc.desc: Test reserving room in a MappedLog, up to its capacity.
+ */
+HWTEST_F(UtilsMappedFileTest, testMappedLog003, TestSize.Level0)
+{
+    // 1. open a log of one page
+    std::string filename = "test_log_3.log";
+    ReCreateFile(filename, "");
+    off_t page = MappedFile::PageSize();
+    MappedLog log(filename, page, page);
+    ASSERT_EQ(log.Open(), MAPPED_FILE_ERR_OK);
+
+    // 2. replay stops at a record reserved but not committed
+    MappedLogRecord first;
+    MappedLogRecord second;
+    ASSERT_EQ(log.Reserve(4, first), MAPPED_FILE_ERR_OK); // 4: size of record
+    ASSERT_EQ(log.Reserve(4, second), MAPPED_FILE_ERR_OK); // 4: size of record
+    EXPECT_EQ(first.offset, 0);
+    EXPECT_GT(second.offset, first.offset);
+    memcpy(second.data, "2nd.", second.size);
+    log.Commit(second);
+    uint32_t count = 0;
+    auto counter = [&count](const char*, uint32_t, off_t) {
+        count++;
+        return true;
+    };
+    log.Replay(counter);
+    EXPECT_EQ(count, 0u);
+
+    // 3. all committed records are replayed once the gap is committed
+    memcpy(first.data, "1st.", first.size);
+    log.Commit(first);
+    log.Replay(counter);
+    EXPECT_EQ(count, 2u); // 2: records committed
+
+    // 4. the capacity is never exceeded
+    std::string large(page, 'X');
+    EXPECT_EQ(log.Append(large.data(), large.size()), ERR_OVERFLOW);
+    EXPECT_EQ(log.Capacity(), page);
+    EXPECT_EQ(log.MappedSize(), page);
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testMappedLog004
+ * @tc.desc: Test records after the first one not committed being dropped when a MappedLog is opened again.
+ */
+HWTEST_F(UtilsMappedFileTest, testMappedLog004, TestSize.Level0)
+{
+    // 1. commit the first and third records, the second one is reserved only
+    std::string filename = "test_log_4.log";
+    ReCreateFile(filename, "");
+    off_t page = MappedFile::PageSize();
+    {
+        MappedLog log(filename, page * 4LL, page); // 4: pages of capacity
+        ASSERT_EQ(log.Open(), MAPPED_FILE_ERR_OK);
+        MappedLogRecord hidden;
+        EXPECT_EQ(log.Append("1st.", 4), MAPPED_FILE_ERR_OK); // 4: size of record
+        ASSERT_EQ(log.Reserve(4, hidden), MAPPED_FILE_ERR_OK); // 4: size of record
+        EXPECT_EQ(log.Append("3rd.", 4), MAPPED_FILE_ERR_OK); // 4: size of record
+        EXPECT_EQ(log.Flush(), MAPPED_FILE_ERR_OK);
+    }
+
+    // 2. opened again, appending restarts at the hidden record with a record of another size
+    std::string record = "8 bytes.";
+    off_t tail = 0;
+    {
+        MappedLog log(filename, page * 4LL, page); // 4: pages of capacity
+        ASSERT_EQ(log.Open(), MAPPED_FILE_ERR_OK);
+        EXPECT_GT(log.Tail(), 0);
+        EXPECT_EQ(log.Append(record.data(), record.size()), MAPPED_FILE_ERR_OK);
+        tail = log.Tail();
+    }
+
+    // 3. opened once more, the third record, starting where the appended one ends, is not recovered
+    MappedLog log(filename, page * 4LL, page); // 4: pages of capacity
+    ASSERT_EQ(log.Open(), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(log.Tail(), tail);
+    std::vector<std::string> replayed;
+    EXPECT_EQ(log.Replay([&replayed](const char* data, uint32_t size, off_t) {
+        replayed.emplace_back(data, size);
+        return true;
+    }), MAPPED_FILE_ERR_OK);
+    ASSERT_EQ(replayed.size(), 2u); // 2: first record and the one appended
+    EXPECT_EQ(replayed[0], "1st.");
+    EXPECT_EQ(replayed[1], record);
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testMappedLog005
+ * @tc.desc: Test a MappedLog failing to grow, the records appended afterwards are replayed once opened again.
+ */
+HWTEST_F(UtilsMappedFileTest, testMappedLog005, TestSize.Level0)
+{
+    // 1. fill the first extent up to its last 8 bytes
+    std::string filename = "test_log_5.log";
+    ReCreateFile(filename, "");
+    off_t page = MappedFile::PageSize();
+    std::string first(page - 16, 'F'); // 16: header and room left in the extent
+    std::string second(64, 'S'); // 64: does not fit in the extent left
+    std::string third = "third";
+    {
+        MappedLog log(filename, page * 4LL, page); // 4: pages of capacity
+        ASSERT_EQ(log.Open(), MAPPED_FILE_ERR_OK);
+        ASSERT_EQ(log.Append(first.data(), first.size()), MAPPED_FILE_ERR_OK);
+        off_t tail = log.Tail();
+
+        // 2. the file cannot grow past its size, the reservation fails and leaves no gap
+        struct rlimit limit;
+        ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &limit), 0);
+        struct rlimit lowered = limit;
+        lowered.rlim_cur = static_cast<rlim_t>(page);
+        auto handler = signal(SIGXFSZ, SIG_IGN);
+        ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &lowered), 0);
+        EXPECT_EQ(log.Append(second.data(), second.size()), MAPPED_FILE_ERR_FAILED);
+        ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+        signal(SIGXFSZ, handler);
+        EXPECT_EQ(log.Tail(), tail);
+        EXPECT_EQ(log.MappedSize(), page);
+
+        // 3. so is a reservation exceeding the capacity
+        std::string large(page * 4LL, 'L'); // 4: pages of capacity
+        EXPECT_EQ(log.Append(large.data(), large.size()), ERR_OVERFLOW);
+        EXPECT_EQ(log.Tail(), tail);
+        EXPECT_EQ(log.Append(third.data(), third.size()), MAPPED_FILE_ERR_OK);
+    }
+
+    // 4. opened again, the record appended after the failures is replayed
+    MappedLog log(filename, page * 4LL, page); // 4: pages of capacity
+    ASSERT_EQ(log.Open(), MAPPED_FILE_ERR_OK);
+    std::vector<std::string> replayed;
+    EXPECT_EQ(log.Replay([&replayed](const char* data, uint32_t size, off_t) {
+        replayed.emplace_back(data, size);
+        return true;
+    }), MAPPED_FILE_ERR_OK);
+    ASSERT_EQ(replayed.size(), 2u); // 2: first and third records
+    EXPECT_EQ(replayed[0], first);
+    EXPECT_EQ(replayed[1], third);
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testShare001
+ * @tc.desc: Test a shared region staying mapped while the MappedFile unmaps and remaps.
+ */
+HWTEST_F(UtilsMappedFileTest, testShare001, TestSize.Level0)
+{
+    // 1. create and map a new file of 4 pages
+    std::string filename = "test_share_1.txt";
+    off_t page = MappedFile::PageSize();
+    std::string content(page * 4LL, 'A'); // 4: pages of the file
+    content.replace(page * 2LL, page * 2LL, std::string(page * 2LL, 'B')); // 2: last pages differ
+    ReCreateFile(filename, content);
+    MappedFile mf(filename, MapMode::READ_ONLY, 0, page * 2LL); // 2: pages mapped
+    EXPECT_EQ(mf.Share(), nullptr);
+    ASSERT_EQ(mf.Map(), MAPPED_FILE_ERR_OK);
+
+    // 2. sharing twice yields the same handle
+    sptr<MappedRegion> region = mf.Share();
+    ASSERT_NE(region, nullptr);
+    EXPECT_TRUE(mf.IsShared());
+    EXPECT_EQ(mf.Share(), region);
+    EXPECT_EQ(region->Begin(), mf.Begin());
+    EXPECT_EQ(region->Size(), page * 2LL); // 2: pages mapped
+
+    // 3. the handle keeps its view after the file turns to the next window
+    ASSERT_EQ(mf.TurnNext(), MAPPED_FILE_ERR_OK);
+    EXPECT_FALSE(mf.IsShared());
+    EXPECT_EQ(*mf.Begin(), 'B');
+    EXPECT_EQ(region->StartOffset(), 0);
+    EXPECT_EQ(std::string(region->Begin(), region->Size()), content.substr(0, page * 2LL)); // 2: pages mapped
+
+    // 4. resizing a shared mapping maps apart
+    sptr<MappedRegion> next = mf.Share();
+    ASSERT_NE(next, nullptr);
+    EXPECT_EQ(mf.Resize(page), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(mf.Size(), page);
+    EXPECT_EQ(next->Size(), page * 2LL); // 2: pages mapped before resizing
+    EXPECT_EQ(std::string(next->Begin(), next->Size()), content.substr(page * 2LL)); // 2: pages of the window
+
+    // 5. the handles are the last to hold their mappings
+    EXPECT_EQ(mf.Unmap(), MAPPED_FILE_ERR_OK);
+    EXPECT_EQ(region->GetSptrRefCount(), 1);
+    EXPECT_EQ(next->GetSptrRefCount(), 1);
+    EXPECT_EQ(*region->End(), 'A');
+
+    RemoveTestFile(filename);
+}
+
+/*
+ * @tc.name: testShare002
+ * @tc.desc: Test readers on other threads holding shared regions while the MappedFile turns windows.
+ */
+HWTEST_F(UtilsMappedFileTest, testShare002, TestSize.Level0)
+{
+    // 1. create and map a new file of 64 pages, each filled with its index
+    std::string filename = "test_share_2.txt";
+    off_t page = MappedFile::PageSize();
+    constexpr int pageNum = 64;
+    std::string content;
+    for (int index = 0; index < pageNum; index++) {
+        content.append(page, static_cast<char>('0' + index));
+    }
+    ReCreateFile(filename, content);
+    MappedFile mf(filename, MapMode::READ_ONLY, 0, page);
+    ASSERT_EQ(mf.Map(), MAPPED_FILE_ERR_OK);
+
+    // 2. readers check the latest region published, while it is replaced
+    std::mutex mutex;
+    sptr<MappedRegion> published = mf.Share();
+    std::atomic<bool> done(false);
+    std::vector<std::thread> readers;
+    for (int id = 0; id < 4; id++) { // 4: readers
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                sptr<MappedRegion> region;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    region = published;
+                }
+                char expected = static_cast<char>('0' + region->StartOffset() / page);
+                EXPECT_EQ(std::string(region->Begin(), region->Size()), std::string(page, expected));
+            }
+        });
+    }
+
+    // 3. the owner turns to each page and publishes it
+    for (int index = 1; index < pageNum; index++) {
+        ASSERT_EQ(mf.TurnNext(), MAPPED_FILE_ERR_OK);
+        sptr<MappedRegion> region = mf.Share();
+        std::lock_guard<std::mutex> lock(mutex);
+        published = region;
+    }
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(published->StartOffset(), page * (pageNum - 1));
+
+    RemoveTestFile(filename);
+}
+
 }  // namespace
 }  // namespace OHOS
\ No newline at end of file
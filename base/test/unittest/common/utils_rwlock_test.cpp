@@ -13,8 +13,10 @@
  * limitations under the License.
  */
 #include <gtest/gtest.h>
+#include <atomic>
 #include <thread>
 #include <string>
+#include <vector>
 
 #include "rwlock.h"
 
@@ -117,5 +119,217 @@ HWTEST_F(UtilsRWLockTest, testRWLock002, TestSize.Level1)
 
     EXPECT_EQ(readOut1, readOut2);
 }
+
+/*
+ * @tc.name: testBigReaderLock001
+ * @tc.desc: BigReaderLock works with UniqueReadGuard and UniqueWriteGuard, and a thread holding the write lock
+ * can also take the read lock.
+ */
+HWTEST_F(UtilsRWLockTest, testBigReaderLock001, TestSize.Level1)
+{
+    Utils::BigReaderLock lock(4); // 4: number of reader slots
+    EXPECT_EQ(lock.GetSlotCount(), 4u);
+
+    int value = 0;
+    {
+        Utils::UniqueWriteGuard<Utils::BigReaderLock> writeGuard(lock);
+        value = 1;
+        Utils::UniqueReadGuard<Utils::BigReaderLock> readGuard(lock);
+        EXPECT_EQ(value, 1);
+    }
+    {
+        Utils::UniqueReadGuard<Utils::BigReaderLock> readGuard(lock);
+        Utils::UniqueReadGuard<Utils::BigReaderLock> nestedGuard(lock);
+        EXPECT_EQ(value, 1);
+    }
+
+    Utils::BigReaderLock defaultLock;
+    EXPECT_GE(defaultLock.GetSlotCount(), 1u);
+}
+
+/*
+ * @tc.name: testBigReaderLock002
+ * @tc.desc: Readers on many threads never observe a half-finished write, and writers are mutually exclusive.
+ */
+HWTEST_F(UtilsRWLockTest, testBigReaderLock002, TestSize.Level1)
+{
+    const int readerNum = 8;
+    const int writerNum = 2;
+    const int loops = 2000;
+    Utils::BigReaderLock lock;
+    int first = 0;
+    int second = 0;
+    std::atomic_int mismatch(0);
+
+    vector<thread> threads;
+    for (int i = 0; i < readerNum; ++i) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < loops; ++j) {
+                Utils::UniqueReadGuard<Utils::BigReaderLock> guard(lock);
+                if (first != second) {
+                    ++mismatch;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < writerNum; ++i) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < loops; ++j) {
+                Utils::UniqueWriteGuard<Utils::BigReaderLock> guard(lock);
+                ++first;
+                ++second;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(mismatch.load(), 0);
+    EXPECT_EQ(first, writerNum * loops);
+    EXPECT_EQ(second, writerNum * loops);
+}
+
+/*
+ * @tc.name: testRWLockTryLock001
+ * @tc.desc: TryLockRead and TryLockWrite fail immediately when the lock is held in a conflicting mode.
+ */
+HWTEST_F(UtilsRWLockTest, testRWLockTryLock001, TestSize.Level1)
+{
+    Utils::RWLock lock;
+    ASSERT_TRUE(lock.TryLockRead());
+
+    bool writeOk = true;
+    bool readOk = false;
+    thread other([&]() {
+        writeOk = lock.TryLockWrite();
+        readOk = lock.TryLockRead();
+        if (readOk) {
+            lock.UnLockRead();
+        }
+    });
+    other.join();
+    EXPECT_FALSE(writeOk);
+    EXPECT_TRUE(readOk);
+    lock.UnLockRead();
+
+    ASSERT_TRUE(lock.TryLockWrite());
+    EXPECT_TRUE(lock.TryLockRead()); // The writer thread may read directly.
+    lock.UnLockRead();
+    thread another([&]() {
+        readOk = lock.TryLockRead();
+        writeOk = lock.TryLockWrite();
+    });
+    another.join();
+    EXPECT_FALSE(readOk);
+    EXPECT_FALSE(writeOk);
+    lock.UnLockWrite();
+}
+
+/*
+ * @tc.name: testRWLockTimedLock001
+ * @tc.desc: LockReadFor and LockWriteFor give up after the timeout, and succeed once the lock is released.
+ */
+HWTEST_F(UtilsRWLockTest, testRWLockTimedLock001, TestSize.Level1)
+{
+    Utils::RWLock lock;
+    lock.LockWrite();
+
+    bool readOk = true;
+    bool writeOk = true;
+    thread waiter([&]() {
+        readOk = lock.LockReadFor(chrono::milliseconds(10)); // 10: timeout in ms
+        writeOk = lock.LockWriteFor(chrono::milliseconds(10)); // 10: timeout in ms
+    });
+    waiter.join();
+    EXPECT_FALSE(readOk);
+    EXPECT_FALSE(writeOk);
+    lock.UnLockWrite();
+
+    thread reader([&]() {
+        readOk = lock.LockReadFor(chrono::milliseconds(10)); // 10: timeout in ms
+        if (readOk) {
+            lock.UnLockRead();
+        }
+        writeOk = lock.LockWriteFor(chrono::milliseconds(10)); // 10: timeout in ms
+        if (writeOk) {
+            lock.UnLockWrite();
+        }
+    });
+    reader.join();
+    EXPECT_TRUE(readOk);
+    EXPECT_TRUE(writeOk);
+
+    // A timed out writer must not keep blocking readers in write-first mode.
+    EXPECT_TRUE(lock.TryLockRead());
+    lock.UnLockRead();
+}
+
+/*
+ * @tc.name: testRWLockUpgrade001
+ * @tc.desc: The sole reader can upgrade to the write lock and downgrade back to a read lock.
+ * Upgrading fails while other readers hold the lock.
+ */
+HWTEST_F(UtilsRWLockTest, testRWLockUpgrade001, TestSize.Level1)
+{
+    Utils::RWLock lock;
+    lock.LockRead();
+    ASSERT_TRUE(lock.TryUpgradeToWrite());
+
+    bool readOk = true;
+    thread blocked([&]() { readOk = lock.TryLockRead(); });
+    blocked.join();
+    EXPECT_FALSE(readOk);
+
+    lock.DowngradeToRead();
+    thread shared([&]() {
+        readOk = lock.TryLockRead();
+        if (readOk) {
+            EXPECT_FALSE(lock.TryUpgradeToWrite());
+            lock.UnLockRead();
+        }
+    });
+    shared.join();
+    EXPECT_TRUE(readOk);
+
+    bool writeOk = true;
+    thread writer([&]() { writeOk = lock.TryLockWrite(); });
+    writer.join();
+    EXPECT_FALSE(writeOk);
+
+    lock.UnLockRead();
+    EXPECT_TRUE(lock.TryLockWrite());
+    lock.UnLockWrite();
+}
+
+/*
+ * @tc.name: testUniqueTryGuard001
+ * @tc.desc: UniqueTryWriteGuard and UniqueTryReadGuard report whether they own the lock
+ * and only release the lock they obtained.
+ */
+HWTEST_F(UtilsRWLockTest, testUniqueTryGuard001, TestSize.Level1)
+{
+    Utils::RWLock lock;
+    {
+        Utils::UniqueTryReadGuard<Utils::RWLock> readGuard(lock);
+        EXPECT_TRUE(readGuard.OwnsLock());
+        thread other([&]() {
+            Utils::UniqueTryWriteGuard<Utils::RWLock> writeGuard(lock, chrono::milliseconds(5)); // 5: timeout in ms
+            EXPECT_FALSE(writeGuard.OwnsLock());
+        });
+        other.join();
+    }
+    {
+        Utils::UniqueTryWriteGuard<Utils::RWLock> writeGuard(lock);
+        EXPECT_TRUE(writeGuard.OwnsLock());
+        thread other([&]() {
+            Utils::UniqueTryReadGuard<Utils::RWLock> readGuard(lock);
+            EXPECT_FALSE(readGuard.OwnsLock());
+        });
+        other.join();
+    }
+    EXPECT_TRUE(lock.TryLockWrite());
+    lock.UnLockWrite();
+}
 }  // namespace
 }  // namespace OHOS
\ No newline at end of file
@@ -13,9 +13,11 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <gtest/gtest.h>
 #include "timer.h"
 #include "common_timer_errors.h"
+#include "thread_pool.h"
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -368,6 +370,397 @@ HWTEST_F(UtilsTimerTest, testTimer011, TestSize.Level0)
     EXPECT_GE(g_data1, 8); /* 12 for max */
 }
 
+/*
+ * @tc.name: testTimingWheel001
+ * @tc.desc: One-shot and periodic events on the timing wheel engine, and unregister.
+ */
+HWTEST_F(UtilsTimerTest, testTimingWheel001, TestSize.Level0)
+{
+    g_data1 = 0;
+    g_data2 = 0;
+    Utils::Timer timer("test_timer", 1000, Utils::Timer::TimerEngine::TIMING_WHEEL);
+    uint32_t ret = timer.Setup();
+    EXPECT_EQ(Utils::TIMER_ERR_OK, ret);
+    uint32_t onceId = timer.Register(TimeOutCallback1, 5, true);
+    uint32_t periodicId = timer.Register(TimeOutCallback2, 10);
+    EXPECT_NE(onceId, Utils::TIMER_ERR_DEAL_FAILED);
+    EXPECT_NE(periodicId, Utils::TIMER_ERR_DEAL_FAILED);
+    EXPECT_NE(onceId, periodicId);
+    std::this_thread::sleep_for(std::chrono::milliseconds(55));
+    timer.Unregister(periodicId);
+    int periodicCount = g_data2;
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    timer.Unregister(onceId); // already expired, must be ignored
+    timer.Shutdown();
+    EXPECT_EQ(1, g_data1);
+    EXPECT_GE(periodicCount, 3); /* 5 for max */
+    EXPECT_LE(periodicCount, 6);
+    EXPECT_EQ(periodicCount, g_data2);
+}
+
+/*
+ * @tc.name: testTimingWheel002
+ * @tc.desc: Many events with different intervals on the timing wheel engine, including ones which
+ * are cascaded from the upper levels. An event never fires before its interval elapses.
+ */
+HWTEST_F(UtilsTimerTest, testTimingWheel002, TestSize.Level0)
+{
+    const int timerCount = 1000;
+    const uint32_t maxInterval = 200; // covers the first two levels of the wheel
+    std::atomic<int> fired(0);
+    std::atomic<int> early(0);
+    Utils::Timer timer("test_timer", 1000, Utils::Timer::TimerEngine::TIMING_WHEEL);
+    EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+    for (int i = 0; i < timerCount; ++i) {
+        uint32_t interval = static_cast<uint32_t>(i) % maxInterval + 1;
+        int64_t start = CurMs();
+        timer.Register([&fired, &early, start, interval]() {
+            if (CurMs() - start < static_cast<int64_t>(interval) - 1) { // 1: gettimeofday granularity
+                early++;
+            }
+            fired++;
+        }, interval, true);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(maxInterval + 100)); // 100: margin for scheduling
+    timer.Shutdown();
+    EXPECT_EQ(timerCount, fired);
+    EXPECT_EQ(0, early);
+}
+
+/*
+ * @tc.name: testTimingWheel003
+ * @tc.desc: Events unregister themselves from the callback, and a wheel timer can be set up again.
+ */
+HWTEST_F(UtilsTimerTest, testTimingWheel003, TestSize.Level0)
+{
+    g_data1 = 0;
+    Utils::Timer timer("test_timer", 1000, Utils::Timer::TimerEngine::TIMING_WHEEL);
+    EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+    std::atomic<uint32_t> timerId(0);
+    std::atomic<int> count(0);
+    timerId = timer.Register([&timer, &timerId, &count]() {
+        count++;
+        timer.Unregister(timerId);
+    }, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    timer.Shutdown();
+    EXPECT_EQ(1, count);
+
+    EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+    timer.Register(TimeOutCallback1, 1, true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    timer.Shutdown();
+    EXPECT_EQ(1, g_data1);
+}
+
+/*
+ * @tc.name: testTimerThreadPool001
+ * @tc.desc: With a thread pool attached, a slow callback does not delay the other timed events.
+ */
+HWTEST_F(UtilsTimerTest, testTimerThreadPool001, TestSize.Level0)
+{
+    ThreadPool pool("timer_pool");
+    pool.Start(2); // 2: one thread for the slow callback, one for the others
+    std::atomic<int> fastCount(0);
+    Utils::Timer timer("test_timer", 1000, Utils::Timer::TimerEngine::TIMING_WHEEL);
+    timer.SetCallbackThreadPool(&pool);
+    EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+    timer.Register([]() { std::this_thread::sleep_for(std::chrono::milliseconds(100)); }, 1, true);
+    timer.Register([&fastCount]() { fastCount++; }, 10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(95));
+    int countDuringSlowCallback = fastCount;
+    timer.Shutdown();
+    pool.Stop();
+    EXPECT_GE(countDuringSlowCallback, 5); /* 9 for max */
+
+    Utils::TimerLatencyStats stats = timer.GetLatencyStats();
+    EXPECT_EQ(stats.callbacks, static_cast<uint64_t>(fastCount + 1));
+}
+
+/*
+ * @tc.name: testTimerLatency001
+ * @tc.desc: Latency statistics of the callbacks, for both engines.
+ */
+HWTEST_F(UtilsTimerTest, testTimerLatency001, TestSize.Level0)
+{
+    for (auto engine : {Utils::Timer::TimerEngine::PER_INTERVAL_FD, Utils::Timer::TimerEngine::TIMING_WHEEL}) {
+        g_data1 = 0;
+        Utils::Timer timer("test_timer", 1000, engine);
+        EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+        Utils::TimerLatencyStats stats = timer.GetLatencyStats();
+        EXPECT_EQ(stats.callbacks, 0u);
+        EXPECT_EQ(stats.latencyHistogram.size(), Utils::TIMER_LATENCY_HISTOGRAM_BUCKETS);
+
+        timer.Register(TimeOutCallback1, 5);
+        timer.Register(TimeOutCallback1, 7, true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        timer.Shutdown();
+
+        stats = timer.GetLatencyStats();
+        EXPECT_EQ(stats.callbacks, static_cast<uint64_t>(g_data1.load()));
+        EXPECT_GE(stats.callbacks, 4u);
+        uint64_t histogramTotal = 0;
+        for (auto count : stats.latencyHistogram) {
+            histogramTotal += count;
+        }
+        EXPECT_EQ(histogramTotal, stats.callbacks);
+        EXPECT_LE(stats.maxLatencyNs, stats.totalLatencyNs);
+        EXPECT_LT(stats.maxLatencyNs, 20000000u); // 20000000: 20 ms, far beyond the expected latency
+
+        timer.ResetLatencyStats();
+        EXPECT_EQ(timer.GetLatencyStats().callbacks, 0u);
+        EXPECT_EQ(timer.GetLatencyStats().totalLatencyNs, 0u);
+    }
+}
+
+/*
+ * @tc.name: testTimerPrecise001
+ * @tc.desc: Sub-millisecond periodic event registered by std::chrono duration. Expiries which are not
+ * delivered separately are reported as overruns, so none of them gets lost.
+ */
+HWTEST_F(UtilsTimerTest, testTimerPrecise001, TestSize.Level0)
+{
+    std::atomic<uint64_t> calls(0);
+    std::atomic<uint64_t> overruns(0);
+    Utils::Timer timer("test_timer");
+    EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+    auto start = std::chrono::steady_clock::now();
+    uint32_t timerId = timer.Register([&calls, &overruns](uint64_t missed) {
+        calls++;
+        overruns += missed;
+    }, std::chrono::microseconds(500));
+    EXPECT_NE(timerId, Utils::TIMER_ERR_DEAL_FAILED);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    timer.Unregister(timerId);
+    auto expiries = (std::chrono::steady_clock::now() - start) / std::chrono::microseconds(500);
+    timer.Shutdown();
+    EXPECT_GE(calls, 10u);
+    EXPECT_GE(calls + overruns + 5, static_cast<uint64_t>(expiries)); // 5: expiries not yet handled
+    EXPECT_LE(calls + overruns, static_cast<uint64_t>(expiries));
+}
+
+/*
+ * @tc.name: testTimerPrecise005
+ * @tc.desc: Events of the interval timerfds and of the wheel are told apart by their IDs, so unregistering
+ * one leaves the other.
+ */
+HWTEST_F(UtilsTimerTest, testTimerPrecise005, TestSize.Level0)
+{
+    std::atomic<int> intervalCalls(0);
+    std::atomic<int> wheelCalls(0);
+    Utils::Timer timer("test_timer");
+    EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+    std::vector<uint32_t> intervalIds;
+    std::vector<uint32_t> wheelIds;
+    for (int i = 0; i < 10; ++i) { // 10: IDs of both kinds made from the same indexes
+        intervalIds.push_back(timer.Register([&intervalCalls]() { intervalCalls++; }, 1));
+        wheelIds.push_back(timer.Register([&wheelCalls](uint64_t) { wheelCalls++; }, std::chrono::milliseconds(1)));
+    }
+    for (uint32_t id : intervalIds) {
+        EXPECT_EQ(std::find(wheelIds.begin(), wheelIds.end(), id), wheelIds.end());
+        timer.Unregister(id);
+    }
+    int calls = intervalCalls;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    timer.Shutdown();
+    EXPECT_EQ(calls, intervalCalls);
+    EXPECT_GE(wheelCalls, 10 * 10); /* 10 events, 20 calls each for expected */
+}
+
+/*
+ * @tc.name: testTimerPrecise002
+ * @tc.desc: One-shot event registered by absolute deadline, which never fires early.
+ */
+HWTEST_F(UtilsTimerTest, testTimerPrecise002, TestSize.Level0)
+{
+    for (auto engine : {Utils::Timer::TimerEngine::PER_INTERVAL_FD, Utils::Timer::TimerEngine::TIMING_WHEEL}) {
+        Utils::Timer timer("test_timer", 1000, engine);
+        EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(10500);
+        std::atomic<int> calls(0);
+        std::chrono::steady_clock::time_point firedAt;
+        timer.RegisterAt([&calls, &firedAt](uint64_t) {
+            firedAt = std::chrono::steady_clock::now();
+            calls++;
+        }, deadline);
+        EXPECT_EQ(timer.RegisterAt([](uint64_t) {}, deadline, std::chrono::nanoseconds(-1)),
+            Utils::TIMER_ERR_DEAL_FAILED);
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        timer.Shutdown();
+        EXPECT_EQ(1, calls);
+        EXPECT_GE(firedAt, deadline);
+    }
+}
+
+/*
+ * @tc.name: testTimerPrecise006
+ * @tc.desc: A periodic event of interval 0 is refused instead of firing once.
+ */
+HWTEST_F(UtilsTimerTest, testTimerPrecise006, TestSize.Level0)
+{
+    for (auto engine : {Utils::Timer::TimerEngine::PER_INTERVAL_FD, Utils::Timer::TimerEngine::TIMING_WHEEL}) {
+        Utils::Timer timer("test_timer", 1000, engine);
+        EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+        std::atomic<int> calls(0);
+        EXPECT_EQ(timer.Register([&calls](uint64_t) { calls++; }, std::chrono::nanoseconds::zero()),
+            Utils::TIMER_ERR_INVALID_VALUE);
+        if (engine == Utils::Timer::TimerEngine::TIMING_WHEEL) {
+            EXPECT_EQ(timer.Register([&calls]() { calls++; }, 0), Utils::TIMER_ERR_INVALID_VALUE);
+        }
+        // A one-shot event of interval 0 expires at once.
+        timer.Register([&calls](uint64_t) { calls++; }, std::chrono::nanoseconds::zero(), true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        timer.Shutdown();
+        EXPECT_EQ(1, calls);
+    }
+}
+
+/*
+ * @tc.name: testTimerPrecise003
+ * @tc.desc: Fixed-rate periodic events after an overrunning callback, in both repeat modes.
+ */
+HWTEST_F(UtilsTimerTest, testTimerPrecise003, TestSize.Level0)
+{
+    const auto period = std::chrono::milliseconds(2);
+    for (auto mode : {Utils::Timer::RepeatMode::SKIP_MISSED, Utils::Timer::RepeatMode::CATCH_UP}) {
+        std::atomic<uint64_t> calls(0);
+        std::atomic<uint64_t> overruns(0);
+        std::atomic<uint64_t> maxOverruns(0);
+        Utils::Timer timer("test_timer", 1000, Utils::Timer::TimerEngine::TIMING_WHEEL, std::chrono::microseconds(100));
+        EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+        timer.Register([&calls, &overruns, &maxOverruns](uint64_t missed) {
+            if (calls++ == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(11)); // 11: overrun 5 periods
+            }
+            overruns += missed;
+            maxOverruns = std::max(maxOverruns.load(), missed);
+        }, period, false, mode);
+        std::this_thread::sleep_for(std::chrono::milliseconds(21)); // 21: 10 periods
+        timer.Shutdown();
+
+        EXPECT_GE(maxOverruns, 4u); /* 5 for expected */
+        if (mode == Utils::Timer::RepeatMode::CATCH_UP) {
+            EXPECT_GE(calls, 8u); /* 10 for expected */
+        } else {
+            EXPECT_LE(calls, 6u); /* 5 for expected */
+            EXPECT_GE(calls + overruns, 8u);
+        }
+    }
+}
+
+/*
+ * @tc.name: testTimerPrecise004
+ * @tc.desc: Catching up a short period after a long overrun is bounded, the rest is reported as overruns.
+ */
+HWTEST_F(UtilsTimerTest, testTimerPrecise004, TestSize.Level0)
+{
+    const uint64_t maxCatchUp = 64; // 64: expiries run back to back at most
+    std::atomic<uint64_t> calls(0);
+    std::atomic<uint64_t> queued(0);
+    std::atomic<uint64_t> maxOverruns(0);
+    Utils::Timer timer("test_timer", 1000, Utils::Timer::TimerEngine::TIMING_WHEEL, std::chrono::microseconds(10));
+    EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+    timer.Register([&](uint64_t missed) {
+        if (calls++ == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20)); // 20: overrun 2000 periods
+        }
+        if (missed >= maxCatchUp) {
+            queued++;
+        }
+        maxOverruns = std::max(maxOverruns.load(), missed);
+    }, std::chrono::microseconds(10), false, Utils::Timer::RepeatMode::CATCH_UP);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30)); // 30: the overrun and some periods after
+    timer.Shutdown();
+
+    EXPECT_GE(maxOverruns, 1000u); /* 2000 for expected */
+    EXPECT_GE(queued, 1u);
+    EXPECT_LE(queued, maxCatchUp * 4); /* 4: a few stalls of the test thread */
+}
+
+/*
+ * @tc.name: testTimerSlack001
+ * @tc.desc: Events with slack are handled within their slack, and those expiring close to each other
+ * are handled in fewer wakeups.
+ */
+HWTEST_F(UtilsTimerTest, testTimerSlack001, TestSize.Level0)
+{
+    const int timerCount = 50;
+    const auto slack = std::chrono::milliseconds(20);
+    std::atomic<int> calls(0);
+    std::atomic<int> early(0);
+    std::atomic<int> late(0);
+    Utils::Timer timer("test_timer", 1000, Utils::Timer::TimerEngine::TIMING_WHEEL);
+    EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+    for (int i = 0; i < timerCount; ++i) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(10 + i % 10); // 10: spread
+        timer.RegisterAt([&, deadline](uint64_t) {
+            auto now = std::chrono::steady_clock::now();
+            early += (now < deadline) ? 1 : 0;
+            late += (now > deadline + slack + std::chrono::milliseconds(10)) ? 1 : 0; // 10: margin for scheduling
+            calls++;
+        }, deadline, std::chrono::nanoseconds::zero(), Utils::Timer::RepeatMode::SKIP_MISSED, slack);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    timer.Shutdown();
+    EXPECT_EQ(timerCount, calls);
+    EXPECT_EQ(0, early);
+    EXPECT_EQ(0, late);
+    EXPECT_LE(timer.GetLatencyStats().wakeups, 2u); /* 10 without slack */
+}
+
+/*
+ * @tc.name: testTimerSlotMap001
+ * @tc.desc: Many timers sharing one interval are unregistered individually, also from inside a callback,
+ * and a stale ID never unregisters the timer reusing its slot.
+ */
+HWTEST_F(UtilsTimerTest, testTimerSlotMap001, TestSize.Level0)
+{
+    const int timerCount = 1000;
+    const int onceCount = 10;
+    const uint32_t interval = 20;
+    std::vector<int> calls(timerCount, 0);
+    std::atomic<int> onceCalls(0);
+    std::atomic<int> selfCalls(0);
+    std::atomic<int> reusedCalls(0);
+    Utils::Timer timer("test_timer");
+    EXPECT_EQ(Utils::TIMER_ERR_OK, timer.Setup());
+
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < timerCount; ++i) {
+        ids.push_back(timer.Register([&calls, i]() { calls[i]++; }, interval));
+    }
+    for (int i = 0; i < timerCount; i += 2) { // 2: unregister every other timer
+        timer.Unregister(ids[i]);
+    }
+    for (int i = 0; i < onceCount; ++i) {
+        timer.Register([&onceCalls]() { onceCalls++; }, interval, true);
+    }
+    std::atomic<uint32_t> selfId(0);
+    selfId = timer.Register([&]() {
+        selfCalls++;
+        timer.Unregister(selfId);
+    }, interval);
+    uint32_t staleId = timer.Register([]() {}, interval);
+    timer.Unregister(staleId);
+    uint32_t reusedId = timer.Register([&reusedCalls]() { reusedCalls++; }, interval);
+    EXPECT_NE(staleId, reusedId);
+    timer.Unregister(staleId);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval * 3)); // 3: a few expiries
+    timer.Shutdown();
+    for (int i = 0; i < timerCount; ++i) {
+        if (i % 2 == 0) {
+            EXPECT_EQ(calls[i], 0);
+        } else {
+            EXPECT_GE(calls[i], 1);
+            EXPECT_EQ(calls[i], calls[1]);
+        }
+    }
+    EXPECT_EQ(onceCount, onceCalls);
+    EXPECT_EQ(1, selfCalls);
+    EXPECT_EQ(calls[1], reusedCalls);
+}
+
 /*
  * @tc.name: testTimer012
  * @tc.desc: Test double setup.